@@ -0,0 +1,215 @@
+#include "AgendaModel.h"
+#include "CalendarLayers.h"
+
+#include <QBrush>
+#include <QFont>
+#include <algorithm>  // std::copy, std::max
+
+AgendaModel::AgendaModel(const CalendarLayers* layers, QObject* parent)
+    : QAbstractListModel(parent), m_layers(layers)
+{
+    setStart(QDate::currentDate());
+}
+
+void AgendaModel::setStart(const QDate& from)
+{
+    beginResetModel();
+    m_start = from;
+    m_first = from;
+    m_next  = from;
+    m_rows.clear();
+    endResetModel();
+}
+
+/**
+ * @brief Re-read the loaded days and patch each one in place: a day whose
+ *        row count changed gets rows inserted/removed at its end, the rest
+ *        are overwritten. Keys are positional, so every row is marked changed.
+ */
+void AgendaModel::refresh()
+{
+    if (!m_layers) return;
+
+    int pos = 0;
+    QVector<Entry> now;
+    for (QDate d = m_first; d < m_next; d = d.addDays(1)) {
+        const qint64 jd = d.toJulianDay();
+        int end = pos;
+        while (end < m_rows.size() && m_rows[end].jd == jd) ++end;
+
+        now.clear();
+        dayRows(d, now);
+        const int had = end - pos, want = now.size();
+        if (want > had) {
+            beginInsertRows(QModelIndex(), end, end + want - had - 1);
+            m_rows.insert(end, want - had, Entry{});
+            std::copy(now.cbegin(), now.cend(), m_rows.begin() + pos);
+            endInsertRows();
+        } else if (want < had) {
+            beginRemoveRows(QModelIndex(), pos + want, end - 1);
+            m_rows.remove(pos + want, had - want);
+            std::copy(now.cbegin(), now.cend(), m_rows.begin() + pos);
+            endRemoveRows();
+        } else {
+            std::copy(now.cbegin(), now.cend(), m_rows.begin() + pos);
+        }
+        pos += want;
+    }
+    if (!m_rows.isEmpty()) emit dataChanged(index(0), index(m_rows.size() - 1));
+}
+
+/**
+ * @brief Keep the loaded window around [firstRow, lastRow]: page earlier days
+ *        in when the view nears the top, drop whole days more than kKeepRows
+ *        beyond either edge (fetchMore() pages the tail back in on demand).
+ */
+void AgendaModel::setViewport(int firstRow, int lastRow)
+{
+    if (!m_layers || firstRow < 0) return;
+    lastRow = std::max(lastRow, firstRow);
+
+    if (firstRow < kPageRows / 4 && m_first > m_start) {
+        const QVector<Entry> page = prependPage();
+        if (!page.isEmpty()) {
+            beginInsertRows(QModelIndex(), 0, page.size() - 1);
+            m_rows = page + m_rows;
+            endInsertRows();
+            firstRow += page.size();
+            lastRow  += page.size();
+        }
+    }
+
+    auto dayStart = [this](int r) {
+        while (r > 0 && m_rows[r - 1].jd == m_rows[r].jd) --r;
+        return r;
+    };
+
+    const int tail = lastRow + kKeepRows + 1;
+    if (tail < m_rows.size()) {
+        const int cut = dayStart(tail);
+        if (cut > lastRow) {
+            m_next = QDate::fromJulianDay(m_rows[cut].jd);
+            beginRemoveRows(QModelIndex(), cut, m_rows.size() - 1);
+            m_rows.resize(cut);
+            endRemoveRows();
+        }
+    }
+
+    const int head = firstRow - kKeepRows;
+    if (head > 0 && head < m_rows.size()) {
+        const int cut = dayStart(head);
+        if (cut > 0) {
+            m_first = QDate::fromJulianDay(m_rows[cut].jd);
+            beginRemoveRows(QModelIndex(), 0, cut - 1);
+            m_rows.remove(0, cut);
+            endRemoveRows();
+        }
+    }
+}
+
+void AgendaModel::dayRows(const QDate& day, QVector<Entry>& out) const
+{
+    const auto rows = m_layers->rowsOn(day);
+    if (rows.isEmpty()) return;
+
+    const qint64 jd = day.toJulianDay();
+    out.push_back({ jd, -1, 0 });
+    for (const auto& lr : rows) out.push_back({ jd, qint16(lr.first), qint16(lr.second) });
+}
+
+void AgendaModel::appendPage(QVector<Entry>& out)
+{
+    const QDate horizon = m_start.addDays(kHorizonDays);
+    const int   target  = out.size() + kPageRows;
+
+    for (int days = 0; m_next < horizon && days < kPageMaxDays && out.size() < target;
+         ++days, m_next = m_next.addDays(1))
+        dayRows(m_next, out);
+}
+
+QVector<AgendaModel::Entry> AgendaModel::prependPage()
+{
+    // Walk back a day at a time, then put the days in date order
+    QVector<QVector<Entry>> days;
+    int rows = 0;
+    for (int n = 0; m_first > m_start && n < kPageMaxDays && rows < kPageRows; ++n) {
+        m_first = m_first.addDays(-1);
+        QVector<Entry> day;
+        dayRows(m_first, day);
+        rows += day.size();
+        if (!day.isEmpty()) days.push_back(std::move(day));
+    }
+
+    QVector<Entry> out;
+    out.reserve(rows);
+    for (auto it = days.crbegin(); it != days.crend(); ++it) out += *it;
+    return out;
+}
+
+int AgendaModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+bool AgendaModel::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && m_layers && m_next < m_start.addDays(kHorizonDays);
+}
+
+void AgendaModel::fetchMore(const QModelIndex& parent)
+{
+    if (!canFetchMore(parent)) return;
+
+    QVector<Entry> page;
+    appendPage(page);
+    if (page.isEmpty()) return;
+
+    beginInsertRows(QModelIndex(), m_rows.size(), m_rows.size() + page.size() - 1);
+    m_rows += page;
+    endInsertRows();
+}
+
+QVariant AgendaModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size()) return {};
+    const Entry& en  = m_rows[index.row()];
+    const QDate  day = QDate::fromJulianDay(en.jd);
+
+    switch (role) {
+    case DateRole:     return day;
+    case SlotRole:     return int(en.slot);
+    case RowInDayRole: return int(en.row);
+    case HeaderRole:   return en.slot < 0;
+    default: break;
+    }
+
+    if (en.slot < 0) {
+        if (role == Qt::DisplayRole) {
+            QString label = day.toString("dddd, MMM d yyyy");
+            if (day == QDate::currentDate()) label += "  ·  Today";
+            return label;
+        }
+        if (role == Qt::FontRole) { QFont f; f.setBold(true); return f; }
+        if (role == Qt::ForegroundRole) return QBrush(QColor("#8b93a1"));
+        return {};
+    }
+
+    const auto& layer = m_layers->at(en.slot);
+    const Event& e    = m_layers->eventAt(en.slot, day, en.row);
+
+    switch (role) {
+    case Qt::DisplayRole: {
+        QString text = QString("   %1–%2   %3").arg(e.getStartTime().toString("hh:mm"),
+                                                   e.getEndTime().toString("hh:mm"),
+                                                   e.getTitle());
+        if (en.slot != 0) text += QString("   [%1]").arg(layer.name);
+        return text;
+    }
+    case Qt::DecorationRole: return layer.color;
+    case Qt::ToolTipRole:    return layer.index().itemTooltip(day, en.row);
+    case Qt::ForegroundRole:
+        return layer.readOnly ? QVariant(QBrush(QColor("#9aa3ab"))) : QVariant();
+    default:
+        return {};
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QDate>
+#include <QVector>
+
+class CalendarLayers;
+
+/**
+ * @brief AgendaModel
+ * Continuous, date-ordered list of upcoming events across all visible layers.
+ *
+ * Rows are fetched in pages (canFetchMore/fetchMore), so a view only pulls
+ * the days it scrolls into. Each row is a small key (day, layer slot,
+ * row-in-day) resolved through the layers' per-day indexes; text, colours
+ * and tooltips are produced in data(), i.e. only for rows being painted.
+ *
+ * Only a window of days around the viewport is held: setViewport() drops
+ * whole days more than kKeepRows away from it and pages earlier days back
+ * in near the top, so memory stays bounded however far the view scrolls.
+ *
+ * Notes
+ *  - Every day with events gets a header row (slot == -1) followed by its events.
+ *  - Keys point into the layers' indexes; call refresh() after events or
+ *    layer visibility change. It inserts/removes rows per day that changed,
+ *    so the view keeps its scroll position and selection.
+ */
+class AgendaModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    enum Roles {
+        DateRole = Qt::UserRole,   ///< QDate of the row
+        SlotRole,                  ///< layer slot (-1 for day headers)
+        RowInDayRole,              ///< row within the day (for CalendarLayers::eventAt)
+        HeaderRole                 ///< true for day header rows
+    };
+
+    explicit AgendaModel(const CalendarLayers* layers, QObject* parent = nullptr);
+
+    /// Restart the agenda at @from (drops loaded pages).
+    void setStart(const QDate& from);
+    QDate start() const { return m_start; }
+
+    /// Re-read the loaded days from the layers, applying per-day row changes.
+    void refresh();
+
+    /// Rows the view shows; evicts days far from them and pages in earlier days.
+    void setViewport(int firstRow, int lastRow);
+
+    int      rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool     canFetchMore(const QModelIndex& parent) const override;
+    void     fetchMore(const QModelIndex& parent) override;
+
+private:
+    struct Entry {
+        qint64 jd   = 0;    ///< QDate::toJulianDay()
+        qint16 slot = -1;   ///< -1 = day header
+        qint16 row  = 0;
+        bool operator==(const Entry& o) const { return jd == o.jd && slot == o.slot && row == o.row; }
+    };
+
+    /// Header + event rows of @day (nothing for an empty day).
+    void dayRows(const QDate& day, QVector<Entry>& out) const;
+    /// Append rows for days [m_next, …) until a page is full; advances m_next.
+    void appendPage(QVector<Entry>& out);
+    /// Rows for the page of days just before m_first; moves m_first back.
+    QVector<Entry> prependPage();
+
+    static constexpr int kPageRows    = 200;    ///< rows per fetchMore()
+    static constexpr int kPageMaxDays = 92;     ///< stop a page early after this many days
+    static constexpr int kHorizonDays = 3660;   ///< agenda ends ~10 years after start
+    static constexpr int kKeepRows    = 2 * kPageRows;   ///< kept beyond each edge of the viewport
+
+    const CalendarLayers* m_layers = nullptr;
+    QDate          m_start;
+    QDate          m_first;     ///< first day loaded (>= m_start)
+    QDate          m_next;      ///< first day not yet loaded
+    QVector<Entry> m_rows;      ///< rows for days [m_first, m_next)
+};
@@ -0,0 +1,224 @@
+#include "ArchiveStore.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPair>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QStringList>
+#include <algorithm>  // std::remove_if, std::sort, std::unique
+
+static constexpr quint32 kSegMagic   = 0x45534152; // "ESAR"
+static constexpr quint32 kSegVersion = 1;
+
+// Identity used when merging into an existing segment
+static QString dedupeKey(const Event& e) {
+    if (!e.uid().isEmpty()) return e.uid();
+    return QString("%1|%2|%3").arg(e.getTitle())
+                              .arg(e.getStartTime().toSecsSinceEpoch())
+                              .arg(e.getEndTime().toSecsSinceEpoch());
+}
+
+// Months [first, last] an event overlaps (its end is exclusive)
+static QPair<int, int> monthSpan(const Event& e) {
+    const QDateTime& s = e.getStartTime();
+    const QDateTime& t = e.getEndTime();
+    return { ArchiveStore::monthKey(s.date()),
+             ArchiveStore::monthKey(t > s ? t.addSecs(-1).date() : s.date()) };
+}
+
+void ArchiveStore::open(const QString& dir)
+{
+    m_dir = dir;
+    m_segments.clear();
+    m_cache.clear();
+    m_lru.clear();
+    QDir().mkpath(dir);
+
+    static const QRegularExpression re("^(\\d{4})-(\\d{2})\\.seg$");
+    const QFileInfoList files = QDir(dir).entryInfoList({ "*.seg" }, QDir::Files);
+    for (const QFileInfo& fi : files) {
+        const auto m = re.match(fi.fileName());
+        if (!m.hasMatch()) continue;
+        const QDate d(m.captured(1).toInt(), m.captured(2).toInt(), 1);
+        if (d.isValid()) m_segments.insert(monthKey(d), fi.size());
+    }
+}
+
+QString ArchiveStore::segmentPath(int key) const
+{
+    return QDir(m_dir).filePath(monthOf(key).toString("yyyy-MM") + ".seg");
+}
+
+qint64 ArchiveStore::compressedBytes() const
+{
+    qint64 n = 0;
+    for (qint64 b : m_segments) n += b;
+    return n;
+}
+
+
+// ============================================================================
+// Segment I/O (columnar)
+// ============================================================================
+
+bool ArchiveStore::writeSegment(int key, const QVector<Event>& evs)
+{
+    const int n = evs.size();
+    QVector<qint64>  start;   start.reserve(n);
+    QVector<qint32>  dur;     dur.reserve(n);
+    QVector<quint32> rgb;     rgb.reserve(n);
+    QStringList      title, desc, series, uid;
+
+    for (const Event& e : evs) {
+        start.push_back(e.getStartTime().toSecsSinceEpoch());
+        dur.push_back(qint32(e.getStartTime().secsTo(e.getEndTime())));
+        rgb.push_back(e.getColor().rgb());
+        title  << e.getTitle();
+        desc   << e.getDescription();
+        series << e.seriesId();
+        uid    << e.uid();
+    }
+
+    QByteArray raw;
+    {
+        QDataStream ds(&raw, QIODevice::WriteOnly);
+        ds.setVersion(QDataStream::Qt_6_0);
+        ds << kSegMagic << kSegVersion << qint32(n)
+           << start << dur << rgb
+           << title << desc << series << uid;
+    }
+
+    QSaveFile f(segmentPath(key));
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    const QByteArray packed = qCompress(raw, 9);
+    f.write(packed);
+    if (!f.commit()) return false;
+
+    m_segments.insert(key, packed.size());
+    return true;
+}
+
+bool ArchiveStore::readSegment(int key, QVector<Event>& out) const
+{
+    QFile f(segmentPath(key));
+    if (!f.open(QIODevice::ReadOnly)) return false;
+    const QByteArray raw = qUncompress(f.readAll());
+
+    QDataStream ds(raw);
+    ds.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0, version = 0; qint32 n = 0;
+    ds >> magic >> version >> n;
+    if (magic != kSegMagic || version != kSegVersion || n < 0) return false;
+
+    QVector<qint64>  start;
+    QVector<qint32>  dur;
+    QVector<quint32> rgb;
+    QStringList      title, desc, series, uid;
+    ds >> start >> dur >> rgb >> title >> desc >> series >> uid;
+    if (ds.status() != QDataStream::Ok || start.size() != n || uid.size() != n) return false;
+
+    out.clear();
+    out.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const QDateTime s = QDateTime::fromSecsSinceEpoch(start[i]);
+        Event e(title[i], desc[i], s, s.addSecs(dur[i]), QColor::fromRgb(rgb[i]), series[i]);
+        e.setUid(uid[i]);
+        out.push_back(e);
+    }
+    return true;
+}
+
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+int ArchiveStore::archiveBefore(QVector<Event>& events, const QDate& cutoff)
+{
+    if (!isOpen() || !cutoff.isValid()) return 0;
+
+    // Group archivable events by every month they overlap, so a segment
+    // read on its own has events that started in an earlier month too
+    QMap<int, QVector<Event>> byMonth;
+    for (const Event& e : events) {
+        if (e.getEndTime().date() >= cutoff) continue;
+        const auto span = monthSpan(e);
+        for (int k = span.first; k <= span.second; ++k) byMonth[k].push_back(e);
+    }
+    if (byMonth.isEmpty()) return 0;
+
+    for (auto it = byMonth.begin(); it != byMonth.end(); ++it) {
+        QVector<Event> merged;
+        if (m_segments.contains(it.key()) && !readSegment(it.key(), merged)) return 0;
+
+        QSet<QString> seen;
+        for (const Event& e : merged) seen.insert(dedupeKey(e));
+        for (const Event& e : it.value())
+            if (!seen.contains(dedupeKey(e))) { seen.insert(dedupeKey(e)); merged.push_back(e); }
+
+        if (!writeSegment(it.key(), merged)) return 0;
+        m_cache.remove(it.key());
+        m_lru.removeAll(it.key());
+    }
+
+    const int before = events.size();
+    events.erase(std::remove_if(events.begin(), events.end(),
+                                [&](const Event& e){ return e.getEndTime().date() < cutoff; }),
+                 events.end());
+    return before - events.size();
+}
+
+QVector<Event> ArchiveStore::monthEvents(const QDate& d)
+{
+    const int key = monthKey(d);
+    if (!m_segments.contains(key)) return {};
+
+    m_lru.removeAll(key);
+    m_lru.prepend(key);
+
+    auto it = m_cache.find(key);
+    if (it == m_cache.end()) {
+        QVector<Event> evs;
+        if (!readSegment(key, evs)) { m_lru.removeAll(key); return {}; }
+        it = m_cache.insert(key, evs);
+    }
+    const QVector<Event> out = *it;   // implicitly shared; no copy of the events
+    trim(m_cacheCap);
+    return out;
+}
+
+QVector<Event> ArchiveStore::eventsBetween(const QDate& from, const QDate& to)
+{
+    if (!from.isValid() || !to.isValid()) return {};
+    QList<int> keys;
+    for (auto it = m_segments.lowerBound(monthKey(from));
+         it != m_segments.end() && it.key() <= monthKey(to); ++it)
+        keys << it.key();
+    return eventsInMonths(keys);
+}
+
+QVector<Event> ArchiveStore::eventsInMonths(QList<int> keys)
+{
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    QVector<Event> out;
+    for (int i = 0; i < keys.size(); ++i) {
+        const QVector<Event> month = monthEvents(monthOf(keys[i]));
+        // An event spanning months sits in each of their segments; keep it
+        // from the first requested month it overlaps
+        for (const Event& e : month)
+            if (i == 0 || keys[i - 1] < monthSpan(e).first) out.push_back(e);
+    }
+    return out;
+}
+
+void ArchiveStore::trim(int keep)
+{
+    while (m_lru.size() > keep)
+        m_cache.remove(m_lru.takeLast());
+}
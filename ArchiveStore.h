@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+#include "Event.h"
+
+/**
+ * @brief ArchiveStore
+ * Compressed, read-only month segments for events older than a cutoff.
+ *
+ * On-disk layout
+ *   <dir>/<yyyy>-<mm>.seg   qCompress(columnar QDataStream payload)
+ *
+ * Payload columns (all of length n): start secs, duration secs, colour (RGB),
+ * then title / description / series id / uid string columns. Grouping by
+ * column keeps similar values together, which compresses well.
+ *
+ * Notes
+ *  - Only the segment list (month → file size) stays resident; events are
+ *    decompressed when a month is asked for and kept in a small LRU cache.
+ *  - An event is stored in every month it overlaps, so a month read on its
+ *    own is complete; reads spanning several months return it once.
+ *  - Archiving merges into an existing month segment and de-duplicates by uid
+ *    (or by title+times for events without one).
+ *  - Only views read archived months (CalendarStore's archive layer);
+ *    analytics (EventColumns, forecasts, day stats) see live events only.
+ */
+class ArchiveStore {
+public:
+    ArchiveStore() = default;
+
+    /// Point the store at @dir (created if needed) and scan existing segments.
+    void open(const QString& dir);
+    bool isOpen() const { return !m_dir.isEmpty(); }
+
+    /**
+     * @brief archiveBefore
+     * Moves events that ended before @cutoff out of @events into month segments.
+     * @return number of events moved (0 on I/O error; @events is then untouched)
+     */
+    int archiveBefore(QVector<Event>& events, const QDate& cutoff);
+
+    /// True if the month containing @d has an archive segment.
+    bool covers(const QDate& d) const { return m_segments.contains(monthKey(d)); }
+
+    /// Events of the month containing @d (decompressed on first use, then cached).
+    QVector<Event> monthEvents(const QDate& d);
+
+    /// Events of all archived months overlapping [from, to].
+    QVector<Event> eventsBetween(const QDate& from, const QDate& to);
+
+    /// Events of the archived months among @keys (monthKey(); any order, each event once).
+    QVector<Event> eventsInMonths(QList<int> keys);
+
+    /// Drop decompressed months beyond the @keep most recently used ones.
+    void trim(int keep);
+
+    int     segmentCount()   const { return m_segments.size(); }
+    qint64  compressedBytes() const;
+
+    static int  monthKey(const QDate& d) { return d.year() * 12 + (d.month() - 1); }
+    static QDate monthOf(int key)        { return QDate(key / 12, key % 12 + 1, 1); }
+
+private:
+    QString segmentPath(int key) const;
+
+    bool readSegment(int key, QVector<Event>& out) const;
+    bool writeSegment(int key, const QVector<Event>& evs);
+
+    QString             m_dir;
+    QMap<int, qint64>   m_segments;  ///< month key → compressed size on disk
+    QHash<int, QVector<Event>> m_cache;
+    QList<int>          m_lru;       ///< most recently used month keys, front = newest
+    int                 m_cacheCap = 3;
+};
@@ -0,0 +1,240 @@
+#include "CalendarExporter.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QPageLayout>
+#include <QPageSize>
+#include <QPdfWriter>
+#include <QPicture>
+#include <QPointer>
+#include <algorithm>  // std::max, std::min
+
+static const QSize kPngMonth(1600, 1200);
+static const QSize kPngWeek(1600, 900);
+
+using Prio = JobScheduler::Priority;
+
+/// One PDF export: inputs, the writer, and pages recorded but not yet written.
+struct CalendarExporter::PdfRun {
+    explicit PdfRun(const QString& path) : pdf(path) {}
+
+    JobScheduler*              jobs = nullptr;
+    JobScheduler::CancelToken  token;
+    QPointer<CalendarExporter> owner;
+    int                        runId = 0;
+    Job                        job;
+    QVector<Page>              pages;
+    QRect                      rect;
+    bool                       over = false;     // finished() sent (GUI thread)
+
+    QPdfWriter                 pdf;
+    QPainter                   painter;          // write jobs only; they run one at a time
+    bool                       opened = false;
+
+    QMutex                          m;           // guards pics
+    QHash<int, QPicture>            pics;        // recorded, not yet written
+    QHash<int, JobScheduler::JobId> writes;      // write job per page, until the next one is queued (GUI thread)
+};
+
+CalendarExporter::CalendarExporter(JobScheduler* jobs, QObject* parent)
+    : QObject(parent), m_jobs(jobs)
+{
+}
+
+CalendarExporter::~CalendarExporter()
+{
+    // Jobs own their inputs; whatever has not started yet is dropped
+    m_cancel.cancel();
+}
+
+// ============================================================================
+// Snapshot (GUI thread) / render (any thread)
+// ============================================================================
+
+CalendarExporter::Page CalendarExporter::snapshot(const Job& job, int page, const CalendarLayers& layers)
+{
+    Page pg;
+    if (job.view == View::Month) {
+        pg.month = QDate(job.from.year(), job.from.month(), 1).addMonths(page);
+        const int off = (pg.month.dayOfWeek() - int(job.firstDay) + 7) % 7;
+        pg.gridStart = pg.month.addDays(-off);
+        pg.cells     = layers.compose(pg.gridStart, 42);
+        pg.label     = pg.month.toString("yyyy-MM");
+        return pg;
+    }
+
+    const int off = (job.from.dayOfWeek() - int(job.firstDay) + 7) % 7;
+    pg.gridStart = job.from.addDays(-off + 7 * page);
+    int year = 0;
+    const int wk = pg.gridStart.weekNumber(&year);
+    pg.label = QString("%1-W%2").arg(year).arg(wk, 2, 10, QChar('0'));
+    pg.week.resize(7);
+    for (int i = 0; i < 7; ++i) {
+        auto& day = pg.week[i];
+        day.date = pg.gridStart.addDays(i);
+        for (const auto& [slot, row] : layers.rowsOn(day.date)) {
+            const Event& e = layers.eventAt(slot, day.date, row);
+            const QString time = e.getStartTime().date() < day.date
+                                 ? QStringLiteral("…") : e.getStartTime().toString("hh:mm");
+            day.entries.push_back({ time, e.getTitle(), layers.at(slot).color });
+        }
+    }
+    return pg;
+}
+
+void CalendarExporter::render(QPainter& p, const QRect& rect, const Job& job, const Page& page)
+{
+    // Pixel-sized font so PNG and PDF pages match regardless of device DPI
+    QFont f = p.font();
+    f.setPixelSize(std::max(11, rect.height() / 70));
+    p.setFont(f);
+
+    const auto theme = job.light ? CalendarPainter::Theme::light() : CalendarPainter::Theme::dark();
+    if (job.view == View::Month)
+        CalendarPainter::drawMonthPage(p, rect, page.month, page.gridStart, page.cells, theme);
+    else
+        CalendarPainter::drawWeekPage(p, rect, page.week, theme);
+}
+
+// ============================================================================
+// Runs
+// ============================================================================
+
+int CalendarExporter::start(const Job& job, const CalendarLayers& layers)
+{
+    if (m_busy) return 0;   // one run at a time; its pages already fill the workers
+    const int runId = ++m_lastRun;
+
+    // Only the inputs are held for every page; rendered pages are not
+    QVector<Page> pages;
+    pages.reserve(std::max(1, job.pages));
+    for (int i = 0; i < std::max(1, job.pages); ++i) pages.push_back(snapshot(job, i, layers));
+
+    ++m_busy;
+    if (job.format == Format::Png) startPng(runId, job, pages);
+    else                           startPdf(runId, job, pages);
+    return runId;
+}
+
+void CalendarExporter::startPng(int runId, const Job& job, const QVector<Page>& pages)
+{
+    struct Run { QStringList files; QString error; int done = 0; };   // GUI thread only
+    auto run = QSharedPointer<Run>::create();
+
+    const QFileInfo fi(job.path);
+    const QString base = fi.path() + "/" + fi.completeBaseName();
+    const int total = pages.size();
+
+    for (int i = 0; i < total; ++i) {
+        const QString file = total == 1 ? base + ".png" : base + "-" + pages[i].label + ".png";
+
+        JobScheduler::Options o;
+        o.token   = m_cancel;
+        o.context = this;
+        o.done    = [this, run, runId, file, total](const QVariant& ok) {
+            if (ok.toBool()) run->files << file;
+            else if (run->error.isEmpty()) run->error = "Could not write " + file;
+            emit progress(runId, ++run->done, total);
+            if (run->done != total) return;
+            --m_busy;
+            emit finished(runId, run->files, run->error);
+        };
+        m_jobs->submit(Prio::Batch, [job, page = pages[i], file](const JobScheduler::CancelToken&) {
+            QImage img(job.view == View::Month ? kPngMonth : kPngWeek, QImage::Format_ARGB32_Premultiplied);
+            {
+                QPainter p(&img);
+                render(p, img.rect(), job, page);
+            }
+            return QVariant(img.save(file, "PNG"));
+        }, o);
+    }
+}
+
+void CalendarExporter::startPdf(int runId, const Job& job, const QVector<Page>& pages)
+{
+    auto run = QSharedPointer<PdfRun>::create(job.path);
+    run->jobs  = m_jobs;
+    run->token = m_cancel;
+    run->owner = this;
+    run->runId = runId;
+    run->job   = job;
+    run->pages = pages;
+
+    run->pdf.setResolution(96);
+    run->pdf.setPageSize(QPageSize(QPageSize::A4));
+    run->pdf.setPageOrientation(QPageLayout::Landscape);
+    run->pdf.setTitle(job.view == View::Month ? "EduSync month export" : "EduSync week export");
+    run->pdf.setCreator("EduSync");
+    run->rect = QRect(0, 0, run->pdf.width(), run->pdf.height());
+
+    for (int i = 0; i < std::min<int>(kInFlight, pages.size()); ++i) queuePdfPage(run, i);
+}
+
+/**
+ * @brief queuePdfPage
+ * Render job for page @i, and its write job after that render and the
+ * previous page's write. GUI thread only: startPdf() queues the first
+ * kInFlight pages, then each written page queues page i + kInFlight from
+ * pdfPageWritten(), so the previous write is always queued (or finished)
+ * by the time a page chains to it.
+ */
+void CalendarExporter::queuePdfPage(const QSharedPointer<PdfRun>& run, int i)
+{
+    JobScheduler::Options ro;
+    ro.token = run->token;
+    const JobScheduler::JobId rendered = run->jobs->submit(Prio::Batch, [run, i](const JobScheduler::CancelToken&) {
+        QPicture pic;
+        {
+            QPainter pp(&pic);
+            render(pp, run->rect, run->job, run->pages[i]);
+        }
+        QMutexLocker lock(&run->m);
+        run->pics.insert(i, pic);
+        return QVariant();
+    }, ro);
+
+    JobScheduler::Options wo;
+    wo.token   = run->token;
+    wo.after   = { rendered };
+    wo.context = run->owner.data();
+    wo.done    = [run, i](const QVariant& ok) {
+        if (run->owner) run->owner->pdfPageWritten(run, i, ok.toBool());
+    };
+    if (i > 0) {
+        Q_ASSERT(run->writes.contains(i - 1));
+        wo.after.push_back(run->writes.take(i - 1));
+    }
+
+    const JobScheduler::JobId written = run->jobs->submit(Prio::Batch, [run, i](const JobScheduler::CancelToken&) {
+        const int total = run->pages.size();
+        QPicture pic;
+        {
+            QMutexLocker lock(&run->m);
+            pic = run->pics.take(i);
+        }
+        if (i == 0) run->opened = run->painter.begin(&run->pdf);
+        if (!run->opened) return QVariant(false);
+
+        if (i > 0) run->pdf.newPage();
+        run->painter.drawPicture(0, 0, pic);
+        return QVariant(i + 1 < total || run->painter.end());
+    }, wo);
+
+    run->writes.insert(i, written);
+}
+
+void CalendarExporter::pdfPageWritten(const QSharedPointer<PdfRun>& run, int i, bool ok)
+{
+    if (run->over) return;
+    const int total = run->pages.size();
+    if (ok) emit progress(run->runId, i + 1, total);
+    if (ok && i + kInFlight < total) queuePdfPage(run, i + kInFlight);
+    if (ok && i + 1 < total) return;
+
+    run->over = true;
+    --m_busy;
+    if (ok) emit finished(run->runId, { run->job.path }, QString());
+    else    emit finished(run->runId, {}, "Could not write " + run->job.path);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QDate>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include "CalendarLayers.h"
+#include "CalendarPainter.h"
+#include "JobScheduler.h"
+
+/**
+ * @brief CalendarExporter
+ * Offscreen month/week export to PDF or PNG on worker threads.
+ *
+ * The GUI thread only takes a small snapshot per page (42 DayCells for a
+ * month, seven lists of titles for a week); drawing happens as Batch jobs on
+ * the shared JobScheduler with CalendarPainter, the same code
+ * ModernCalendarWidget paints with.
+ *
+ * Streaming
+ *  - PNG: every page renders into its own QImage in parallel and is saved to
+ *    "<base>-<label>.png" as soon as it is done, then freed.
+ *  - PDF: pages are recorded in parallel into QPictures (vector, small) and
+ *    replayed into one QPdfWriter by a chain of write jobs, each running
+ *    after its page's render and the previous write. Each written page
+ *    queues the page kInFlight ahead (from the GUI thread, where all pages
+ *    are queued), so memory stays flat however many months are exported
+ *    and no worker blocks waiting for a page.
+ */
+class CalendarExporter : public QObject {
+    Q_OBJECT
+public:
+    enum class View   { Month, Week };
+    enum class Format { Pdf, Png };
+
+    struct Job {
+        View    view   = View::Month;
+        Format  format = Format::Pdf;
+        QDate   from;                    ///< any day in the first month/week
+        int     pages  = 1;              ///< months or weeks
+        QString path;                    ///< PDF file, or PNG base name
+        bool    light  = true;
+        Qt::DayOfWeek firstDay = Qt::Monday;
+    };
+
+    /// One page's drawing inputs, taken on the GUI thread.
+    struct Page {
+        QString label;                              ///< "2025-03" or "2025-W11"
+        QDate   month;                              ///< month pages
+        QDate   gridStart;
+        QVector<DayCell> cells;
+        QVector<CalendarPainter::WeekDay> week;     ///< week pages
+    };
+
+    static constexpr int kInFlight = 8;             ///< PDF pages rendered ahead of the writer
+
+    explicit CalendarExporter(JobScheduler* jobs, QObject* parent = nullptr);
+    ~CalendarExporter() override;
+
+    /// Snapshot @job's pages from @layers and start rendering; returns the run id,
+    /// or 0 (nothing started) while an earlier run is still going.
+    int start(const Job& job, const CalendarLayers& layers);
+
+    /// Snapshot of one page (GUI thread; reads @layers only).
+    static Page snapshot(const Job& job, int page, const CalendarLayers& layers);
+
+    /// Draw @page into @p over @rect (any thread).
+    static void render(QPainter& p, const QRect& rect, const Job& job, const Page& page);
+
+    bool isBusy() const { return m_busy > 0; }
+
+signals:
+    void progress(int runId, int done, int total);
+    void finished(int runId, const QStringList& files, const QString& error);
+
+private:
+    struct PdfRun;
+    void startPng(int runId, const Job& job, const QVector<Page>& pages);
+    void startPdf(int runId, const Job& job, const QVector<Page>& pages);
+    static void queuePdfPage(const QSharedPointer<PdfRun>& run, int i);
+    void pdfPageWritten(const QSharedPointer<PdfRun>& run, int i, bool ok);
+
+    JobScheduler*             m_jobs = nullptr;
+    JobScheduler::CancelToken m_cancel;   // cancelled on destruction; queued pages are dropped
+    int         m_lastRun = 0;
+    int         m_busy    = 0;        // runs not finished yet (GUI thread only)
+};
@@ -0,0 +1,160 @@
+#include "CalendarLayers.h"
+#include <QUuid>
+#include <algorithm>  // std::stable_sort, std::min
+
+int CalendarLayers::attach(const QString& name, const QColor& color,
+                           const QVector<Event>* events, const EventIndex* index)
+{
+    auto l = std::make_unique<Layer>();
+    l->id       = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    l->name     = name;
+    l->color    = color;
+    l->ext      = events;
+    l->extIndex = index;
+    m_layers.push_back(std::move(l));
+    return size() - 1;
+}
+
+int CalendarLayers::add(const QString& name, const QColor& color,
+                        const QVector<Event>& events, bool readOnly,
+                        const QString& source)
+{
+    auto l = std::make_unique<Layer>();
+    l->id       = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    l->name     = name;
+    l->color    = color;
+    l->readOnly = readOnly;
+    l->source   = source;
+    l->own      = events;
+    l->ownIndex.rebuild(l->own);
+    m_layers.push_back(std::move(l));
+    return size() - 1;
+}
+
+void CalendarLayers::remove(int slot)
+{
+    if (slot <= 0 || slot >= size()) return;   // slot 0 is the personal calendar
+    m_layers.erase(m_layers.begin() + slot);
+}
+
+void CalendarLayers::setEvents(int slot, const QVector<Event>& events)
+{
+    if (slot < 0 || slot >= size()) return;
+    Layer& l = *m_layers[size_t(slot)];
+    if (l.ext) return;
+    l.own = events;
+    l.ownIndex.rebuild(l.own);
+}
+
+void CalendarLayers::setVisible(int slot, bool on)
+{
+    if (slot < 0 || slot >= size()) return;
+    m_layers[size_t(slot)]->visible = on;
+}
+
+QVector<DayCell> CalendarLayers::compose(const QDate& first, int days) const
+{
+    QVector<DayCell> cells(days);
+
+    // Chip candidates with their start time; only the earliest few per layer
+    // can make it into the merged chips, so this stays O(layers) per day.
+    struct Candidate { QDateTime start; DayCell::Chip chip; };
+    QVector<QVector<Candidate>> cand(days);
+
+    const EventIndex::CategoryMask only = categoryFilter();
+    for (const auto& l : m_layers) {
+        if (!l->visible) continue;
+        const EventIndex&     idx = l->index();
+        const QVector<Event>& evs = l->events();
+
+        for (int i = 0; i < days; ++i) {
+            const EventIndex::DaySummary* s = idx.summaryOn(first.addDays(i));
+            if (!s || !(s->categories & only)) continue;
+
+            // Counts come from the summary; only chip rows touch events
+            cells[i].count += s->countIn(only);
+            const bool all = s->allIn(only);
+            for (int k = 0, taken = 0; k < s->rows.size() && taken < DayCell::kMaxChips; ++k) {
+                if (!all && !s->rowIn(k, only)) continue;
+                const Event& e = evs[s->rows[k]];
+                cand[i].push_back({ e.getStartTime(), { e.getTitle(), l->color } });
+                ++taken;
+            }
+        }
+    }
+
+    for (int i = 0; i < days; ++i) {
+        auto& c = cand[i];
+        std::stable_sort(c.begin(), c.end(),
+                         [](const Candidate& a, const Candidate& b){ return a.start < b.start; });
+        const int n = std::min<int>(DayCell::kMaxChips, c.size());
+        for (int k = 0; k < n; ++k) cells[i].chips.push_back(c[k].chip);
+    }
+    return cells;
+}
+
+QVector<QPair<int,int>> CalendarLayers::rowsOn(const QDate& d, EventIndex::CategoryMask only) const
+{
+    QVector<QPair<int,int>> out;
+    for (int s = 0; s < size(); ++s) {
+        const Layer& l = at(s);
+        if (!l.visible) continue;
+        const EventIndex::DaySummary* sum = l.index().summaryOn(d);
+        if (!sum) continue;
+        const bool all = sum->allIn(only);
+        for (int r = 0; r < sum->rows.size(); ++r)
+            if (all || sum->rowIn(r, only)) out.push_back({ s, r });
+    }
+
+    // Each layer's rows are already sorted; a stable sort merges them by start
+    std::stable_sort(out.begin(), out.end(), [&](const QPair<int,int>& a, const QPair<int,int>& b) {
+        return eventAt(a.first, d, a.second).getStartTime()
+             < eventAt(b.first, d, b.second).getStartTime();
+    });
+    return out;
+}
+
+void CalendarLayers::setHiddenCategories(const QStringList& names, bool hideOther)
+{
+    m_hidden.clear();
+    for (const QString& n : names) m_hidden << n.trimmed().toLower();
+    m_hideOther = hideOther;
+    m_filterGen = -1;
+}
+
+EventIndex::CategoryMask CalendarLayers::categoryFilter() const
+{
+    const int gen = EventIndex::categoryGeneration();
+    if (gen == m_filterGen) return m_filter;
+
+    // Look names up without registering them: a saved name whose category
+    // is gone takes no bit. A name that fell into the shared bit is only
+    // hidden with the whole "Other" group.
+    m_filter = EventIndex::kAllCategories;
+    for (const QString& n : m_hidden) {
+        const int bit = EventIndex::findCategoryBit(n);
+        if (bit >= 0 && bit != EventIndex::kOtherBit) m_filter &= ~(EventIndex::CategoryMask(1) << bit);
+    }
+    if (m_hideOther) m_filter &= ~(EventIndex::CategoryMask(1) << EventIndex::kOtherBit);
+    m_filterGen = gen;
+    return m_filter;
+}
+
+const Event& CalendarLayers::eventAt(int slot, const QDate& d, int rowInDay) const
+{
+    const Layer& l = at(slot);
+    return l.events()[l.index().rowsOn(d)[rowInDay]];
+}
+
+QString CalendarLayers::tooltipFor(const QDate& d) const
+{
+    QStringList parts;
+    const EventIndex::CategoryMask only = categoryFilter();
+    for (const auto& l : m_layers) {
+        if (!l->visible) continue;
+        const QString t = l->index().tooltipFor(d, only);
+        if (t.isEmpty()) continue;
+        parts << (l.get() == m_layers.front().get() ? t : QString("[%1]\n%2").arg(l->name, t));
+    }
+    return parts.join("\n");
+}
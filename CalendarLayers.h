@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QColor>
+#include <QDate>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+#include "Event.h"
+#include "EventIndex.h"
+
+/**
+ * @brief DayCell
+ * What the month grid paints for one day, composed from all visible layers.
+ */
+struct DayCell {
+    struct Chip { QString title; QColor color; };
+
+    int           count = 0;   ///< events on this day across visible layers
+    QVector<Chip> chips;       ///< earliest few titles (at most kMaxChips)
+
+    static constexpr int kMaxChips = 2;
+};
+
+/**
+ * @brief CalendarLayers
+ * Named calendars (personal, courses, imported, read-only shared) shown as overlays.
+ *
+ * Each layer owns (or borrows) its events and an EventIndex, so toggling a
+ * layer only recomposes per-day cells from the layers' cached day rows; no
+ * event is re-filtered. Painting reads one composed DayCell per grid cell,
+ * so paint cost does not grow with the number of layers.
+ *
+ * A category filter works the same way: compose() takes counts from each
+ * day's per-category counts, and only reads the events it makes chips of.
+ * rowsOn() and tooltipFor() apply it too, so the day list, popups, agenda
+ * and dashboard show what the grid shows.
+ *
+ * Notes
+ *  - Slot 0 is reserved for the editable personal calendar, which stays owned
+ *    by CalendarStore (events()/index()) and is attached by pointer.
+ *  - Layers are held by pointer so EventIndex back-references stay valid.
+ */
+class CalendarLayers {
+public:
+    struct Layer {
+        QString id;
+        QString name;
+        QColor  color;
+        bool    readOnly = false;
+        bool    visible  = true;
+        QString source;            ///< file the layer was imported from (if any)
+
+        const QVector<Event>& events() const { return ext ? *ext : own; }
+        const EventIndex&     index()  const { return extIndex ? *extIndex : ownIndex; }
+
+    private:
+        friend class CalendarLayers;
+        QVector<Event>        own;
+        EventIndex            ownIndex;
+        const QVector<Event>* ext      = nullptr;   ///< borrowed storage (slot 0)
+        const EventIndex*     extIndex = nullptr;
+    };
+
+    /// Register a borrowed layer (events/index are kept up to date by the owner).
+    int attach(const QString& name, const QColor& color,
+               const QVector<Event>* events, const EventIndex* index);
+
+    /// Add an owned layer and index @events.
+    int add(const QString& name, const QColor& color,
+            const QVector<Event>& events, bool readOnly,
+            const QString& source = QString());
+
+    void remove(int slot);
+
+    /// Replace an owned layer's events and rebuild its index (no-op for borrowed layers).
+    void setEvents(int slot, const QVector<Event>& events);
+
+    int size() const { return int(m_layers.size()); }
+    const Layer& at(int slot) const { return *m_layers[size_t(slot)]; }
+
+    void setVisible(int slot, bool on);
+    bool isVisible(int slot) const { return at(slot).visible; }
+
+    /// Hide events in @names (trimmed, case-insensitive) and, with @hideOther,
+    /// those sharing EventIndex::kOtherBit. Names no index has met take no bit;
+    /// they apply once one does.
+    void setHiddenCategories(const QStringList& names, bool hideOther);
+    /// Mask of shown categories, rebuilt when new categories are registered.
+    EventIndex::CategoryMask categoryFilter() const;
+
+    /// Compose one DayCell per day for [first, first + days).
+    QVector<DayCell> compose(const QDate& first, int days) const;
+
+    /// Visible (slot, row-in-day) pairs on @d, merged by start time.
+    QVector<QPair<int,int>> rowsOn(const QDate& d) const { return rowsOn(d, categoryFilter()); }
+    /// Same, with @only instead of the category filter (e.g. kAllCategories for conflicts).
+    QVector<QPair<int,int>> rowsOn(const QDate& d, EventIndex::CategoryMask only) const;
+
+    /// Event for a (slot, row-in-day) pair returned by rowsOn().
+    const Event& eventAt(int slot, const QDate& d, int rowInDay) const;
+
+    /// Tooltip for @d joined across visible layers (each memoised by its index).
+    QString tooltipFor(const QDate& d) const;
+
+private:
+    std::vector<std::unique_ptr<Layer>> m_layers;
+    QStringList                         m_hidden;          // lower-case names
+    bool                                m_hideOther = false;
+    mutable EventIndex::CategoryMask    m_filter = EventIndex::kAllCategories;
+    mutable int                         m_filterGen = -1;  // EventIndex::categoryGeneration() m_filter is for
+};
@@ -0,0 +1,249 @@
+#include "CalendarPainter.h"
+
+#include <QFontMetrics>
+#include <QLocale>
+#include <algorithm>  // std::min, std::max
+
+static constexpr int kChipH   = 18;
+static constexpr int kChipGap = 4;
+static const QColor  kDotColor(180, 170, 255);
+static const QColor  kChipColor(140, 70, 255);
+
+// Offscreen pages use pixel-sized fonts (same size on every device); the
+// widget uses point sizes. Scale whichever one is set.
+static QFont scaled(QFont f, double k)
+{
+    if (f.pixelSize() > 0) f.setPixelSize(std::max(1, int(f.pixelSize() * k + 0.5)));
+    else if (f.pointSizeF() > 0) f.setPointSizeF(f.pointSizeF() * k);
+    return f;
+}
+
+// ============================================================================
+// Theme
+// ============================================================================
+
+CalendarPainter::Theme CalendarPainter::Theme::light()
+{
+    return Theme{ QColor("#ffffff"), QColor("#111827"), QColor("#c7c9ce"),
+                  QColor("#e5e7eb"), QColor("#6b7280") };
+}
+
+CalendarPainter::Theme CalendarPainter::Theme::dark()
+{
+    return Theme{ QColor("#1f2428"), QColor("#e6e9ec"), QColor("#5a6168"),
+                  QColor("#2f3540"), QColor("#9aa3ab") };
+}
+
+// ============================================================================
+// Cell pieces
+// ============================================================================
+
+QFont CalendarPainter::badgeFont(const QFont& base)
+{
+    QFont f = base;
+    f.setBold(true);
+    if (f.pointSizeF() > 0)     f.setPointSizeF(std::max(7.0, f.pointSizeF() - 2));
+    else if (f.pixelSize() > 0) f.setPixelSize(std::max(9, f.pixelSize() - 2));
+    return f;
+}
+
+CalendarPainter::DotsLayout CalendarPainter::dotsLayout(const QRect& cell, int count, const QFont& base)
+{
+    DotsLayout l;
+    if (count <= 0) return l;
+
+    const int pitch = 2 * kDotR + kDotGap;
+    const int fit   = std::max(1, (cell.width() - 24) / pitch);   // keep room for the badge
+    l.shown = std::min({ count, kMaxDots, fit });
+
+    int totalW = l.shown * 2 * kDotR + (l.shown - 1) * kDotGap;
+    if (const int more = count - l.shown; more > 0) {
+        const QFontMetrics fm(badgeFont(base));
+        l.badge = QRect(0, 0, fm.horizontalAdvance(QString("+%1").arg(more)) + 10, fm.height() + 2);
+        totalW += kDotGap + l.badge.width();
+    }
+    l.left = cell.center().x() - totalW / 2;
+    l.y    = cell.top() + 26;
+    if (!l.badge.isNull())
+        l.badge.moveTo(l.left + l.shown * pitch, l.y - l.badge.height() / 2);
+    return l;
+}
+
+void CalendarPainter::drawDayNumber(QPainter& p, const QRect& cell, int day, const QColor& fg)
+{
+    p.setPen(fg);
+    QFont f = p.font(); f.setBold(true); p.setFont(f);
+    p.drawText(cell.adjusted(10, 6, -10, -6), Qt::AlignLeft | Qt::AlignTop, QString::number(day));
+}
+
+void CalendarPainter::drawDots(QPainter& p, const QRect& cell, int count, const QFont& base)
+{
+    const DotsLayout l = dotsLayout(cell, count, base);
+    if (!l.shown) return;
+
+    p.setPen(Qt::NoPen);
+    p.setBrush(kDotColor);
+    for (int i = 0; i < l.shown; ++i)
+        p.drawEllipse(QPoint(l.left + kDotR + i * (2 * kDotR + kDotGap), l.y), kDotR, kDotR);
+
+    if (l.badge.isNull()) return;
+    p.drawRoundedRect(l.badge, l.badge.height() / 2.0, l.badge.height() / 2.0);
+    const QFont old = p.font();
+    p.setFont(badgeFont(base));
+    p.setPen(QColor(30, 26, 60));
+    p.drawText(l.badge, Qt::AlignCenter, QString("+%1").arg(count - l.shown));
+    p.setFont(old);   // chips are drawn next with the cell font
+}
+
+void CalendarPainter::drawChips(QPainter& p, const QRect& cell,
+                                const QStringList& titles, const QVector<QColor>& colors)
+{
+    if (titles.isEmpty()) return;
+
+    const int maxChips = std::min<int>(DayCell::kMaxChips, titles.size());
+    int y = cell.bottom() - 6 - maxChips * (kChipH + kChipGap);
+
+    QFont f = p.font();
+    f.setBold(false);
+    p.setFont(f);
+    const QFontMetrics fm(f);
+
+    for (int i = 0; i < maxChips; ++i) {
+        QRect r = cell.adjusted(6, y - cell.top(), -6, 0);
+        r.setHeight(kChipH);
+
+        const QString txt = fm.elidedText(titles[i], Qt::ElideRight, r.width() - 12); // 6px padding each side
+
+        p.setPen(Qt::NoPen);
+        p.setBrush(i < colors.size() ? colors[i] : kChipColor);   // layer colour
+        p.drawRoundedRect(r, 6, 6);
+
+        p.setPen(QColor(250, 250, 255));
+        p.drawText(r.adjusted(6, 0, -6, 0), Qt::AlignVCenter | Qt::AlignLeft, txt);
+
+        y += kChipH + kChipGap;
+    }
+}
+
+// ============================================================================
+// Pages
+// ============================================================================
+
+// Title line + weekday header shared by month and week pages; returns the grid area.
+static QRect drawPageChrome(QPainter& p, const QRect& page, const QString& title,
+                            const QVector<QDate>& headerDays, const CalendarPainter::Theme& t)
+{
+    p.fillRect(page, t.background);
+
+    const QFont base = p.font();
+    QFont f = scaled(base, 1.6);
+    f.setBold(true);
+    p.setFont(f);
+    const int titleH = QFontMetrics(f).height() + 12;
+    p.setPen(t.text);
+    p.drawText(page.adjusted(12, 0, -12, 0).translated(0, 6), Qt::AlignLeft | Qt::AlignTop, title);
+
+    f = base;
+    f.setBold(true);
+    p.setFont(f);
+    const int headH = QFontMetrics(f).height() + 12;
+    const QRect head(page.left(), page.top() + titleH, page.width(), headH);
+    const QLocale loc;
+    const double colW = page.width() / 7.0;
+    p.setPen(t.header);
+    for (int c = 0; c < 7; ++c) {
+        const QRect r(page.left() + int(c * colW), head.top(), int(colW), headH);
+        p.drawText(r, Qt::AlignCenter, loc.dayName(headerDays[c].dayOfWeek(), QLocale::ShortFormat).toUpper());
+    }
+    p.setPen(t.grid);
+    p.drawLine(head.bottomLeft(), head.bottomRight());
+
+    p.setFont(base);
+    return QRect(page.left(), head.bottom() + 1, page.width(), page.bottom() - head.bottom());
+}
+
+void CalendarPainter::drawMonthPage(QPainter& p, const QRect& page, const QDate& month,
+                                    const QDate& gridStart, const QVector<DayCell>& cells,
+                                    const Theme& t)
+{
+    p.save();
+    p.setRenderHint(QPainter::Antialiasing);
+
+    QVector<QDate> week;
+    for (int c = 0; c < 7; ++c) week << gridStart.addDays(c);
+    const QRect grid = drawPageChrome(p, page, QLocale().toString(month, "MMMM yyyy"), week, t);
+
+    const double cw = grid.width() / 7.0, ch = grid.height() / 6.0;
+    const QFont base = p.font();
+    for (int i = 0; i < 42; ++i) {
+        const QDate d = gridStart.addDays(i);
+        const QRect cell(grid.left() + int((i % 7) * cw), grid.top() + int((i / 7) * ch),
+                         int(cw), int(ch));
+        p.setPen(t.grid);
+        p.setBrush(Qt::NoBrush);
+        p.drawRect(cell);
+
+        const bool inMonth = d.month() == month.month() && d.year() == month.year();
+        drawDayNumber(p, cell, d.day(), inMonth ? t.text : t.dimText);
+        p.setFont(base);
+        if (!inMonth || i >= cells.size()) continue;
+
+        const DayCell& c = cells[i];
+        drawDots(p, cell, c.count, base);
+        QStringList titles; QVector<QColor> colors;
+        for (const auto& chip : c.chips) { titles << chip.title; colors << chip.color; }
+        drawChips(p, cell, titles, colors);
+        p.setFont(base);
+    }
+    p.restore();
+}
+
+void CalendarPainter::drawWeekPage(QPainter& p, const QRect& page, const QVector<WeekDay>& days,
+                                   const Theme& t)
+{
+    if (days.size() != 7) return;
+    p.save();
+    p.setRenderHint(QPainter::Antialiasing);
+
+    QVector<QDate> week;
+    for (const WeekDay& d : days) week << d.date;
+    const QLocale loc;
+    const QString title = QString("%1 – %2").arg(loc.toString(week.first(), "d MMM"),
+                                                 loc.toString(week.last(), "d MMM yyyy"));
+    const QRect grid = drawPageChrome(p, page, title, week, t);
+
+    const double cw = grid.width() / 7.0;
+    const QFont base = p.font();
+    const QFontMetrics fm(base);
+    for (int c = 0; c < 7; ++c) {
+        const QRect cell(grid.left() + int(c * cw), grid.top(), int(cw), grid.height());
+        p.setPen(t.grid);
+        p.setBrush(Qt::NoBrush);
+        p.drawRect(cell);
+        drawDayNumber(p, cell, days[c].date.day(), t.text);
+        p.setFont(base);
+
+        // Chips top-down; whatever does not fit becomes a "+N more" line
+        const auto& entries = days[c].entries;
+        const int top  = cell.top() + fm.height() + 14;
+        const int room = std::max(0, (cell.bottom() - 6 - top) / (kChipH + kChipGap));
+        const int shown = entries.size() > room ? std::max(0, room - 1) : int(entries.size());
+        for (int i = 0; i < shown; ++i) {
+            QRect r(cell.left() + 6, top + i * (kChipH + kChipGap), cell.width() - 12, kChipH);
+            p.setPen(Qt::NoPen);
+            p.setBrush(entries[i].color.isValid() ? entries[i].color : kChipColor);
+            p.drawRoundedRect(r, 6, 6);
+            p.setPen(QColor(250, 250, 255));
+            const QString txt = entries[i].time + "  " + entries[i].title;
+            p.drawText(r.adjusted(6, 0, -6, 0), Qt::AlignVCenter | Qt::AlignLeft,
+                       fm.elidedText(txt, Qt::ElideRight, r.width() - 12));
+        }
+        if (shown < entries.size()) {
+            const QRect r(cell.left() + 6, top + shown * (kChipH + kChipGap), cell.width() - 12, kChipH);
+            p.setPen(t.header);
+            p.drawText(r, Qt::AlignVCenter | Qt::AlignLeft,
+                       QString("+%1 more").arg(entries.size() - shown));
+        }
+    }
+    p.restore();
+}
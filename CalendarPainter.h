@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QColor>
+#include <QDate>
+#include <QFont>
+#include <QPainter>
+#include <QRect>
+#include <QStringList>
+#include <QVector>
+
+#include "CalendarLayers.h"   // DayCell
+
+/**
+ * @brief CalendarPainter
+ * Month-cell drawing shared by ModernCalendarWidget and CalendarExporter.
+ *
+ * Everything here is a pure function of its arguments (no widget, no
+ * palette lookups), so the same code paints the on-screen grid on the GUI
+ * thread and offscreen pages (QImage / QPicture) on worker threads.
+ */
+struct CalendarPainter {
+    /// Dots row: at most kMaxDots dots, then a "+N" badge for the rest
+    struct DotsLayout {
+        int   shown = 0;    ///< dots drawn
+        int   left  = 0;    ///< x of the first dot's left edge
+        int   y     = 0;    ///< dot centre line
+        QRect badge;        ///< null when every event has a dot
+    };
+    static constexpr int kMaxDots = 5;
+    static constexpr int kDotR    = 3;
+    static constexpr int kDotGap  = 6;
+
+    /// Theme colours for offscreen pages (the widget reads its palette instead).
+    struct Theme {
+        QColor background, text, dimText, grid, header;
+        static Theme light();
+        static Theme dark();
+    };
+
+    /// Smaller bold variant of @base used for the "+N" badge.
+    static QFont badgeFont(const QFont& base);
+
+    /// Where the dots and badge of a cell with @count events go. Painting and
+    /// hit-testing both use this so the badge is clicked where it is drawn.
+    static DotsLayout dotsLayout(const QRect& cell, int count, const QFont& base);
+
+    /// Day number in the top-left corner, bold.
+    static void drawDayNumber(QPainter& p, const QRect& cell, int day, const QColor& fg);
+
+    /// Dots + "+N" badge for @count events; restores the painter font.
+    static void drawDots(QPainter& p, const QRect& cell, int count, const QFont& base);
+
+    /// Up to two title chips at the bottom of the cell; @colors may be shorter than @titles.
+    static void drawChips(QPainter& p, const QRect& cell,
+                          const QStringList& titles, const QVector<QColor>& colors);
+
+    /**
+     * @brief drawMonthPage
+     * Whole month grid (title, weekday header, 6×7 cells) into @page.
+     * @cells covers the 42 days from @gridStart (CalendarLayers::compose()),
+     * which also fixes the first weekday column.
+     */
+    static void drawMonthPage(QPainter& p, const QRect& page, const QDate& month,
+                              const QDate& gridStart, const QVector<DayCell>& cells,
+                              const Theme& t);
+
+    /// One day of a week page: every visible event, already in start order.
+    struct WeekDay {
+        struct Entry { QString time; QString title; QColor color; };
+        QDate          date;
+        QVector<Entry> entries;
+    };
+
+    /**
+     * @brief drawWeekPage
+     * Seven columns with every event as a "hh:mm title" chip. The tree has
+     * no on-screen week grid, so this reuses the month cell chrome and chip
+     * style with taller cells.
+     */
+    static void drawWeekPage(QPainter& p, const QRect& page, const QVector<WeekDay>& days,
+                             const Theme& t);
+};
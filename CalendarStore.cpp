@@ -0,0 +1,544 @@
+#include "CalendarStore.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <algorithm>  // std::sort
+
+#include "SuperAI.h"
+#include "PlannerRecorder.h"
+#include "PlannerWeights.h"
+#include "ClockService.h"
+#include "TimeTracker.h"
+#include "SyncEngine.h"
+#include "JobScheduler.h"
+
+CalendarStore::CalendarStore(QObject* parent) : QObject(parent)
+{
+    const QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dataDir);
+
+    // One set of worker threads for all windows' background work (0 = one per core)
+    m_jobs = new JobScheduler(QSettings().value("jobs/threads", 0).toInt(), this);
+
+    // Personal calendar is layer 0; imported overlays follow.
+    m_layers.attach("Personal", QColor(140, 70, 255), &m_events, &m_index);
+
+    // Past months live in compressed segments; the ones on screen fill this layer.
+    m_archive.open(QDir(dataDir).filePath("archive"));
+    m_archiveSlot = m_layers.add("Archive", QColor("#9aa3ab"), {}, /*readOnly*/true);
+    {
+        QSettings s;
+        const int n = s.beginReadArray("layers");
+        for (int i = 0; i < n; ++i) {
+            s.setArrayIndex(i);
+            importLayer(s.value("path").toString(), s.value("visible", true).toBool());
+        }
+        s.endArray();
+    }
+    m_hiddenCategories = QSettings().value("calendar/hiddenCategories").toStringList();
+    m_hideOther        = QSettings().value("calendar/hideOtherCategories", false).toBool();
+    applyCategoryFilter();
+
+    m_superAI = new SuperAI(this);
+    setPlannerRecording(QSettings().value("planner/record", false).toBool());
+    loadPlannerWeights();
+
+    // Deadline feasibility follows both the pool and the calendar
+    m_deadlines = std::make_unique<DeadlineChecker>(m_superAI);
+    m_deadlines->setEvents(m_events, m_index);
+    connect(m_superAI, &SuperAI::tasksChanged, this, [this] {
+        m_deadlines->setTasks(m_superAI->tasks());
+        checkDeadlines();
+    });
+    loadTasks();
+    loadHabits();
+
+    // Time-driven work (midnight rollover, event starts/ends, reminders): one timer for all windows
+    m_clock = new ClockService(this);
+    m_clock->setReminderLead(QSettings().value("reminders/leadMin", 10).toInt());
+    m_clock->setEvents(m_events);
+    connect(m_clock, &ClockService::dayChanged, this, [this](const QDate&) {
+        archiveOldEvents();
+        checkDeadlines();   // a day of free time is gone
+    });
+
+    // Timers don't run during suspend; catch up when the app comes back
+    connect(qApp, &QGuiApplication::applicationStateChanged, this, [this](Qt::ApplicationState st) {
+        if (st == Qt::ApplicationActive) m_clock->resync();
+    });
+
+    m_tracker = new TimeTracker(this);
+    m_tracker->open(QDir(dataDir).filePath("tracking.etrk"));   // may resume a running session
+
+    // Optional folder sync (configured from Settings).
+    setupSync(QSettings().value("sync/folder").toString());
+    archiveOldEvents();
+}
+
+CalendarStore::~CalendarStore() = default;
+
+/**
+ * @brief Re-index m_events (per-day rows + hover cache, columns, clock) and
+ *        publish any recorded sync changes as one delta file, then notify views.
+ */
+void CalendarStore::commit()
+{
+    m_index.rebuild(m_events);
+    m_columns.rebuild(m_events);
+    if (m_clock) m_clock->setEvents(m_events);
+    if (m_sync) m_sync->publish();
+    recordCommittedPlans();
+    // Verdict first: views redraw once, on eventsChanged, with both in step
+    checkDeadlines();
+    emit eventsChanged();
+}
+
+/**
+ * @brief Re-run the deadline check; only days whose events changed get new
+ *        free windows. Views hear about it only when the verdict moved.
+ */
+void CalendarStore::checkDeadlines()
+{
+    if (!m_deadlines) return;
+    const auto  before = m_deadlines->result().atRisk;
+    const auto& after  = m_deadlines->check(m_superAI->now()).atRisk;
+
+    bool same = before.size() == after.size();
+    for (int i = 0; same && i < after.size(); ++i)
+        same = before[i].title == after[i].title && before[i].shortMin == after[i].shortMin;
+    if (!same) emit deadlinesChanged();
+}
+
+
+// =====================================================
+// ============ Task / habit pools =====================
+// =====================================================
+
+static QJsonObject taskToJson(const SuperAI::Task& t)
+{
+    QJsonObject o;
+    o["id"]       = t.id;
+    o["title"]    = t.title;
+    o["estimate"] = t.estimateMin;
+    o["priority"] = t.priority;
+    if (t.deadline.isValid()) o["deadline"] = t.deadline.toString(Qt::ISODate);
+    o["morning"]   = t.mustMorning;
+    o["afternoon"] = t.mustAfternoon;
+    o["flexible"]  = t.flexible;
+    o["split"]     = t.splitOK;
+    o["maxChunk"]  = t.maxChunkMin;
+    if (!t.notes.isEmpty()) o["notes"] = t.notes;
+    return o;
+}
+
+static SuperAI::Task taskFromJson(const QJsonObject& o)
+{
+    SuperAI::Task t;
+    t.id            = o.value("id").toString();
+    t.title         = o.value("title").toString();
+    t.estimateMin   = o.value("estimate").toInt(t.estimateMin);
+    t.priority      = o.value("priority").toInt(t.priority);
+    t.deadline      = QDateTime::fromString(o.value("deadline").toString(), Qt::ISODate);
+    t.mustMorning   = o.value("morning").toBool(t.mustMorning);
+    t.mustAfternoon = o.value("afternoon").toBool(t.mustAfternoon);
+    t.flexible      = o.value("flexible").toBool(t.flexible);
+    t.splitOK       = o.value("split").toBool(t.splitOK);
+    t.maxChunkMin   = o.value("maxChunk").toInt(t.maxChunkMin);
+    t.notes         = o.value("notes").toString();
+    return t;
+}
+
+static QString tasksPath()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("tasks.json");
+}
+
+void CalendarStore::loadTasks()
+{
+    QFile f(tasksPath());
+    if (!f.open(QIODevice::ReadOnly)) return;   // no pool yet
+    QVector<SuperAI::Task> tasks;
+    for (const QJsonValue& v : QJsonDocument::fromJson(f.readAll()).array())
+        tasks.push_back(taskFromJson(v.toObject()));
+    m_superAI->setTasks(tasks);
+}
+
+void CalendarStore::setTasks(const QVector<SuperAI::Task>& tasks)
+{
+    QJsonArray arr;
+    for (const auto& t : tasks) arr.append(taskToJson(t));
+    QSaveFile f(tasksPath());
+    if (f.open(QIODevice::WriteOnly)) {
+        f.write(QJsonDocument(arr).toJson(QJsonDocument::Indented));
+        f.commit();
+    }
+    m_superAI->setTasks(tasks);   // → deadline check (tasksChanged)
+}
+
+static QJsonObject habitToJson(const SuperAI::Habit& h)
+{
+    QJsonObject o;
+    o["title"]       = h.title;
+    o["minutes"]     = h.targetMinPerDay;
+    o["daysPerWeek"] = h.daysPerWeek;
+    o["priority"]    = h.priority;
+    if (!h.anchor.isEmpty()) o["anchor"] = h.anchor;
+    return o;
+}
+
+static SuperAI::Habit habitFromJson(const QJsonObject& o)
+{
+    SuperAI::Habit h;
+    h.title           = o.value("title").toString();
+    h.targetMinPerDay = o.value("minutes").toInt(h.targetMinPerDay);
+    h.daysPerWeek     = o.value("daysPerWeek").toInt(h.daysPerWeek);
+    h.priority        = o.value("priority").toInt(h.priority);
+    h.anchor          = o.value("anchor").toString();
+    return h;
+}
+
+static QString habitsPath()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("habits.json");
+}
+
+void CalendarStore::loadHabits()
+{
+    QFile f(habitsPath());
+    if (!f.open(QIODevice::ReadOnly)) return;   // no pool yet
+    QVector<SuperAI::Habit> habits;
+    for (const QJsonValue& v : QJsonDocument::fromJson(f.readAll()).array())
+        habits.push_back(habitFromJson(v.toObject()));
+    m_superAI->setHabits(habits);
+}
+
+void CalendarStore::setHabits(const QVector<SuperAI::Habit>& habits)
+{
+    QJsonArray arr;
+    for (const auto& h : habits) arr.append(habitToJson(h));
+    QSaveFile f(habitsPath());
+    if (f.open(QIODevice::WriteOnly)) {
+        f.write(QJsonDocument(arr).toJson(QJsonDocument::Indented));
+        f.commit();
+    }
+    m_superAI->setHabits(habits);
+}
+
+
+// =====================================================
+// ============ Calendar layers ========================
+// =====================================================
+
+/**
+ * @brief Import a JSON array of Event::toJson() objects as a read-only overlay.
+ */
+bool CalendarStore::importLayer(const QString& path, bool visible)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+    const QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
+
+    QJsonArray arr = doc.isArray() ? doc.array() : doc.object().value("events").toArray();
+    QString name   = doc.isObject() ? doc.object().value("name").toString() : QString();
+    if (name.isEmpty()) name = QFileInfo(path).completeBaseName();
+
+    QVector<Event> evs; evs.reserve(arr.size());
+    for (const QJsonValue& v : arr) evs.push_back(Event::fromJson(v.toObject()));
+
+    static const QColor kLayerColors[] = {
+        QColor("#0ea5e9"), QColor("#f97316"), QColor("#14b8a6"), QColor("#e11d48"), QColor("#84cc16")
+    };
+    const QColor col = kLayerColors[(m_layers.size() - 1) % 5];
+
+    const int slot = m_layers.add(name, col, evs, /*readOnly*/true, path);
+    m_layers.setVisible(slot, visible);
+    emit layersChanged();
+    return true;
+}
+
+void CalendarStore::setLayerVisible(int slot, bool on)
+{
+    m_layers.setVisible(slot, on);
+    saveLayerSettings();
+    emit layersChanged();
+}
+
+/**
+ * @brief Category filter shared by every view. Toggling it only changes the
+ *        layers' mask; views recompose from the per-day category counts.
+ */
+void CalendarStore::setCategoryVisible(const QString& category, bool on)
+{
+    const QString key = category.trimmed().toLower();
+    if (on == !m_hiddenCategories.contains(key)) return;
+    if (on) m_hiddenCategories.removeAll(key);
+    else    m_hiddenCategories << key;
+    QSettings().setValue("calendar/hiddenCategories", m_hiddenCategories);
+    applyCategoryFilter();
+    emit layersChanged();
+}
+
+bool CalendarStore::isCategoryVisible(const QString& category) const
+{
+    return !m_hiddenCategories.contains(category.trimmed().toLower());
+}
+
+void CalendarStore::setOtherCategoriesVisible(bool on)
+{
+    if (on == !m_hideOther) return;
+    m_hideOther = !on;
+    QSettings().setValue("calendar/hideOtherCategories", m_hideOther);
+    applyCategoryFilter();
+    emit layersChanged();
+}
+
+void CalendarStore::showAllCategories()
+{
+    if (m_hiddenCategories.isEmpty() && !m_hideOther) return;
+    m_hiddenCategories.clear();
+    m_hideOther = false;
+    QSettings().remove("calendar/hiddenCategories");
+    QSettings().remove("calendar/hideOtherCategories");
+    applyCategoryFilter();
+    emit layersChanged();
+}
+
+int CalendarStore::hiddenCategoryCount() const
+{
+    // Saved names this run has not met (or that landed in the shared bit)
+    // hide nothing, so they are not counted.
+    int n = m_hideOther ? 1 : 0;
+    for (const QString& c : m_hiddenCategories) {
+        const int bit = EventIndex::findCategoryBit(c);
+        if (bit >= 0 && bit != EventIndex::kOtherBit) ++n;
+    }
+    return n;
+}
+
+/**
+ * @brief Hand the hidden names to the layers; they resolve bits lazily so
+ *        saved names never register categories that no calendar has.
+ */
+void CalendarStore::applyCategoryFilter()
+{
+    m_layers.setHiddenCategories(m_hiddenCategories, m_hideOther);
+}
+
+/**
+ * @brief Remember imported layers (path + visibility) across runs.
+ */
+void CalendarStore::saveLayerSettings() const
+{
+    QSettings s;
+    s.beginWriteArray("layers");
+    for (int i = 1, n = 0; i < m_layers.size(); ++i) {
+        if (m_layers.at(i).source.isEmpty()) continue;   // built-in (archive)
+        s.setArrayIndex(n++);
+        s.setValue("path",    m_layers.at(i).source);
+        s.setValue("visible", m_layers.at(i).visible);
+    }
+    s.endArray();
+}
+
+/**
+ * @brief A view shows [gridStart, gridStart + days). Archived months only get
+ *        decompressed when some view has them on screen.
+ */
+void CalendarStore::requestArchive(QObject* view, const QDate& gridStart, int days)
+{
+    if (!view) return;
+    if (!m_archiveViews.contains(view))
+        connect(view, &QObject::destroyed, this, [this, view] { releaseArchive(view); });
+    m_archiveViews.insert(view, { gridStart, gridStart.addDays(days - 1) });
+    reloadArchive();
+}
+
+void CalendarStore::releaseArchive(QObject* view)
+{
+    if (m_archiveViews.remove(view)) reloadArchive();
+}
+
+void CalendarStore::reloadArchive()
+{
+    if (m_archiveSlot < 0) return;
+
+    // Only the months some view shows: two windows years apart must not
+    // decompress (and cycle the LRU through) every month in between
+    QList<int> months;
+    for (const auto& r : std::as_const(m_archiveViews))
+        for (QDate d(r.first.year(), r.first.month(), 1); d <= r.second; d = d.addMonths(1)) {
+            const int key = ArchiveStore::monthKey(d);
+            if (m_archive.covers(d) && !months.contains(key)) months << key;
+        }
+    std::sort(months.begin(), months.end());
+    if (months == m_archiveMonths) return;
+
+    m_archiveMonths = months;
+    m_layers.setEvents(m_archiveSlot, m_archive.eventsInMonths(months));
+    emit archiveChanged();
+}
+
+/**
+ * @brief Move events older than the configured cutoff (QSettings "archive/cutoffMonths",
+ *        default 12, 0 = off) into the archive. Whole months go at once.
+ */
+void CalendarStore::archiveOldEvents()
+{
+    const int months = QSettings().value("archive/cutoffMonths", 12).toInt();
+    if (months <= 0 || !m_archive.isOpen()) return;
+
+    const QDate c = QDate::currentDate().addMonths(-months);
+    if (m_archive.archiveBefore(m_events, QDate(c.year(), c.month(), 1)) == 0) return;
+
+    m_archiveMonths.clear();   // segments changed; reload what's on screen
+    reloadArchive();
+    commit();
+}
+
+
+// =====================================================
+// ============ Folder sync ============================
+// =====================================================
+
+/**
+ * @brief (Re)connect delta sync to @dir. Each installation gets a stable node id
+ *        stored in QSettings; sync state lives in the app data directory.
+ */
+void CalendarStore::setupSync(const QString& dir)
+{
+    delete m_syncWatcher; m_syncWatcher = nullptr;
+    delete m_sync;        m_sync = nullptr;
+    if (dir.isEmpty()) return;
+
+    QSettings s;
+    QString node = s.value("sync/nodeId").toString();
+    if (node.isEmpty()) {
+        node = Event::newUid();
+        s.setValue("sync/nodeId", node);
+    }
+
+    const QString stateDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    m_sync = new SyncEngine(node, dir, QDir(stateDir).filePath("sync-state.json"), this);
+
+    // Events aren't persisted locally yet, so an empty calendar is rebuilt from the
+    // shared folder; otherwise any event the engine hasn't seen joins the next delta.
+    if (m_events.isEmpty()) {
+        m_sync->resetReplica();
+    } else {
+        for (auto& e : m_events) {
+            e.ensureUid();
+            if (!m_sync->knows(e.uid())) m_sync->recordUpsert(e);
+        }
+        m_sync->publish();
+    }
+
+    // Peers drop new delta files into their sub-folders; react to that instead of polling.
+    m_syncWatcher = new QFileSystemWatcher(this);
+    auto watchPeers = [this, dir] {
+        QStringList paths{ dir };
+        for (const QString& sub : QDir(dir).entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+            paths << QDir(dir).filePath(sub);
+        m_syncWatcher->addPaths(paths);   // already-watched paths are ignored
+    };
+    watchPeers();
+    connect(m_syncWatcher, &QFileSystemWatcher::directoryChanged, this, [this, watchPeers]{
+        watchPeers();
+        pullSync();
+    });
+
+    pullSync();
+}
+
+/**
+ * @brief Apply winning remote changes (matched by uid); views redraw from eventsChanged().
+ */
+void CalendarStore::pullSync()
+{
+    if (!m_sync) return;
+    const QVector<SyncEngine::Change> changes = m_sync->pull();
+    if (changes.isEmpty()) return;
+
+    QHash<QString, int> pos;
+    pos.reserve(m_events.size());
+    for (int i = 0; i < m_events.size(); ++i)
+        if (!m_events[i].uid().isEmpty()) pos.insert(m_events[i].uid(), i);
+
+    QVector<bool> dead(m_events.size(), false);
+    for (const auto& c : changes) {
+        const auto it = pos.constFind(c.uid);
+        if (c.deleted) {
+            if (it != pos.constEnd()) dead[*it] = true;
+        } else if (it != pos.constEnd()) {
+            m_events[*it] = c.event;
+            dead[*it] = false;
+        } else {
+            pos.insert(c.uid, m_events.size());
+            m_events.append(c.event);
+            dead.append(false);
+        }
+    }
+    for (int i = m_events.size() - 1; i >= 0; --i)
+        if (dead[i]) m_events.removeAt(i);
+
+    commit();
+}
+
+
+// =====================================================
+// ============ Planner ================================
+// =====================================================
+
+/**
+ * @brief Start/stop appending SuperAI::planDay() sessions to
+ *        <AppData>/planner-sessions.eplr (replay with edusync_planner_replay).
+ */
+void CalendarStore::setPlannerRecording(bool on)
+{
+    if (m_superAI) m_superAI->setRecorder(nullptr);
+    m_plannerRec.reset();
+    if (!on) return;
+
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dir);
+    m_plannerRec = std::make_unique<PlannerRecorder>(QDir(dir).filePath("planner-sessions.eplr"));
+    if (!m_plannerRec->isOpen()) { m_plannerRec.reset(); return; }
+    if (m_superAI) m_superAI->setRecorder(m_plannerRec.get());
+}
+
+/**
+ * @brief For every day planned while recording, log the planner blocks now in
+ *        the calendar (the recorder skips days whose blocks did not change).
+ *        These are what edusync_planner_tune scores candidate weights against.
+ */
+void CalendarStore::recordCommittedPlans()
+{
+    if (!m_plannerRec) return;
+    for (const QDate& d : m_plannerRec->plannedDays()) {
+        QVector<Event> blocks;
+        for (int row : m_index.rowsOn(d))
+            if (PlannerRecorder::isPlannerBlock(m_events[row])) blocks.push_back(m_events[row]);
+        m_plannerRec->recordCommitted(d, blocks);
+    }
+}
+
+/**
+ * @brief Apply a tuned scoring profile (<AppData>/planner-weights.ini, written
+ *        by edusync_planner_tune) if one exists; otherwise keep the defaults.
+ */
+void CalendarStore::loadPlannerWeights()
+{
+    if (!m_superAI) return;
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    bool ok = false;
+    const PlannerWeights w = PlannerWeights::load(QDir(dir).filePath("planner-weights.ini"), &ok);
+    if (ok) m_superAI->setWeights(w);
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QPair>
+#include <QPointer>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+
+#include "Event.h"
+#include "EventIndex.h"       // per-day index + hover cache
+#include "EventColumns.h"     // columnar snapshot for analytics
+#include "CalendarLayers.h"   // overlays composed into per-day cells
+#include "ArchiveStore.h"     // compressed month segments for past events
+#include "DeadlineChecker.h"  // can the task pool still make its deadlines?
+
+class SuperAI;
+class PlannerRecorder;
+class ClockService;
+class TimeTracker;
+class SyncEngine;
+class JobScheduler;
+class QFileSystemWatcher;
+
+/**
+ * @brief CalendarStore
+ * Application-level model shared by every UltraMainWindow: the personal
+ * events with their per-day index and columnar snapshot, the layer stack
+ * (imports + archive), the planner, the clock, the time tracker, sync and
+ * the background job scheduler.
+ *
+ * Windows are views. They edit events() and call commit(); the index,
+ * columns, clock and sync delta are rebuilt once, then eventsChanged()
+ * tells every window (including the one that edited) to redraw. Opening a
+ * second window adds widgets, not another copy of the data or its caches.
+ *
+ * Notes
+ *  - The archive layer holds the union of the months any view has on
+ *    screen (requestArchive() per view; dropped when the view goes away).
+ *  - SuperAI answers synchronously, so plannerFor(view) remembers who asked
+ *    and views ignore replies meant for another window.
+ */
+class CalendarStore : public QObject {
+    Q_OBJECT
+public:
+    explicit CalendarStore(QObject* parent = nullptr);
+    ~CalendarStore() override;
+
+    // ---- model --------------------------------------------------------------
+    QVector<Event>&       events()        { return m_events; }
+    const QVector<Event>& events()  const { return m_events; }
+    const EventIndex&     index()   const { return m_index; }
+    const EventColumns&   columns() const { return m_columns; }
+    CalendarLayers&       layers()        { return m_layers; }
+    const CalendarLayers& layers()  const { return m_layers; }
+    const ArchiveStore&   archive() const { return m_archive; }
+
+    /// Re-index events() and publish recorded sync changes. Call after every mutation.
+    void commit();
+
+    // ---- services -----------------------------------------------------------
+    SuperAI*         planner() const { return m_superAI; }
+    SuperAI*         plannerFor(QObject* view) { m_plannerView = view; return m_superAI; }
+    const QObject*   plannerView() const { return m_plannerView; }
+    ClockService*    clock()   const { return m_clock; }
+    TimeTracker*     tracker() const { return m_tracker; }
+    SyncEngine*      sync()    const { return m_sync; }
+    PlannerRecorder* plannerRecorder() const { return m_plannerRec.get(); }
+    JobScheduler*    jobs()    const { return m_jobs; }
+
+    /// Latest deadline check of the planner's task pool (re-run on every commit / pool change).
+    const DeadlineChecker::Result& deadlines() const { return m_deadlines->result(); }
+
+    // ---- task / habit pools --------------------------------------------------
+    /// Replace the planner's task pool and save it to <AppData>/tasks.json.
+    void setTasks(const QVector<SuperAI::Task>& tasks);
+    /// Replace the planner's habit pool and save it to <AppData>/habits.json.
+    void setHabits(const QVector<SuperAI::Habit>& habits);
+
+    // ---- layers / archive ---------------------------------------------------
+    bool importLayer(const QString& path, bool visible = true);
+    void setLayerVisible(int slot, bool on);
+    void saveLayerSettings() const;
+    void requestArchive(QObject* view, const QDate& gridStart, int days);
+    void releaseArchive(QObject* view);
+    void archiveOldEvents();
+
+    // ---- category filter ----------------------------------------------------
+    /// Show or hide @category (case-insensitive) in every view; remembered across runs.
+    void setCategoryVisible(const QString& category, bool on);
+    bool isCategoryVisible(const QString& category) const;
+    /// Show or hide every category sharing EventIndex::kOtherBit at once.
+    void setOtherCategoriesVisible(bool on);
+    bool otherCategoriesVisible() const { return !m_hideOther; }
+    void showAllCategories();
+    /// Hidden categories this run has met (the "Other" group counts as one).
+    int  hiddenCategoryCount() const;
+
+    // ---- configuration ------------------------------------------------------
+    void setupSync(const QString& dir);
+    void pullSync();
+    void setPlannerRecording(bool on);
+    void loadPlannerWeights();
+
+signals:
+    void eventsChanged();    // events() changed and was re-indexed
+    void layersChanged();    // a layer was toggled or imported, or the category filter changed
+    void archiveChanged();   // the archive layer now holds other months
+    void deadlinesChanged(); // the set of at-risk tasks (or their shortfall) changed
+
+private:
+    void reloadArchive();
+    void checkDeadlines();
+    void loadTasks();
+    void loadHabits();
+    void applyCategoryFilter();
+    void recordCommittedPlans();
+
+    QVector<Event>  m_events;
+    EventIndex      m_index;          // per-day rows + memoised hover text over m_events
+    EventColumns    m_columns;        // columnar snapshot of m_events for analytics
+    CalendarLayers  m_layers;         // slot 0 = m_events; read-only overlays after it
+    ArchiveStore    m_archive;        // compressed month segments for old events
+    int             m_archiveSlot = -1;   // read-only layer holding the archived months on screen
+    QList<int>      m_archiveMonths;      // month keys currently loaded into that layer
+    QHash<QObject*, QPair<QDate, QDate>> m_archiveViews;   // grid range per view
+    QStringList     m_hiddenCategories;   // lower-case names; bits are per run, names persist
+    bool            m_hideOther = false;  // categories sharing EventIndex::kOtherBit
+
+    SuperAI*          m_superAI = nullptr;
+    QPointer<QObject> m_plannerView;                 // view that issued the last planner request
+    std::unique_ptr<PlannerRecorder> m_plannerRec;   // set while planner sessions are recorded
+    std::unique_ptr<DeadlineChecker> m_deadlines;    // EDF check of the task pool over m_index's free windows
+    ClockService*     m_clock   = nullptr;           // single timer for midnight / event boundaries / reminders
+    TimeTracker*      m_tracker = nullptr;           // start/stop sessions → <AppData>/tracking.etrk
+    SyncEngine*       m_sync    = nullptr;           // null unless a sync folder is configured
+    JobScheduler*     m_jobs    = nullptr;           // worker threads shared by exports, forecasts, ...
+    QFileSystemWatcher* m_syncWatcher = nullptr;
+};
@@ -0,0 +1,89 @@
+#include "ClockService.h"
+
+#include <algorithm>  // std::sort, std::min
+
+ClockService::ClockService(QObject* parent) : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);   // one long wait; coarse timers may drift by minutes
+    connect(&m_timer, &QTimer::timeout, this, &ClockService::fire);
+    m_today = now().date();
+    arm();
+}
+
+void ClockService::setEvents(const QVector<Event>& events)
+{
+    m_events = events;
+    rebuild();
+    arm();
+}
+
+void ClockService::setReminderLead(int minutes)
+{
+    if (minutes == m_leadMin) return;
+    m_leadMin = minutes;
+    rebuild();
+    arm();
+}
+
+void ClockService::rebuild()
+{
+    const qint64 nowMs  = now().toMSecsSinceEpoch();
+    const qint64 leadMs = qint64(m_leadMin) * 60 * 1000;
+
+    m_instants.clear();
+    for (int i = 0; i < m_events.size(); ++i) {
+        const qint64 s = m_events[i].getStartTime().toMSecsSinceEpoch();
+        const qint64 e = m_events[i].getEndTime().toMSecsSinceEpoch();
+        if (m_leadMin > 0 && s - leadMs > nowMs) m_instants.push_back({ s - leadMs, Kind::Reminder, i });
+        if (s > nowMs)                           m_instants.push_back({ s, Kind::Start, i });
+        if (e > nowMs)                           m_instants.push_back({ e, Kind::End, i });
+    }
+    std::sort(m_instants.begin(), m_instants.end(), [](const Instant& a, const Instant& b){
+        return a.ms != b.ms ? a.ms < b.ms : a.kind < b.kind;
+    });
+    m_next = 0;
+}
+
+void ClockService::resync()
+{
+    fire();
+}
+
+/**
+ * @brief fire
+ * Emit the day change (if any) and every instant that is due, then re-arm.
+ */
+void ClockService::fire()
+{
+    const QDateTime t   = now();
+    const qint64    ms  = t.toMSecsSinceEpoch();
+
+    if (t.date() != m_today) {
+        m_today = t.date();
+        emit dayChanged(m_today);
+    }
+
+    while (m_next < m_instants.size() && m_instants[m_next].ms <= ms) {
+        const Instant in = m_instants[m_next++];
+        if (ms - in.ms > kLateMs) continue;   // slept through it
+        const Event e = m_events[in.row];   // handlers may call setEvents()
+        switch (in.kind) {
+        case Kind::Reminder: emit reminderDue(e, m_leadMin); break;
+        case Kind::Start:    emit eventStarted(e);           break;
+        case Kind::End:      emit eventEnded(e);             break;
+        }
+    }
+    arm();
+}
+
+void ClockService::arm()
+{
+    const QDateTime t = now();
+    QDateTime wake = t.date().addDays(1).startOfDay();   // midnight rollover
+    if (m_next < m_instants.size())
+        wake = std::min(wake, QDateTime::fromMSecsSinceEpoch(m_instants[m_next].ms));
+
+    m_wake = wake;
+    m_timer.start(int(std::clamp<qint64>(t.msecsTo(wake), 0, 24 * 3600 * 1000)));
+}
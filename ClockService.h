@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <functional>
+
+#include "Event.h"
+
+/**
+ * @brief ClockService
+ * One timer for everything time-driven in the UI.
+ *
+ * The service knows the upcoming instants that matter (local midnight, event
+ * starts/ends, reminders ahead of starts) and arms a single-shot timer for
+ * the earliest one. When it fires, due instants become typed signals and the
+ * timer is re-armed for the next instant; nothing wakes up in between.
+ *
+ * Notes
+ *  - setEvents() must follow every change of the event vector (the vector
+ *    is shared, not copied).
+ *  - Instants that went by more than kLateMs ago (sleep/suspend, clock
+ *    jump) are dropped instead of replayed; dayChanged() is still emitted.
+ *  - resync() re-reads the clock, e.g. when the app becomes active again.
+ */
+class ClockService : public QObject {
+    Q_OBJECT
+public:
+    explicit ClockService(QObject* parent = nullptr);
+
+    /// Future starts/ends/reminders of @events (call after each mutation).
+    void setEvents(const QVector<Event>& events);
+
+    /// Minutes before a start at which reminderDue() fires; <= 0 disables reminders.
+    void setReminderLead(int minutes);
+    int  reminderLead() const { return m_leadMin; }
+
+    /// Clock override (tests/replay); null = wall clock.
+    void setClock(std::function<QDateTime()> now) { m_now = std::move(now); resync(); }
+
+    QDate     today()    const { return m_today; }
+    QDateTime nextWake() const { return m_wake; }
+
+    /// Re-read the clock, emit anything due and re-arm.
+    void resync();
+
+signals:
+    void dayChanged(const QDate& today);
+    void eventStarted(const Event& e);
+    void eventEnded(const Event& e);
+    void reminderDue(const Event& e, int minutesBefore);
+
+private:
+    enum class Kind : quint8 { End, Reminder, Start };   // order for equal times
+    struct Instant { qint64 ms; Kind kind; int row; };
+
+    static constexpr qint64 kLateMs = 60 * 1000;
+
+    QDateTime now() const { return m_now ? m_now() : QDateTime::currentDateTime(); }
+    void rebuild();
+    void fire();
+    void arm();
+
+    QTimer           m_timer;
+    std::function<QDateTime()> m_now;
+    QVector<Event>   m_events;     ///< implicitly shared with the owner's vector
+    QVector<Instant> m_instants;   ///< future instants, sorted by time
+    int              m_next = 0;   ///< first instant not yet emitted
+    int              m_leadMin = 10;
+    QDate            m_today;
+    QDateTime        m_wake;
+};
@@ -0,0 +1,210 @@
+#include "ColumnKernels.h"
+
+#include <algorithm>  // std::max, std::min
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define EDUSYNC_X86_SIMD 1
+#  include <immintrin.h>
+#  define EDUSYNC_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+static constexpr int64_t kDaySecs = 86400;
+
+// Floor division (times before base must land on negative days)
+static inline int64_t floorDiv(int64_t x, int64_t d) {
+    const int64_t q = x / d;
+    return (x % d != 0 && (x < 0) != (d < 0)) ? q - 1 : q;
+}
+
+
+// ============================================================================
+// Scalar
+// ============================================================================
+
+static size_t overlappingScalar(const int64_t* s, const int64_t* e, size_t n,
+                                int64_t a, int64_t b, uint32_t* out)
+{
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (s[i] < b && e[i] > a) out[k++] = uint32_t(i);
+    return k;
+}
+
+static void perCategoryScalar(const int64_t* s, const int64_t* e, const uint8_t* cat, size_t n,
+                              int64_t a, int64_t b, int64_t* out, size_t ncat)
+{
+    for (size_t i = 0; i < n; ++i) {
+        const int64_t d = std::min(e[i], b) - std::max(s[i], a);
+        if (d > 0 && cat[i] < ncat) out[cat[i]] += d;
+    }
+}
+
+
+// ============================================================================
+// SSE4.2 / AVX2
+// ============================================================================
+
+#ifdef EDUSYNC_X86_SIMD
+
+EDUSYNC_TARGET("sse4.2")
+static size_t overlappingSse42(const int64_t* s, const int64_t* e, size_t n,
+                               int64_t a, int64_t b, uint32_t* out)
+{
+    const __m128i av = _mm_set1_epi64x(a);
+    const __m128i bv = _mm_set1_epi64x(b);
+    size_t i = 0, k = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128i sv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        const __m128i ev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(e + i));
+        const __m128i m  = _mm_and_si128(_mm_cmpgt_epi64(bv, sv), _mm_cmpgt_epi64(ev, av));
+        int bits = _mm_movemask_pd(_mm_castsi128_pd(m));
+        while (bits) { out[k++] = uint32_t(i + __builtin_ctz(bits)); bits &= bits - 1; }
+    }
+    for (; i < n; ++i) if (s[i] < b && e[i] > a) out[k++] = uint32_t(i);
+    return k;
+}
+
+EDUSYNC_TARGET("avx2")
+static size_t overlappingAvx2(const int64_t* s, const int64_t* e, size_t n,
+                              int64_t a, int64_t b, uint32_t* out)
+{
+    const __m256i av = _mm256_set1_epi64x(a);
+    const __m256i bv = _mm256_set1_epi64x(b);
+    size_t i = 0, k = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i sv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        const __m256i ev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(e + i));
+        const __m256i m  = _mm256_and_si256(_mm256_cmpgt_epi64(bv, sv), _mm256_cmpgt_epi64(ev, av));
+        int bits = _mm256_movemask_pd(_mm256_castsi256_pd(m));
+        while (bits) { out[k++] = uint32_t(i + __builtin_ctz(bits)); bits &= bits - 1; }
+    }
+    for (; i < n; ++i) if (s[i] < b && e[i] > a) out[k++] = uint32_t(i);
+    return k;
+}
+
+EDUSYNC_TARGET("sse4.2")
+static void perCategorySse42(const int64_t* s, const int64_t* e, const uint8_t* cat, size_t n,
+                             int64_t a, int64_t b, int64_t* out, size_t ncat)
+{
+    const __m128i av = _mm_set1_epi64x(a);
+    const __m128i bv = _mm_set1_epi64x(b);
+    const __m128i zero = _mm_setzero_si128();
+    alignas(16) int64_t d[2];
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128i sv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        const __m128i ev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(e + i));
+        const __m128i lo = _mm_blendv_epi8(sv, av, _mm_cmpgt_epi64(av, sv));   // max(s, a)
+        const __m128i hi = _mm_blendv_epi8(ev, bv, _mm_cmpgt_epi64(ev, bv));   // min(e, b)
+        __m128i dv = _mm_sub_epi64(hi, lo);
+        dv = _mm_blendv_epi8(dv, zero, _mm_cmpgt_epi64(zero, dv));            // max(d, 0)
+        _mm_store_si128(reinterpret_cast<__m128i*>(d), dv);
+        if (cat[i]     < ncat) out[cat[i]]     += d[0];
+        if (cat[i + 1] < ncat) out[cat[i + 1]] += d[1];
+    }
+    perCategoryScalar(s + i, e + i, cat + i, n - i, a, b, out, ncat);
+}
+
+EDUSYNC_TARGET("avx2")
+static void perCategoryAvx2(const int64_t* s, const int64_t* e, const uint8_t* cat, size_t n,
+                            int64_t a, int64_t b, int64_t* out, size_t ncat)
+{
+    const __m256i av = _mm256_set1_epi64x(a);
+    const __m256i bv = _mm256_set1_epi64x(b);
+    const __m256i zero = _mm256_setzero_si256();
+    alignas(32) int64_t d[4];
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i sv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        const __m256i ev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(e + i));
+        const __m256i lo = _mm256_blendv_epi8(sv, av, _mm256_cmpgt_epi64(av, sv));
+        const __m256i hi = _mm256_blendv_epi8(ev, bv, _mm256_cmpgt_epi64(ev, bv));
+        __m256i dv = _mm256_sub_epi64(hi, lo);
+        dv = _mm256_blendv_epi8(dv, zero, _mm256_cmpgt_epi64(zero, dv));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d), dv);
+        for (int l = 0; l < 4; ++l)
+            if (cat[i + l] < ncat) out[cat[i + l]] += d[l];
+    }
+    perCategoryScalar(s + i, e + i, cat + i, n - i, a, b, out, ncat);
+}
+
+#endif // EDUSYNC_X86_SIMD
+
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+ColumnKernels::Isa ColumnKernels::bestIsa()
+{
+#ifdef EDUSYNC_X86_SIMD
+    static const Isa best = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))   return Isa::Avx2;
+        if (__builtin_cpu_supports("sse4.2")) return Isa::Sse42;
+        return Isa::Scalar;
+    }();
+    return best;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+const char* ColumnKernels::isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Avx2:  return "avx2";
+    case Isa::Sse42: return "sse4.2";
+    default:         return "scalar";
+    }
+}
+
+size_t ColumnKernels::overlapping(const int64_t* start, const int64_t* end, size_t n,
+                                  int64_t a, int64_t b, uint32_t* out, Isa isa)
+{
+#ifdef EDUSYNC_X86_SIMD
+    if (isa == Isa::Avx2)  return overlappingAvx2(start, end, n, a, b, out);
+    if (isa == Isa::Sse42) return overlappingSse42(start, end, n, a, b, out);
+#endif
+    (void)isa;
+    return overlappingScalar(start, end, n, a, b, out);
+}
+
+void ColumnKernels::secondsPerCategory(const int64_t* start, const int64_t* end, const uint8_t* cat,
+                                       size_t n, int64_t a, int64_t b,
+                                       int64_t* out, size_t ncat, Isa isa)
+{
+#ifdef EDUSYNC_X86_SIMD
+    if (isa == Isa::Avx2)  { perCategoryAvx2(start, end, cat, n, a, b, out, ncat);  return; }
+    if (isa == Isa::Sse42) { perCategorySse42(start, end, cat, n, a, b, out, ncat); return; }
+#endif
+    (void)isa;
+    perCategoryScalar(start, end, cat, n, a, b, out, ncat);
+}
+
+void ColumnKernels::countPerDay(const int64_t* start, const int64_t* end, size_t n,
+                                int64_t base, int days, int32_t* out, Isa isa)
+{
+    std::fill(out, out + std::max(days, 0), 0);
+    if (days <= 0 || n == 0) return;
+
+    // Vector filter: rows with start < last day's end and end >= base (inclusive
+    // end, as isOnDate) — i.e. overlap with [base - 1, base + days*86400).
+    std::vector<uint32_t> hit(n);
+    const size_t m = overlapping(start, end, n, base - 1, base + int64_t(days) * kDaySecs,
+                                 hit.data(), isa);
+
+    // Scalar bucketing of the survivors through a difference array
+    std::vector<int32_t> diff(size_t(days) + 1, 0);
+    for (size_t k = 0; k < m; ++k) {
+        const uint32_t i = hit[k];
+        const int64_t d0 = std::max<int64_t>(0,        floorDiv(start[i] - base, kDaySecs));
+        const int64_t d1 = std::min<int64_t>(days - 1, floorDiv(end[i]   - base, kDaySecs));
+        if (d0 > d1) continue;
+        ++diff[size_t(d0)];
+        --diff[size_t(d1) + 1];
+    }
+    int32_t run = 0;
+    for (int k = 0; k < days; ++k) { run += diff[size_t(k)]; out[k] = run; }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief ColumnKernels
+ * Range filters and aggregations over contiguous int64 time columns.
+ *
+ * Every kernel has a scalar version plus SSE4.2 (2 lanes) and AVX2 (4 lanes)
+ * versions on x86 GCC/Clang builds, picked at run time from the CPU. All
+ * versions return identical results; the Isa argument exists so benchmarks
+ * and checks can pin one.
+ *
+ * Conventions
+ *  - Times are seconds on a single clock (EventColumns uses local wall time).
+ *  - "Overlap" is half-open: start < b && end > a.
+ */
+struct ColumnKernels {
+    enum class Isa { Scalar, Sse42, Avx2 };
+
+    /// Best instruction set supported by this CPU and build.
+    static Isa bestIsa();
+    static const char* isaName(Isa isa);
+
+    /**
+     * @brief overlapping
+     * Writes the indices of rows overlapping [a, b) to @out (capacity n).
+     * @return number of indices written (ascending)
+     */
+    static size_t overlapping(const int64_t* start, const int64_t* end, size_t n,
+                              int64_t a, int64_t b, uint32_t* out, Isa isa = bestIsa());
+
+    /**
+     * @brief secondsPerCategory
+     * Adds each row's overlap with [a, b) to @out[cat[i]] (@out has @ncat slots;
+     * rows with cat >= ncat are ignored). @out is not cleared.
+     */
+    static void secondsPerCategory(const int64_t* start, const int64_t* end, const uint8_t* cat,
+                                   size_t n, int64_t a, int64_t b,
+                                   int64_t* out, size_t ncat, Isa isa = bestIsa());
+
+    /**
+     * @brief countPerDay
+     * @out[k] = rows touching day k, i.e. [base + k*86400, base + (k+1)*86400),
+     * for k < days. A row touches every day from its start through its end
+     * inclusive (same rule as Event::isOnDate). @out is overwritten.
+     */
+    static void countPerDay(const int64_t* start, const int64_t* end, size_t n,
+                            int64_t base, int days, int32_t* out, Isa isa = bestIsa());
+};
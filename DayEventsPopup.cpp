@@ -0,0 +1,166 @@
+#include "DayEventsPopup.h"
+#include "CalendarLayers.h"
+
+#include <QBrush>
+#include <QGuiApplication>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QListView>
+#include <QPushButton>
+#include <QScreen>
+#include <QVBoxLayout>
+#include <algorithm>  // std::upper_bound, std::clamp
+
+// ============================================================================
+// DayEventsModel
+// ============================================================================
+
+DayEventsModel::DayEventsModel(const CalendarLayers* layers, QObject* parent)
+    : QAbstractListModel(parent), m_layers(layers)
+{
+}
+
+void DayEventsModel::setDay(const QDate& d)
+{
+    beginResetModel();
+    m_day = d;
+    m_slots.clear();
+    m_picked.clear();
+    m_offsets = { 0 };
+    const EventIndex::CategoryMask only = m_layers ? m_layers->categoryFilter() : EventIndex::kAllCategories;
+    for (int s = 0; m_layers && s < m_layers->size(); ++s) {
+        if (!m_layers->isVisible(s)) continue;
+        const EventIndex::DaySummary* sum = m_layers->at(s).index().summaryOn(d);
+        const int n = sum ? sum->countIn(only) : 0;
+        if (!n) continue;
+
+        QVector<int> picked;
+        if (!sum->allIn(only))
+            for (int r = 0; r < sum->rows.size(); ++r)
+                if (sum->rowIn(r, only)) picked << r;
+        m_slots << s;
+        m_picked << picked;
+        m_offsets << m_offsets.last() + n;
+    }
+    endResetModel();
+}
+
+int DayEventsModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_offsets.last();
+}
+
+QPair<int,int> DayEventsModel::keyAt(int row) const
+{
+    const int i = int(std::upper_bound(m_offsets.cbegin(), m_offsets.cend(), row) - m_offsets.cbegin()) - 1;
+    const int k = row - m_offsets[i];
+    return { m_slots[i], m_picked[i].isEmpty() ? k : m_picked[i][k] };
+}
+
+QVariant DayEventsModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) return {};
+    const auto [slot, row] = keyAt(index.row());
+    if (role == SlotRole)     return slot;
+    if (role == RowInDayRole) return row;
+
+    const auto& layer = m_layers->at(slot);
+    const Event& e    = m_layers->eventAt(slot, m_day, row);
+    switch (role) {
+    case Qt::DisplayRole: {
+        QString text = QString("%1–%2   %3").arg(e.getStartTime().toString("hh:mm"),
+                                               e.getEndTime().toString("hh:mm"),
+                                               e.getTitle());
+        if (slot != 0) text += QString("   [%1]").arg(layer.name);
+        return text;
+    }
+    case Qt::DecorationRole: return layer.color;
+    case Qt::ToolTipRole:    return layer.index().itemTooltip(m_day, row);
+    case Qt::ForegroundRole:
+        return layer.readOnly ? QVariant(QBrush(QColor("#9aa3ab"))) : QVariant();
+    default:
+        return {};
+    }
+}
+
+// ============================================================================
+// DayEventsPopup
+// ============================================================================
+
+DayEventsPopup::DayEventsPopup(const CalendarLayers* layers, QWidget* parent)
+    : QFrame(parent, Qt::Popup), m_layers(layers)
+{
+    setFrameShape(QFrame::StyledPanel);
+    setMinimumSize(320, 260);
+    resize(340, 360);
+
+    m_model = new DayEventsModel(layers, this);
+    m_title = new QLabel(this);
+    m_title->setStyleSheet("font-weight:600;");
+
+    m_view = new QListView(this);
+    m_view->setModel(m_model);
+    m_view->setUniformItemSizes(true);   // virtualised: no per-row size pass
+    m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_view->setSelectionMode(QAbstractItemView::SingleSelection);
+
+    m_edit   = new QPushButton("Edit", this);
+    m_delete = new QPushButton("Delete", this);
+    for (auto *b : { m_edit, m_delete }) b->setCursor(Qt::PointingHandCursor);
+
+    auto *btnRow = new QHBoxLayout;
+    btnRow->addStretch(1);
+    btnRow->addWidget(m_edit);
+    btnRow->addWidget(m_delete);
+
+    auto *ly = new QVBoxLayout(this);
+    ly->setContentsMargins(10, 10, 10, 10);
+    ly->addWidget(m_title);
+    ly->addWidget(m_view, 1);
+    ly->addLayout(btnRow);
+
+    connect(m_view->selectionModel(), &QItemSelectionModel::currentChanged, this, [this] { updateButtons(); });
+    connect(m_view, &QListView::doubleClicked, this, [this] { act(/*edit*/true); });
+    connect(m_edit,   &QPushButton::clicked, this, [this] { act(true); });
+    connect(m_delete, &QPushButton::clicked, this, [this] { act(false); });
+}
+
+void DayEventsPopup::showFor(const QDate& d, const QPoint& globalPos)
+{
+    m_model->setDay(d);
+    m_title->setText(QString("%1  ·  %2 events").arg(d.toString("dddd, MMM d")).arg(m_model->rowCount()));
+    if (m_model->rowCount()) m_view->setCurrentIndex(m_model->index(0));
+    updateButtons();
+
+    // Keep the popup on the screen it opens on
+    QPoint at = globalPos;
+    if (const QScreen* sc = QGuiApplication::screenAt(globalPos)) {
+        const QRect g = sc->availableGeometry();
+        at.setX(std::clamp(at.x(), g.left(), g.right()  - width()));
+        at.setY(std::clamp(at.y(), g.top(),  g.bottom() - height()));
+    }
+    move(at);
+    show();
+    m_view->setFocus();
+}
+
+void DayEventsPopup::updateButtons()
+{
+    const QModelIndex cur = m_view->currentIndex();
+    const int slot = cur.isValid() ? cur.data(DayEventsModel::SlotRole).toInt() : -1;
+    const bool editable = slot == 0 && m_layers && !m_layers->at(0).readOnly;   // only the personal layer
+    m_edit->setEnabled(editable);
+    m_delete->setEnabled(editable);
+}
+
+void DayEventsPopup::act(bool edit)
+{
+    const QModelIndex cur = m_view->currentIndex();
+    if (!cur.isValid() || cur.data(DayEventsModel::SlotRole).toInt() != 0) return;
+    const QDate d   = m_model->day();
+    const int   row = cur.data(DayEventsModel::RowInDayRole).toInt();
+
+    hide();   // the edit dialog / series question takes over
+    if (edit) emit editRequested(d, row);
+    else      emit deleteRequested(d, row);
+}
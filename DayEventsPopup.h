@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QDate>
+#include <QFrame>
+#include <QVector>
+
+class CalendarLayers;
+class QLabel;
+class QListView;
+class QPushButton;
+
+/**
+ * @brief DayEventsModel
+ * Every event of one day across the visible layers, for the "+N" popup.
+ *
+ * setDay() only records how many rows each visible layer has on that day
+ * (a lookup in each layer's per-day index), so opening the list costs
+ * O(layers) whatever the day holds. Rows are grouped by layer, each group
+ * already in start order; data() resolves a row through CalendarLayers::eventAt
+ * only when the view paints it. A layer whose day is partly hidden by the
+ * category filter keeps the list of its rows that pass.
+ */
+class DayEventsModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    enum Roles {
+        SlotRole = Qt::UserRole,   ///< layer slot
+        RowInDayRole               ///< row within the day (for CalendarLayers::eventAt)
+    };
+
+    explicit DayEventsModel(const CalendarLayers* layers, QObject* parent = nullptr);
+
+    void  setDay(const QDate& d);
+    QDate day() const { return m_day; }
+
+    int      rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+private:
+    QPair<int,int> keyAt(int row) const;   ///< (slot, row-in-day)
+
+    const CalendarLayers* m_layers = nullptr;
+    QDate        m_day;
+    QVector<int> m_slots;     ///< visible layers with events on m_day
+    QVector<int> m_offsets;   ///< first model row of each m_slots entry, plus the total
+    QVector<QVector<int>> m_picked;   ///< per m_slots entry: rows-in-day shown; empty = all
+};
+
+/**
+ * @brief DayEventsPopup
+ * Popup list of a day's events opened from the calendar's "+N" badge.
+ * The list view uses uniform item sizes, so only visible rows are laid out
+ * and painted. Personal events can be edited or deleted from here.
+ */
+class DayEventsPopup : public QFrame {
+    Q_OBJECT
+public:
+    explicit DayEventsPopup(const CalendarLayers* layers, QWidget* parent = nullptr);
+
+    void showFor(const QDate& d, const QPoint& globalPos);
+
+signals:
+    void editRequested(const QDate& d, int rowInDay);     // personal layer rows only
+    void deleteRequested(const QDate& d, int rowInDay);
+
+private:
+    void updateButtons();
+    void act(bool edit);
+
+    const CalendarLayers* m_layers = nullptr;
+    DayEventsModel* m_model  = nullptr;
+    QListView*      m_view   = nullptr;
+    QLabel*         m_title  = nullptr;
+    QPushButton*    m_edit   = nullptr;
+    QPushButton*    m_delete = nullptr;
+};
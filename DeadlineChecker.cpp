@@ -0,0 +1,132 @@
+#include "DeadlineChecker.h"
+
+#include <QElapsedTimer>
+#include <algorithm>  // std::stable_sort, std::min, std::max
+#include <iterator>   // std::next
+
+static constexpr int    kMinBlockMin = 15;    // same as planDay()
+static constexpr int    kPostBufMin  = 10;    // scheduleTasksIntoWindows() tail buffer per chunk
+static constexpr int    kMaxDays     = 366;   // horizon cap
+static constexpr qint64 kMinMs       = 60 * 1000;
+
+void DeadlineChecker::setTasks(const QVector<SuperAI::Task>& tasks)
+{
+    m_tasks = tasks;
+    m_jobs.clear();
+    for (const auto& t : m_tasks) {
+        if (!t.deadline.isValid() || t.estimateMin <= 0) continue;
+        const int est    = std::max(kMinBlockMin, t.estimateMin);
+        const int chunk  = std::max(kMinBlockMin, t.maxChunkMin);
+        const int chunks = t.splitOK ? (est + chunk - 1) / chunk : 1;
+        m_jobs.push_back({ &t, t.deadline.toMSecsSinceEpoch(),
+                           qint64(est + kPostBufMin * chunks) * kMinMs });
+    }
+    std::stable_sort(m_jobs.begin(), m_jobs.end(),
+                     [](const Job& a, const Job& b){ return a.dueMs < b.dueMs; });
+}
+
+void DeadlineChecker::setEvents(const QVector<Event>& events, const EventIndex& index)
+{
+    m_events = &events;
+    m_index  = &index;
+}
+
+/**
+ * @brief windowsOn
+ * Cached free windows of @d; recomputed only when the day's fingerprint moved.
+ */
+const QVector<DeadlineChecker::Window>& DeadlineChecker::windowsOn(const QDate& d)
+{
+    const size_t fp = m_index ? m_index->fingerprintOn(d) : 0;
+    auto it = m_days.find(d.toJulianDay());
+    if (it != m_days.end() && it->fingerprint == fp) return it->windows;
+
+    QVector<Event> busy;
+    if (m_index && m_events)
+        for (int r : m_index->rowsOn(d)) busy.push_back((*m_events)[r]);
+
+    Day day;
+    day.fingerprint = fp;
+    for (const auto& s : m_planner->freeWindows(d, busy, kMinBlockMin))
+        day.windows.push_back({ s.start.toMSecsSinceEpoch(), s.end.toMSecsSinceEpoch() });
+    ++m_rebuilt;
+    return m_days.insert(d.toJulianDay(), day)->windows;
+}
+
+/**
+ * @brief check
+ * EDF sweep: jobs in deadline order consume the free windows from @now on;
+ * whatever a job gets after its deadline is its shortfall.
+ */
+const DeadlineChecker::Result& DeadlineChecker::check(const QDateTime& now)
+{
+    QElapsedTimer timer; timer.start();
+    m_result  = Result();
+    m_rebuilt = 0;
+    if (!m_planner) return m_result;
+
+    const QDate  today = now.date();
+    const qint64 nowMs = now.toMSecsSinceEpoch() / kMinMs * kMinMs;
+
+    // Days before today can no longer change the answer
+    for (auto it = m_days.begin(); it != m_days.end(); )
+        it = it.key() < today.toJulianDay() ? m_days.erase(it) : std::next(it);
+
+    const int n = m_jobs.size();
+    m_result.tasks = n;
+    if (n == 0) return m_result;
+
+    // Free time in [now, last deadline)
+    const qint64 lastDue = m_jobs.last().dueMs;
+    const QDate  lastDay = std::min(QDateTime::fromMSecsSinceEpoch(lastDue).date(), today.addDays(kMaxDays));
+    QVector<Window> flat;
+    for (QDate d = today; d <= lastDay; d = d.addDays(1))
+        for (const Window& w : windowsOn(d)) {
+            const Window c{ std::max(w.a, nowMs), std::min(w.b, lastDue) };
+            if (c.b - c.a >= kMinBlockMin * kMinMs) flat.push_back(c);
+        }
+
+    // One pass: each job takes window time until its need is met
+    QVector<qint64> before(n, 0), finish(n, -1);
+    int    j    = 0;
+    qint64 left = m_jobs[0].needMs, slack = 0;
+    for (const Window& w : flat) {
+        qint64 pos = w.a;
+        while (pos < w.b && j < n) {
+            const qint64 end = pos + std::min(left, w.b - pos);
+            before[j] += std::max<qint64>(0, std::min(end, m_jobs[j].dueMs) - pos);
+            left -= end - pos;
+            pos   = end;
+            if (left == 0) { finish[j] = end; if (++j < n) left = m_jobs[j].needMs; }
+        }
+        slack += w.b - pos;
+    }
+    m_result.slackMin = int(slack / kMinMs);
+
+    // Unsplittable jobs also need one window that holds the whole block
+    int    p    = 0;
+    qint64 best = 0;
+    for (int k = 0; k < n; ++k) {
+        const Job& job = m_jobs[k];
+        for (; p < flat.size() && flat[p].b <= job.dueMs; ++p) best = std::max(best, flat[p].b - flat[p].a);
+        qint64 fits = best;
+        if (p < flat.size() && flat[p].a < job.dueMs) fits = std::max(fits, job.dueMs - flat[p].a);
+
+        const bool   noWindow = !job.task->splitOK && fits < job.needMs;
+        const qint64 shortMs  = std::max(job.needMs - before[k], noWindow ? job.needMs - fits : 0);
+        if (shortMs <= 0) continue;
+
+        Risk r;
+        r.id       = job.task->id;
+        r.title    = job.task->title;
+        r.deadline = job.task->deadline;
+        r.needMin  = int(job.needMs / kMinMs);
+        r.shortMin = int((shortMs + kMinMs - 1) / kMinMs);
+        r.noWindow = noWindow;
+        if (finish[k] >= 0) r.finish = QDateTime::fromMSecsSinceEpoch(finish[k]);
+        m_result.atRisk.push_back(r);
+    }
+    m_result.feasible  = m_result.atRisk.isEmpty();
+    m_result.elapsedUs = timer.nsecsElapsed() / 1000;
+    return m_result;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "Event.h"
+#include "EventIndex.h"
+#include "SuperAI.h"
+
+/**
+ * @brief DeadlineChecker
+ * Can the task pool still be finished on time? Names the tasks that cannot
+ * and by how many minutes.
+ *
+ * Model
+ *  - Supply: the planner's free windows (SuperAI::freeWindows, 06–22,
+ *    ≥ 15 min) from now until the latest deadline.
+ *  - Demand: each task with a deadline needs max(15, estimate) minutes plus
+ *    the 10-minute post buffer scheduleTasksIntoWindows() adds per chunk.
+ *  - All tasks are available now, so earliest-deadline-first is optimal and
+ *    the pool is feasible iff, for every deadline d, the demand due by d fits
+ *    into the free minutes before d (the max-flow cut for this case).
+ *    One EDF sweep over the windows gives every task's shortfall and
+ *    projected finish time.
+ *  - Tasks that may not be split (splitOK = false) also need one window
+ *    long enough for the whole block before their deadline.
+ *
+ * Incremental
+ *  - Free windows are cached per day with EventIndex's day fingerprint;
+ *    setEvents() after an edit recomputes only days whose content changed.
+ *  - setTasks() only re-sorts the pool. A check is O(days + windows + tasks).
+ */
+class DeadlineChecker {
+public:
+    struct Risk {
+        QString   id;
+        QString   title;
+        QDateTime deadline;
+        int       needMin  = 0;     ///< estimate + planner buffers
+        int       shortMin = 0;     ///< minutes that do not fit before the deadline
+        QDateTime finish;           ///< EDF completion; invalid = not before the last deadline
+        bool      noWindow = false; ///< unsplittable and no window is long enough
+    };
+
+    struct Result {
+        bool          feasible = true;
+        int           tasks    = 0;   ///< tasks with a deadline that were checked
+        int           slackMin = 0;   ///< free minutes left before the last deadline
+        QVector<Risk> atRisk;         ///< in deadline order
+        qint64        elapsedUs = 0;
+    };
+
+    explicit DeadlineChecker(const SuperAI* planner) : m_planner(planner) {}
+
+    void setTasks(const QVector<SuperAI::Task>& tasks);
+
+    /// Busy time = @events as indexed by @index (call after every rebuild).
+    void setEvents(const QVector<Event>& events, const EventIndex& index);
+
+    /// Re-run the sweep from @now (minute resolution).
+    const Result& check(const QDateTime& now);
+
+    const Result& result() const { return m_result; }
+
+    /// Days whose windows were recomputed by the last check (diagnostics).
+    int rebuiltDays() const { return m_rebuilt; }
+
+private:
+    struct Window { qint64 a = 0, b = 0; };   ///< epoch ms, [a, b)
+    struct Day {
+        size_t          fingerprint = 0;
+        QVector<Window> windows;
+    };
+    struct Job {
+        const SuperAI::Task* task = nullptr;
+        qint64 dueMs  = 0;
+        qint64 needMs = 0;
+    };
+
+    const QVector<Window>& windowsOn(const QDate& d);
+
+    const SuperAI*         m_planner = nullptr;
+    const QVector<Event>*  m_events  = nullptr;
+    const EventIndex*      m_index   = nullptr;
+    QVector<SuperAI::Task> m_tasks;
+    QVector<Job>           m_jobs;       ///< tasks with a deadline, by deadline
+    QHash<qint64, Day>     m_days;       ///< key: QDate::toJulianDay()
+    Result                 m_result;
+    int                    m_rebuilt = 0;
+};
@@ -1,5 +1,10 @@
 #include "Event.h"
 #include <QJsonValue>
+#include <QMutex>
+#include <QUuid>
+#include <unordered_set>
+
+const QString Event::kEmpty;
 
 Event::Event() = default;
 
@@ -11,13 +16,92 @@ Event::Event(const QString& title,
              const QString& seriesId,
              int id)
     : m_id(id)
+    , m_rgba(color.rgba())
     , m_title(title)
-    , m_description(description)
     , m_startTime(start)
     , m_endTime(end)
-    , m_color(color)
-    , m_seriesId(seriesId)
 {
+    setDescription(description);
+    setSeriesId(seriesId);
+}
+
+Event::Cold& Event::cold()
+{
+    if (!m_cold) m_cold = new Cold;
+    else         m_cold.detach();
+    return *m_cold;
+}
+
+void Event::dropColdIfEmpty()
+{
+    if (m_cold && !m_cold->hasNotes && m_cold->seriesId.isEmpty() && m_cold->uid.isEmpty()) m_cold.reset();
+}
+
+void Event::updateDescription()
+{
+    // Through cold(): the block may be shared with copies on other threads
+    if (!m_cold) return;
+    if (m_cold->hasNotes)                     cold().description = category() + "::" + m_cold->notes;
+    else if (!m_cold->description.isEmpty())  cold().description.clear();
+}
+
+const QString* Event::internCategory(const QString& category)
+{
+    if (category.isEmpty()) return nullptr;
+    // Node-based set: element addresses stay valid as it grows, so readers need no lock
+    static QMutex mutex;
+    static std::unordered_set<QString> names;
+    QMutexLocker lock(&mutex);
+    return &*names.insert(category).first;
+}
+
+const QString& Event::getDescription() const
+{
+    return hasNotes() ? m_cold->description : category();
+}
+
+void Event::setDescription(const QString& d)
+{
+    const int i = d.indexOf("::");
+    if (i < 0) {
+        m_category = internCategory(d);
+        if (hasNotes()) { cold().notes.clear(); m_cold->hasNotes = false; }
+    } else {
+        m_category = internCategory(d.left(i));
+        Cold& c = cold();
+        c.notes    = d.mid(i + 2);
+        c.hasNotes = true;
+    }
+    updateDescription();
+    dropColdIfEmpty();
+}
+
+void Event::setNotes(const QString& notes)
+{
+    Cold& c = cold();
+    c.notes    = notes;
+    c.hasNotes = !notes.isEmpty();
+    updateDescription();
+    dropColdIfEmpty();
+}
+
+void Event::setSeriesId(const QString& id)
+{
+    if (id == seriesId()) return;
+    cold().seriesId = id;
+    dropColdIfEmpty();
+}
+
+void Event::setUid(const QString& uid)
+{
+    if (uid == this->uid()) return;
+    cold().uid = uid;
+    dropColdIfEmpty();
+}
+
+QString Event::newUid()
+{
+    return QUuid::createUuid().toString(QUuid::WithoutBraces);
 }
 
 QJsonObject Event::toJson() const
@@ -25,13 +109,14 @@ QJsonObject Event::toJson() const
     QJsonObject o;
     o["id"]        = m_id;
     o["title"]     = m_title;
-    o["desc"]      = m_description;
+    o["desc"]      = getDescription();
     o["start"]     = m_startTime.toString(Qt::ISODate);
     o["end"]       = m_endTime.toString(Qt::ISODate);
-    o["color_r"]   = m_color.red();
-    o["color_g"]   = m_color.green();
-    o["color_b"]   = m_color.blue();
-    o["series_id"] = m_seriesId;
+    o["color_r"]   = qRed(m_rgba);
+    o["color_g"]   = qGreen(m_rgba);
+    o["color_b"]   = qBlue(m_rgba);
+    o["series_id"] = seriesId();
+    if (!uid().isEmpty()) o["uid"] = uid();
     return o;
 }
 
@@ -40,12 +125,13 @@ Event Event::fromJson(const QJsonObject& o)
     Event e;
     e.m_id          = o.value("id").toInt(-1);
     e.m_title       = o.value("title").toString();
-    e.m_description = o.value("desc").toString();
+    e.setDescription(o.value("desc").toString());
     e.m_startTime   = QDateTime::fromString(o.value("start").toString(), Qt::ISODate);
     e.m_endTime     = QDateTime::fromString(o.value("end").toString(),   Qt::ISODate);
-    e.m_color       = QColor(o.value("color_r").toInt(120),
-                             o.value("color_g").toInt(144),
-                             o.value("color_b").toInt(156));
-    e.m_seriesId    = o.value("series_id").toString();
+    e.m_rgba        = qRgb(o.value("color_r").toInt(120),
+                           o.value("color_g").toInt(144),
+                           o.value("color_b").toInt(156));
+    e.setSeriesId(o.value("series_id").toString());
+    e.setUid(o.value("uid").toString());
     return e;
 }
@@ -4,6 +4,7 @@
 #include <QDateTime>
 #include <QColor>
 #include <QJsonObject>
+#include <QSharedData>
 
 class Event
 {
@@ -20,20 +21,30 @@ public:
     // Getters
     int                getId()          const { return m_id; }
     const QString&     getTitle()       const { return m_title; }
-    const QString&     getDescription() const { return m_description; }
+    const QString&     getDescription() const;   // "Category::Notes" (kept with the notes)
+    const QString&     category()       const { return m_category ? *m_category : kEmpty; }   // text before "::"
+    const QString&     notes()          const { return m_cold ? m_cold->notes : kEmpty; }
+    bool               hasNotes()       const { return m_cold && m_cold->hasNotes; }
     const QDateTime&   getStartTime()   const { return m_startTime; }
     const QDateTime&   getEndTime()     const { return m_endTime; }
-    const QColor&      getColor()       const { return m_color; }
-    const QString&     seriesId()       const { return m_seriesId; }
+    QColor             getColor()       const { return QColor::fromRgba(m_rgba); }
+    const QString&     seriesId()       const { return m_cold ? m_cold->seriesId : kEmpty; }
+    const QString&     uid()            const { return m_cold ? m_cold->uid : kEmpty; }
 
     // Setters
     void setId(int id)                             { m_id = id; }
     void setTitle(const QString& t)                { m_title = t; }
-    void setDescription(const QString& d)          { m_description = d; }
+    void setDescription(const QString& d);         // splits into category + notes
+    void setNotes(const QString& notes);
     void setStartTime(const QDateTime& dt)         { m_startTime = dt; }
     void setEndTime(const QDateTime& dt)           { m_endTime = dt; }
-    void setColor(const QColor& c)                 { m_color = c; }
-    void setSeriesId(const QString& id)            { m_seriesId = id; }
+    void setColor(const QColor& c)                 { m_rgba = c.rgba(); }
+    void setSeriesId(const QString& id);
+    void setUid(const QString& uid);
+
+    // Stable, installation-independent identity (used by sync)
+    static QString newUid();
+    void ensureUid() { if (uid().isEmpty()) setUid(newUid()); }
 
     // Convenience
     bool isOnDate(const QDate& d) const {
@@ -45,11 +56,31 @@ public:
     static Event fromJson(const QJsonObject& obj);
 
 private:
-    int         m_id = -1;
-    QString     m_title;
-    QString     m_description;
-    QDateTime   m_startTime;
-    QDateTime   m_endTime;
-    QColor      m_color;
-    QString     m_seriesId;   // empty for one-off events; same id across a series
+    static const QString kEmpty;
+
+    // Cold fields: read by dialogs, tooltips, sync and persistence only. Kept out
+    // of line and shared between copies, so series instances and planner copies
+    // carry one pointer.
+    struct Cold : QSharedData {
+        QString notes;
+        QString description;        // "Category::Notes", rebuilt when either part changes
+        bool    hasNotes = false;   // description had a "::" part (even if empty)
+        QString seriesId;           // empty for one-off events; same id across a series
+        QString uid;                // stable across devices; empty for transient (planner) blocks
+    };
+    Cold& cold();                   // create or detach before writing
+    void  dropColdIfEmpty();
+    void  updateDescription();
+
+    /// Shared, never-freed copy of @category (categories repeat across thousands of events).
+    static const QString* internCategory(const QString& category);
+
+    // Hot fields: what painting, indexing, stats and the planner read
+    int              m_id = -1;
+    QRgb             m_rgba = 0;
+    const QString*   m_category = nullptr;   // interned; null = no category
+    QString          m_title;                // short; painted on chips and agenda rows
+    QDateTime        m_startTime;
+    QDateTime        m_endTime;
+    QExplicitlySharedDataPointer<Cold> m_cold;   // null when there is nothing cold
 };
@@ -0,0 +1,96 @@
+#include "EventColumns.h"
+#include <QHash>
+#include <algorithm>  // std::max, std::min
+
+static constexpr qint64 kDaySecs = 86400;
+
+void EventColumns::rebuild(const QVector<Event>& events)
+{
+    const int n = events.size();
+    m_start.resize(n);
+    m_end.resize(n);
+    m_cat.resize(n);
+    m_flags.resize(n);
+    m_catNames.clear();
+
+    QHash<QString, quint8> ids;
+    for (int i = 0; i < n; ++i) {
+        const Event& e = events[i];
+        m_start[i] = wallSecs(e.getStartTime());
+        m_end[i]   = wallSecs(e.getEndTime());
+
+        const QString cat = e.category().trimmed().toLower();
+        auto it = ids.constFind(cat);
+        if (it == ids.constEnd()) {
+            const quint8 id = quint8(std::min<qsizetype>(m_catNames.size(), 255));
+            if (m_catNames.size() < 256) m_catNames << cat;
+            it = ids.insert(cat, id);
+        }
+        m_cat[i] = *it;
+
+        const QString& t = e.getTitle();
+        quint8 f = 0;
+        if (t.contains("Meeting", Qt::CaseInsensitive)) f |= Meeting;
+        if (t.startsWith(QStringLiteral("🔵")))         f |= DeepWork;
+        if (t == QLatin1String("Buffer"))               f |= Buffer;
+        m_flags[i] = f;
+    }
+}
+
+QVector<int> EventColumns::overlapping(const QDateTime& a, const QDateTime& b) const
+{
+    QVector<uint32_t> hit(size());
+    const size_t k = ColumnKernels::overlapping(m_start.constData(), m_end.constData(), size_t(size()),
+                                                wallSecs(a), wallSecs(b), hit.data(), m_isa);
+    return QVector<int>(hit.cbegin(), hit.cbegin() + k);
+}
+
+QVector<qint64> EventColumns::minutesPerCategory(const QDateTime& a, const QDateTime& b) const
+{
+    QVector<int64_t> secs(m_catNames.size(), 0);
+    ColumnKernels::secondsPerCategory(m_start.constData(), m_end.constData(), m_cat.constData(),
+                                      size_t(size()), wallSecs(a), wallSecs(b),
+                                      secs.data(), size_t(secs.size()), m_isa);
+    QVector<qint64> minutes(secs.size());
+    for (int i = 0; i < secs.size(); ++i) minutes[i] = secs[i] / 60;
+    return minutes;
+}
+
+QVector<int> EventColumns::countPerDay(const QDate& first, int days) const
+{
+    QVector<int32_t> counts(std::max(days, 0), 0);
+    const qint64 base = wallSecs(first.startOfDay());
+    ColumnKernels::countPerDay(m_start.constData(), m_end.constData(), size_t(size()),
+                               base, days, counts.data(), m_isa);
+    return QVector<int>(counts.cbegin(), counts.cend());
+}
+
+qint64 EventColumns::totalMinutes() const
+{
+    qint64 total = 0;
+    for (int i = 0; i < size(); ++i) total += std::max<int64_t>(0, (m_end[i] - m_start[i]) / 60);
+    return total;
+}
+
+int EventColumns::countFlag(Flag f) const
+{
+    int n = 0;
+    for (quint8 v : m_flags) n += (v & f) == f;
+    return n;
+}
+
+QTime EventColumns::earliestStart() const
+{
+    if (m_start.isEmpty()) return {};
+    qint64 best = kDaySecs;
+    for (int64_t s : m_start) best = std::min(best, ((s % kDaySecs) + kDaySecs) % kDaySecs);
+    return QTime(0, 0).addSecs(int(best));
+}
+
+QTime EventColumns::latestEnd() const
+{
+    if (m_end.isEmpty()) return {};
+    qint64 best = 0;
+    for (int64_t e : m_end) best = std::max(best, ((e % kDaySecs) + kDaySecs) % kDaySecs);
+    return QTime(0, 0).addSecs(int(best));
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+#include <QStringList>
+#include <QTime>
+#include <QVector>
+
+#include "ColumnKernels.h"
+#include "Event.h"
+
+/**
+ * @brief EventColumns
+ * Read-only columnar snapshot of a QVector<Event> for analytics.
+ *
+ * Columns (parallel, one entry per event)
+ *  - start / end : int64_t local wall-clock seconds (UTC seconds + UTC offset),
+ *                  so calendar days are exact multiples of 86400
+ *  - category    : uint8 id into categoryNames() (lower-cased "Category::" prefix)
+ *  - flags       : uint8 bit set of Flag
+ *
+ * Range queries run ColumnKernels over the contiguous arrays instead of
+ * touching QDateTime/QString members of each Event.
+ *
+ * Notes
+ *  - Rebuild after every mutation of the source vector (rows match its order).
+ *  - Categories beyond 255 distinct names share the last id.
+ */
+class EventColumns {
+public:
+    enum Flag : quint8 {
+        Meeting  = 1 << 0,   ///< title contains "meeting"
+        DeepWork = 1 << 1,   ///< planner deep-work block ("🔵" prefix)
+        Buffer   = 1 << 2    ///< planner buffer block
+    };
+
+    void rebuild(const QVector<Event>& events);
+
+    int size() const { return m_start.size(); }
+    const QVector<int64_t>& starts()    const { return m_start; }
+    const QVector<int64_t>& ends()      const { return m_end; }
+    const QVector<quint8>& categories() const { return m_cat; }
+    const QVector<quint8>& flags()      const { return m_flags; }
+    const QStringList&     categoryNames() const { return m_catNames; }
+
+    /// Id of a (case-insensitive) category name; -1 if unknown.
+    int categoryId(const QString& name) const { return m_catNames.indexOf(name.trimmed().toLower()); }
+
+    /// Local wall-clock seconds used by the time columns.
+    static qint64 wallSecs(const QDateTime& dt) { return dt.toSecsSinceEpoch() + dt.offsetFromUtc(); }
+
+    // ---------------------------------------------------------------------
+    // Queries (vectorised through ColumnKernels)
+    // ---------------------------------------------------------------------
+
+    /// Rows overlapping [a, b), ascending.
+    QVector<int> overlapping(const QDateTime& a, const QDateTime& b) const;
+
+    /// Minutes of overlap with [a, b) per category id (size == categoryNames().size()).
+    QVector<qint64> minutesPerCategory(const QDateTime& a, const QDateTime& b) const;
+
+    /// Events touching each of the @days days starting at @first (as Event::isOnDate).
+    QVector<int> countPerDay(const QDate& first, int days) const;
+
+    // ---------------------------------------------------------------------
+    // Whole-snapshot rollups (plain loops over the columns)
+    // ---------------------------------------------------------------------
+
+    /// Sum of whole minutes per event (negative durations count as 0).
+    qint64 totalMinutes() const;
+
+    /// Rows with all bits of @f set.
+    int countFlag(Flag f) const;
+
+    /// Earliest start and latest end time of day; invalid when empty.
+    QTime earliestStart() const;
+    QTime latestEnd() const;
+
+    /// Pin the kernels to one instruction set (benchmarks); default is the best available.
+    void setIsa(ColumnKernels::Isa isa) { m_isa = isa; }
+
+private:
+    QVector<int64_t> m_start;   // int64_t, not qint64: the kernels' type (they differ on LP64)
+    QVector<int64_t> m_end;
+    QVector<quint8>  m_cat;
+    QVector<quint8>  m_flags;
+    QStringList      m_catNames;
+    ColumnKernels::Isa m_isa = ColumnKernels::bestIsa();
+};
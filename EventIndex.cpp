@@ -0,0 +1,220 @@
+#include "EventIndex.h"
+#include <QAtomicInt>
+#include <QMutex>
+#include <algorithm>  // std::sort, std::min
+
+// Upper bound on how many days a single (multi-day) event is indexed under.
+static constexpr int kMaxSpanDays = 366;
+
+// "Category::Notes" → "Notes" (cold field; only read when tips are built)
+static QString notesOf(const Event& e) {
+    return e.notes().trimmed();
+}
+
+// Process-wide category → bit table (indexes may be rebuilt off the GUI thread)
+struct CategoryRegistry {
+    QMutex              mutex;
+    QHash<QString, int> bits;       // key: trimmed, lower-case
+    QStringList         names;      // bits 0..kOtherBit-1, as first spelled
+    QStringList         overflow;   // everything sharing kOtherBit
+    QAtomicInt          generation; // bumped whenever a category is registered
+};
+
+static CategoryRegistry& registry()
+{
+    static CategoryRegistry r;
+    return r;
+}
+
+int EventIndex::categoryBit(const QString& category)
+{
+    const QString key = category.trimmed().toLower();
+    CategoryRegistry& r = registry();
+    QMutexLocker lock(&r.mutex);
+    const auto it = r.bits.constFind(key);
+    if (it != r.bits.constEnd()) return *it;
+
+    int bit = kOtherBit;   // shared by everything past the first 63
+    if (r.names.size() < kOtherBit) {
+        bit = r.names.size();
+        r.names << category.trimmed();
+    } else {
+        r.overflow << category.trimmed();
+    }
+    r.bits.insert(key, bit);
+    r.generation.ref();
+    return bit;
+}
+
+int EventIndex::findCategoryBit(const QString& category)
+{
+    CategoryRegistry& r = registry();
+    QMutexLocker lock(&r.mutex);
+    return r.bits.value(category.trimmed().toLower(), -1);
+}
+
+QStringList EventIndex::categoryNames()
+{
+    CategoryRegistry& r = registry();
+    QMutexLocker lock(&r.mutex);
+    return r.names;
+}
+
+QStringList EventIndex::otherCategoryNames()
+{
+    CategoryRegistry& r = registry();
+    QMutexLocker lock(&r.mutex);
+    return r.overflow;
+}
+
+int EventIndex::categoryGeneration()
+{
+    return registry().generation.loadAcquire();
+}
+
+int EventIndex::DaySummary::countIn(CategoryMask only) const
+{
+    if (allIn(only)) return rows.size();
+    int n = 0;
+    for (const auto& c : perCategory)
+        if ((only >> c.bit) & 1) n += c.count;
+    return n;
+}
+
+void EventIndex::rebuild(const QVector<Event>& events)
+{
+    QHash<qint64, DaySummary> days;
+    days.reserve(m_days.size());
+
+    // Bucket positions per day (multi-day events land on every day they touch)
+    for (int i = 0; i < events.size(); ++i) {
+        const QDate s = events[i].getStartTime().date();
+        const QDate e = events[i].getEndTime().date();
+        if (!s.isValid() || !e.isValid()) continue;
+
+        const qint64 first = s.toJulianDay();
+        const qint64 last  = std::min(e.toJulianDay(), first + kMaxSpanDays);
+        for (qint64 jd = first; jd <= last; ++jd)
+            days[jd].rows.push_back(i);
+    }
+
+    // Category bit per event; the registry is only asked once per distinct spelling
+    QVector<quint8> bitOf(events.size());
+    QHash<QString, int> seen;
+    for (int i = 0; i < events.size(); ++i) {
+        const QString& cat = events[i].category();
+        auto it = seen.constFind(cat);
+        if (it == seen.constEnd()) it = seen.insert(cat, categoryBit(cat));
+        bitOf[i] = quint8(*it);
+    }
+
+    // Sort each day and fingerprint its content; carry over unchanged hover text
+    for (auto it = days.begin(); it != days.end(); ++it) {
+        DaySummary& s = it.value();
+        std::sort(s.rows.begin(), s.rows.end(), [&](int a, int b) {
+            const auto& ta = events[a].getStartTime();
+            const auto& tb = events[b].getStartTime();
+            return ta != tb ? ta < tb : a < b;
+        });
+
+        size_t h = 0;
+        for (int r : s.rows) {
+            const Event& e = events[r];
+            h = qHashMulti(h, e.getTitle(), e.category(), e.notes(),
+                           e.getStartTime().toSecsSinceEpoch(),
+                           e.getEndTime().toSecsSinceEpoch());
+        }
+        s.fingerprint = h;
+
+        s.rowCategory.reserve(s.rows.size());
+        for (int r : s.rows) {
+            const quint8 bit = bitOf[r];
+            s.rowCategory.push_back(bit);
+            if (!((s.categories >> bit) & 1)) s.perCategory.push_back({ bit, 0 });
+            s.categories |= CategoryMask(1) << bit;
+            for (auto& c : s.perCategory)
+                if (c.bit == bit) { ++c.count; break; }
+        }
+
+        const auto old = m_days.constFind(it.key());
+        if (old != m_days.constEnd() && old->tipsBuilt && old->fingerprint == h) {
+            s.tipsBuilt = true;
+            s.tooltip   = old->tooltip;
+            s.itemLines = old->itemLines;
+            s.itemTips  = old->itemTips;
+        }
+    }
+
+    m_days   = std::move(days);
+    m_events = &events;
+}
+
+const EventIndex::DaySummary* EventIndex::find(const QDate& d) const
+{
+    if (!d.isValid()) return nullptr;
+    const auto it = m_days.constFind(d.toJulianDay());
+    return it == m_days.constEnd() ? nullptr : &it.value();
+}
+
+const QVector<int>& EventIndex::rowsOn(const QDate& d) const
+{
+    static const QVector<int> kEmpty;
+    const DaySummary* s = find(d);
+    return s ? s->rows : kEmpty;
+}
+
+int EventIndex::countOn(const QDate& d, CategoryMask only) const
+{
+    const DaySummary* s = find(d);
+    return s ? s->countIn(only) : 0;
+}
+
+size_t EventIndex::fingerprintOn(const QDate& d) const
+{
+    const DaySummary* s = find(d);
+    return s ? s->fingerprint : 0;
+}
+
+void EventIndex::buildTips(const DaySummary& s) const
+{
+    if (s.tipsBuilt || !m_events) return;
+
+    QStringList lines;
+    s.itemTips.clear();
+    s.itemTips.reserve(s.rows.size());
+    lines.reserve(s.rows.size());
+    for (int r : s.rows) {
+        const Event& e = m_events->at(r);
+        const QString notes = notesOf(e);
+        lines << QString("• %1  (%2–%3)%4")
+            .arg(e.getTitle(),
+                 e.getStartTime().time().toString("hh:mm"),
+                 e.getEndTime().time().toString("hh:mm"),
+                 notes.isEmpty() ? "" : QString("\n    %1").arg(notes));
+        s.itemTips << notes;
+    }
+    s.tooltip   = lines.join("\n");
+    s.itemLines = lines;
+    s.tipsBuilt = true;
+}
+
+QString EventIndex::tooltipFor(const QDate& d, CategoryMask only) const
+{
+    const DaySummary* s = find(d);
+    if (!s) return {};
+    buildTips(*s);
+    if (s->allIn(only)) return s->tooltip;
+
+    QStringList lines;
+    for (int k = 0; k < s->rows.size(); ++k)
+        if (s->rowIn(k, only)) lines << s->itemLines[k];
+    return lines.join("\n");
+}
+
+QString EventIndex::itemTooltip(const QDate& d, int row) const
+{
+    const DaySummary* s = find(d);
+    if (!s || row < 0 || row >= s->rows.size()) return {};
+    buildTips(*s);
+    return s->itemTips.value(row);
+}
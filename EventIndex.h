@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QDate>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "Event.h"
+
+/**
+ * @brief EventIndex
+ * Per-day index over a flat QVector<Event> plus a small summary cache.
+ *
+ * Responsibilities
+ *  - Map each date to the positions of the events touching it (by start time)
+ *  - Keep per-day category bits and counts, so a category filter can be
+ *    applied to a day without reading its events
+ *  - Serve hover/tooltip text per day and per day-list row
+ *
+ * Notes
+ *  - Positions refer to the vector given to rebuild(); call rebuild() after
+ *    every mutation of that vector.
+ *  - Tooltip strings are built on first request and memoised until the
+ *    day's events change (tracked with a per-day content fingerprint).
+ *  - Category bits are process-wide (categoryBit()), so masks from
+ *    different indexes (layers) mean the same thing. Bits are handed out
+ *    as indexes meet categories and are not stable across runs; persist
+ *    category names and look them up with findCategoryBit(). Past 63
+ *    categories the rest share kOtherBit and can only be filtered together.
+ */
+class EventIndex {
+public:
+    using CategoryMask = quint64;
+    static constexpr CategoryMask kAllCategories = ~CategoryMask(0);
+    static constexpr int          kCategoryBits  = 64;
+    static constexpr int          kOtherBit      = kCategoryBits - 1;   ///< shared by categories past the 63rd
+
+    /// Cached view of a single day.
+    struct DaySummary {
+        struct CategoryCount { quint8 bit; int count; };
+
+        QVector<int>    rows;             ///< event positions, sorted by start time
+        QVector<quint8> rowCategory;      ///< category bit per row, parallel to rows
+        CategoryMask    categories = 0;   ///< union of the rows' category bits
+        QVector<CategoryCount> perCategory;
+        size_t          fingerprint = 0;  ///< content hash of the day's events
+
+        /// Rows whose category is in @only.
+        int  countIn(CategoryMask only) const;
+        bool rowIn(int row, CategoryMask only) const { return (only >> rowCategory[row]) & 1; }
+        /// Every row passes @only (the common case: nothing of this day is filtered out).
+        bool allIn(CategoryMask only) const { return (categories & ~only) == 0; }
+
+        // Lazily built hover data (filled by the const accessors below)
+        mutable bool        tipsBuilt = false;
+        mutable QString     tooltip;   ///< multi-line tooltip for the whole day
+        mutable QStringList itemLines; ///< per-row tooltip lines, parallel to rows
+        mutable QStringList itemTips;  ///< per-row notes, parallel to rows
+    };
+
+    /// Bit for @category (trimmed, case-insensitive), registering it if new;
+    /// shared by every index in the process.
+    static int categoryBit(const QString& category);
+    /// Bit for @category if some index has met it, else -1 (never registers).
+    static int findCategoryBit(const QString& category);
+
+    /// Categories with a bit of their own (bits 0..kOtherBit-1), as first spelled.
+    static QStringList categoryNames();
+    /// Categories sharing kOtherBit.
+    static QStringList otherCategoryNames();
+    /// Changes whenever a category is registered (to refresh masks built from names).
+    static int categoryGeneration();
+
+    /**
+     * @brief rebuild
+     * Re-index @events. Memoised strings survive for days whose content is unchanged.
+     */
+    void rebuild(const QVector<Event>& events);
+
+    /// Event positions on @d (sorted by start); empty if none.
+    const QVector<int>& rowsOn(const QDate& d) const;
+
+    /// Number of events touching @d (whose category is in @only).
+    int countOn(const QDate& d) const { return rowsOn(d).size(); }
+    int countOn(const QDate& d, CategoryMask only) const;
+
+    /// Summary of @d; nullptr if the day has no events.
+    const DaySummary* summaryOn(const QDate& d) const { return find(d); }
+
+    /// Content hash of @d's events (0 when the day is empty); changes whenever the day does.
+    size_t fingerprintOn(const QDate& d) const;
+
+    /// Multi-line "• Title (hh:mm–hh:mm)" tooltip for @d (only rows whose category is in @only).
+    QString tooltipFor(const QDate& d, CategoryMask only = kAllCategories) const;
+
+    /// Notes of the @row-th event on @d (as listed by rowsOn); empty if none.
+    QString itemTooltip(const QDate& d, int row) const;
+
+private:
+    const DaySummary* find(const QDate& d) const;
+    void buildTips(const DaySummary& s) const;
+
+    const QVector<Event>*      m_events = nullptr;
+    QHash<qint64, DaySummary>  m_days;   ///< key: QDate::toJulianDay()
+};
@@ -0,0 +1,279 @@
+#include "FreeBusy.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <algorithm>  // std::max, std::min
+#include <numeric>    // std::gcd
+
+static constexpr quint32 kFbMagic = 0x4546425a; // "EFBZ"
+
+static bool validSlot(int m) { return m > 0 && m <= 60 && 1440 % m == 0; }
+
+// ---- varint (LEB128) ----------------------------------------------------------
+
+static void putVarint(QByteArray& out, quint32 v)
+{
+    while (v >= 0x80) { out.append(char((v & 0x7f) | 0x80)); v >>= 7; }
+    out.append(char(v));
+}
+
+static bool getVarint(const uchar*& p, const uchar* end, quint32& v)
+{
+    v = 0;
+    for (int shift = 0; p < end && shift < 35; shift += 7) {
+        const uchar b = *p++;
+        v |= quint32(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+template <typename T>
+static void putLE(QByteArray& out, T v)
+{
+    for (size_t i = 0; i < sizeof(T); ++i) out.append(char((quint64(v) >> (8 * i)) & 0xff));
+}
+
+template <typename T>
+static bool getLE(const uchar*& p, const uchar* end, T& v)
+{
+    if (end - p < qptrdiff(sizeof(T))) return false;
+    quint64 x = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) x |= quint64(p[i]) << (8 * i);
+    p += sizeof(T);
+    v = T(x);
+    return true;
+}
+
+
+// ============================================================================
+// FreeBusy
+// ============================================================================
+
+FreeBusy::FreeBusy(const QDate& first, int days, int slotMin)
+    : m_first(first), m_days(std::max(0, days)), m_slotMin(validSlot(slotMin) ? slotMin : 15)
+{
+    m_bits.assign(size_t(m_days) * size_t(wordsPerDay()), 0);
+}
+
+void FreeBusy::setRange(int day, int from, int to)
+{
+    from = std::max(from, 0);
+    to   = std::min(to, slotsPerDay());
+    if (from >= to) return;
+
+    quint64* w = dayBits(day);
+    const int fw = from >> 6, lw = (to - 1) >> 6;
+    const quint64 head = ~quint64(0) << (from & 63);
+    const quint64 tail = ~quint64(0) >> (63 - ((to - 1) & 63));
+    if (fw == lw) { w[fw] |= head & tail; return; }
+    w[fw] |= head;
+    for (int i = fw + 1; i < lw; ++i) w[i] = ~quint64(0);
+    w[lw] |= tail;
+}
+
+void FreeBusy::addBusy(const QDateTime& s, const QDateTime& e)
+{
+    if (isNull() || !s.isValid() || !e.isValid() || !(s < e)) return;
+
+    const qint64 firstJd = m_first.toJulianDay();
+    const qint64 d0 = std::max<qint64>(s.date().toJulianDay() - firstJd, 0);
+    const qint64 d1 = std::min<qint64>(e.date().toJulianDay() - firstJd, m_days - 1);
+
+    for (qint64 d = d0; d <= d1; ++d) {
+        const qint64 jd = firstJd + d;
+        // Wall-clock minutes of the event inside this day
+        const int fromMin = s.date().toJulianDay() < jd ? 0 : s.time().msecsSinceStartOfDay() / 60000;
+        const int toMs    = e.date().toJulianDay() > jd ? 1440 * 60000 : e.time().msecsSinceStartOfDay();
+        const int toSlot  = (toMs + m_slotMin * 60000 - 1) / (m_slotMin * 60000);   // round up
+        setRange(int(d), fromMin / m_slotMin, toSlot);
+    }
+}
+
+void FreeBusy::addEvents(const QVector<Event>& events, const EventIndex& index)
+{
+    for (int d = 0; d < m_days; ++d)
+        for (int r : index.rowsOn(m_first.addDays(d)))
+            addBusy(events[r].getStartTime(), events[r].getEndTime());
+}
+
+bool FreeBusy::isBusy(const QDate& d, int slot) const
+{
+    const qint64 day = m_first.daysTo(d);
+    if (day < 0 || day >= m_days || slot < 0 || slot >= slotsPerDay()) return false;
+    return (dayBits(int(day))[slot >> 6] >> (slot & 63)) & 1;
+}
+
+bool FreeBusy::isBusy(const QDateTime& t) const
+{
+    return isBusy(t.date(), t.time().msecsSinceStartOfDay() / (m_slotMin * 60000));
+}
+
+QVector<QPair<QDateTime, QDateTime>> FreeBusy::freeRanges(const QDate& d, const QTime& from,
+                                                          const QTime& to) const
+{
+    QVector<QPair<QDateTime, QDateTime>> out;
+    const int n  = slotsPerDay();
+    const int s0 = from.msecsSinceStartOfDay() / (m_slotMin * 60000);
+    const int s1 = std::min(n, (to.msecsSinceStartOfDay() + m_slotMin * 60000 - 1) / (m_slotMin * 60000));
+
+    auto at = [&](int slot) {
+        return slot >= n ? d.addDays(1).startOfDay() : QDateTime(d, QTime(0, 0).addSecs(slot * m_slotMin * 60));
+    };
+    int runStart = -1;
+    for (int s = s0; s <= s1; ++s) {
+        const bool free = s < s1 && !isBusy(d, s);
+        if (free && runStart < 0) runStart = s;
+        if (!free && runStart >= 0) { out.push_back({ at(runStart), at(s) }); runStart = -1; }
+    }
+    return out;
+}
+
+FreeBusy FreeBusy::resampled(int slotMin) const
+{
+    if (!validSlot(slotMin) || slotMin % m_slotMin != 0 || slotMin == m_slotMin) return *this;
+
+    FreeBusy out(m_first, m_days, slotMin);
+    const int ratio = slotMin / m_slotMin;
+    for (int d = 0; d < m_days; ++d)
+        for (int s = 0; s < slotsPerDay(); ++s)
+            if ((dayBits(d)[s >> 6] >> (s & 63)) & 1)
+                out.setRange(d, s / ratio, s / ratio + 1);
+    return out;
+}
+
+int FreeBusy::commonSlot(int a, int b)
+{
+    if (!validSlot(a) || !validSlot(b)) return 0;
+    const int lcm = a / std::gcd(a, b) * b;
+    return validSlot(lcm) ? lcm : 0;
+}
+
+bool FreeBusy::unite(const FreeBusy& other)
+{
+    if (isNull() || other.isNull()) return true;
+    if (other.m_slotMin != m_slotMin) {
+        const int slot = commonSlot(m_slotMin, other.m_slotMin);
+        if (!slot) return false;
+        if (slot != m_slotMin) *this = resampled(slot);
+        if (slot != other.m_slotMin) return unite(other.resampled(slot));
+    }
+
+    const qint64 shift = m_first.daysTo(other.m_first);
+    const int    words = wordsPerDay();
+    for (int d = 0; d < m_days; ++d) {
+        const qint64 od = d - shift;
+        if (od < 0 || od >= other.m_days) continue;
+        quint64*       a = dayBits(d);
+        const quint64* b = other.dayBits(int(od));
+        for (int i = 0; i < words; ++i) a[i] |= b[i];
+    }
+    return true;
+}
+
+FreeBusy FreeBusy::intersectFree(const QVector<FreeBusy>& all, QString* error)
+{
+    if (error) error->clear();
+    if (all.isEmpty()) return {};
+
+    QDate first = all.first().firstDay(), last = all.first().lastDay();
+    int   slot  = all.first().slotMinutes();
+    for (const FreeBusy& f : all) {
+        if (f.isNull()) return {};
+        first = std::max(first, f.firstDay());
+        last  = std::min(last,  f.lastDay());
+        const int common = commonSlot(slot, f.slotMinutes());
+        if (!common) {
+            if (error) *error = QString("%1- and %2-minute slots have no common slot size up to an hour")
+                                    .arg(slot).arg(f.slotMinutes());
+            return {};
+        }
+        slot = common;
+    }
+    if (first > last) return {};
+
+    FreeBusy out(first, int(first.daysTo(last)) + 1, slot);
+    for (const FreeBusy& f : all) out.unite(f);
+    return out;
+}
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+QByteArray FreeBusy::encode() const
+{
+    QByteArray out;
+    out.reserve(32 + m_days * 4);
+    putLE<quint32>(out, kFbMagic);
+    putLE<quint16>(out, kVersion);
+    putLE<quint8>(out, quint8(m_slotMin));
+    putLE<qint64>(out, m_first.toJulianDay());
+    putLE<quint32>(out, quint32(m_days));
+
+    const int n = slotsPerDay();
+    QVector<quint32> runs;
+    for (int d = 0; d < m_days; ++d) {
+        runs.clear();
+        const quint64* w = dayBits(d);
+        bool    cur = false;   // runs start with "free"
+        quint32 len = 0;
+        for (int s = 0; s < n; ++s) {
+            const bool b = (w[s >> 6] >> (s & 63)) & 1;
+            if (b != cur) { runs.push_back(len); cur = b; len = 0; }
+            ++len;
+        }
+        runs.push_back(len);
+
+        putVarint(out, quint32(runs.size()));
+        for (quint32 r : runs) putVarint(out, r);
+    }
+    return out;
+}
+
+FreeBusy FreeBusy::decode(const QByteArray& data, QString* error)
+{
+    auto fail = [error](const char* why) { if (error) *error = why; return FreeBusy(); };
+
+    const uchar* p   = reinterpret_cast<const uchar*>(data.constData());
+    const uchar* end = p + data.size();
+    quint32 magic = 0, days = 0; quint16 version = 0; quint8 slot = 0; qint64 jd = 0;
+    if (!getLE(p, end, magic) || magic != kFbMagic) return fail("not a free/busy file");
+    if (!getLE(p, end, version) || version != kVersion) return fail("unsupported free/busy version");
+    if (!getLE(p, end, slot) || !validSlot(slot)) return fail("bad slot size");
+    if (!getLE(p, end, jd) || !getLE(p, end, days) || days > 100000) return fail("bad header");
+
+    FreeBusy fb(QDate::fromJulianDay(jd), int(days), slot);
+    const int n = fb.slotsPerDay();
+    for (int d = 0; d < int(days); ++d) {
+        quint32 count = 0;
+        if (!getVarint(p, end, count)) return fail("truncated");
+        int  pos  = 0;
+        bool busy = false;
+        for (quint32 i = 0; i < count; ++i, busy = !busy) {
+            quint32 len = 0;
+            if (!getVarint(p, end, len) || pos + qint64(len) > n) return fail("corrupt run");
+            if (busy) fb.setRange(d, pos, pos + int(len));
+            pos += int(len);
+        }
+        if (pos != n) return fail("corrupt day");
+    }
+    if (error) error->clear();
+    return fb;
+}
+
+bool FreeBusy::save(const QString& path, QString* error) const
+{
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) { if (error) *error = f.errorString(); return false; }
+    f.write(encode());
+    if (!f.commit()) { if (error) *error = f.errorString(); return false; }
+    return true;
+}
+
+FreeBusy FreeBusy::load(const QString& path, QString* error)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) { if (error) *error = f.errorString(); return {}; }
+    return decode(f.readAll(), error);
+}
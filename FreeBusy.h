@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDate>
+#include <QDateTime>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <vector>
+
+#include "Event.h"
+#include "EventIndex.h"
+
+/**
+ * @brief FreeBusy
+ * Occupancy bitmap (one bit per slot, 15 minutes by default; any slot size
+ * up to an hour that divides a day) over a span of days, for sharing
+ * availability without titles or details.
+ *
+ * File layout (".efb", little-endian)
+ *   "EFBZ" magic, quint16 version, quint8 slot minutes, qint64 first Julian day,
+ *   quint32 day count, then per day: varint run count followed by varint run
+ *   lengths, alternating free/busy and starting with free. With 15-minute
+ *   slots (96 a day) an empty day is two bytes; slots under 12 minutes need a
+ *   two-byte run, so three. A year of a normal calendar stays in the low
+ *   kilobytes.
+ *
+ * Notes
+ *  - Built straight from EventIndex day rows: only events on the requested
+ *    days are visited, and slot ranges are set a 64-bit word at a time.
+ *  - Times are local wall clock; a slot is busy if any event touches it.
+ *  - unite() ORs busy bits, so the common free time of many people is the
+ *    free time of their union. Differing slot sizes are resampled to their
+ *    least common multiple (10 and 15 → 30, 12 and 20 → 60); pairs with no
+ *    common size up to an hour (e.g. 32 and 15) are refused.
+ */
+class FreeBusy {
+public:
+    static constexpr quint16 kVersion = 1;
+
+    FreeBusy() = default;
+    FreeBusy(const QDate& first, int days, int slotMin = 15);
+
+    bool  isNull()     const { return m_days == 0; }
+    QDate firstDay()   const { return m_first; }
+    QDate lastDay()    const { return m_first.addDays(m_days - 1); }
+    int   days()       const { return m_days; }
+    int   slotMinutes() const { return m_slotMin; }
+    int   slotsPerDay() const { return 1440 / m_slotMin; }
+
+    /// Mark every event of @index (over @events) that touches the span as busy.
+    void addEvents(const QVector<Event>& events, const EventIndex& index);
+
+    /// Mark [s, e) busy (clipped to the span).
+    void addBusy(const QDateTime& s, const QDateTime& e);
+
+    bool isBusy(const QDate& d, int slot) const;
+    bool isBusy(const QDateTime& t) const;
+
+    /// Free ranges of @d within [from, to).
+    QVector<QPair<QDateTime, QDateTime>> freeRanges(const QDate& d,
+                                                    const QTime& from = QTime(0, 0),
+                                                    const QTime& to   = QTime(23, 59, 59)) const;
+
+    /// Same bitmap at a coarser slot size (slot busy if any sub-slot is busy).
+    FreeBusy resampled(int slotMin) const;
+
+    /// OR @other's busy bits into this bitmap over the days both cover, first
+    /// resampling both to a common slot size. False (and unchanged) if there is none.
+    bool unite(const FreeBusy& other);
+
+    /// Smallest slot size both @a and @b divide, or 0 if it is over an hour.
+    static int commonSlot(int a, int b);
+
+    /// Common free/busy of @all over their overlapping days (null if none
+    /// overlap or their slot sizes have no common size; @error says which).
+    static FreeBusy intersectFree(const QVector<FreeBusy>& all, QString* error = nullptr);
+
+    QByteArray encode() const;
+    static FreeBusy decode(const QByteArray& data, QString* error = nullptr);
+
+    bool save(const QString& path, QString* error = nullptr) const;
+    static FreeBusy load(const QString& path, QString* error = nullptr);
+
+private:
+    int wordsPerDay() const { return (slotsPerDay() + 63) / 64; }
+    quint64*       dayBits(int day)       { return m_bits.data() + size_t(day) * size_t(wordsPerDay()); }
+    const quint64* dayBits(int day) const { return m_bits.data() + size_t(day) * size_t(wordsPerDay()); }
+    void setRange(int day, int from, int to);   ///< slots [from, to)
+
+    QDate                m_first;
+    int                  m_days    = 0;
+    int                  m_slotMin = 15;
+    std::vector<quint64> m_bits;   ///< days × wordsPerDay, bit = busy
+};
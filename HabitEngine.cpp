@@ -0,0 +1,163 @@
+#include "HabitEngine.h"
+
+#include <QPair>
+#include <algorithm>  // std::sort, std::stable_sort, std::clamp, std::max, std::min
+
+static int minutesOf(const QDateTime& s, const QDateTime& e)
+{
+    return std::max(0, int(s.secsTo(e) / 60));
+}
+
+// Anchor hour range [from, to) or {-1,-1} for none
+static QPair<int, int> anchorHours(const QString& anchor)
+{
+    if (anchor == "morning")     return { 7, 12 };
+    if (anchor == "after-lunch") return { 12, 16 };
+    if (anchor == "evening")     return { 17, 24 };
+    return { -1, -1 };
+}
+
+void HabitEngine::reset(const QDate& first, const QVector<QVector<SuperAI::Slot>>& windows)
+{
+    m_first   = first;
+    m_windows = windows;
+    for (auto& day : m_windows)
+        std::sort(day.begin(), day.end(), [](const SuperAI::Slot& a, const SuperAI::Slot& b){
+            return a.start < b.start;
+        });
+    m_used = QVector<int>(m_windows.size(), 0);
+    m_placed.clear();
+    m_unplaced.clear();
+}
+
+// ============================================================================
+// Streaks
+// ============================================================================
+
+void HabitEngine::setHistory(const QVector<Event>& history, const QDate& today)
+{
+    m_today = today;
+    m_done.clear();
+    const QString prefix = QStringLiteral("🟢 ");
+    for (const Event& e : history) {
+        if (!e.getTitle().startsWith(prefix)) continue;
+        const QDate d = e.getStartTime().date();
+        if (d > today) continue;
+        m_done[e.getTitle().mid(prefix.size())].insert(d.toJulianDay());
+    }
+}
+
+int HabitEngine::currentStreak(const QString& habit) const
+{
+    const auto it = m_done.constFind(habit);
+    if (it == m_done.constEnd() || !m_today.isValid()) return 0;
+
+    qint64 jd = m_today.toJulianDay();
+    if (!it->contains(jd)) --jd;          // today may still be ahead
+    int n = 0;
+    while (it->contains(jd)) { ++n; --jd; }
+    return n;
+}
+
+int HabitEngine::longestStreak(const QString& habit) const
+{
+    const auto it = m_done.constFind(habit);
+    if (it == m_done.constEnd()) return 0;
+
+    int best = 0;
+    for (qint64 jd : *it) {
+        if (it->contains(jd - 1)) continue;   // not the start of a run
+        int n = 0;
+        while (it->contains(jd + n)) ++n;
+        best = std::max(best, n);
+    }
+    return best;
+}
+
+// ============================================================================
+// Placement
+// ============================================================================
+
+/**
+ * @brief bestOnDay
+ * Best window of @day for @h, or day = -1 if nothing fits (length, cap).
+ * Score: PlannerWeights habit terms (window length, anchor hit/miss, priority).
+ */
+HabitEngine::Choice HabitEngine::bestOnDay(int day, const SuperAI::Habit& h) const
+{
+    Choice best;
+    const int need = std::max(1, h.targetMinPerDay);
+    if (m_used[day] + need > m_dailyCapMin) return best;
+
+    const auto [aFrom, aTo] = anchorHours(h.anchor);
+    const auto& ws = m_windows[day];
+    for (int i = 0; i < ws.size(); ++i) {
+        const int len = minutesOf(ws[i].start, ws[i].end);
+        if (len < need) continue;
+
+        // Start inside the anchor range when the window reaches into it
+        QDateTime s = ws[i].start;
+        bool hit = aFrom < 0;
+        if (aFrom >= 0) {
+            const QDate d = s.date();
+            const QDateTime a = QDateTime(d, QTime(aFrom, 0));
+            const QDateTime b = aTo >= 24 ? d.addDays(1).startOfDay() : QDateTime(d, QTime(aTo, 0));
+            const QDateTime cand = std::max(s, a);
+            if (cand < b && minutesOf(cand, ws[i].end) >= need) { s = cand; hit = true; }
+        }
+
+        double sc = m_w.habitLength * (len / 60.0);
+        if (aFrom >= 0) sc += hit ? m_w.habitAnchorHit : -m_w.habitAnchorMiss;
+        sc += m_w.habitPriority * ((h.priority - 1) / 4.0);
+
+        if (sc > best.score) { best.day = day; best.window = i; best.start = s; best.score = sc; }
+    }
+    return best;
+}
+
+void HabitEngine::carve(int day, int window, const QDateTime& s, const QDateTime& e)
+{
+    auto& ws = m_windows[day];
+    const SuperAI::Slot w = ws[window];
+    ws.removeAt(window);
+    // Keep the remainders in order (tail first so the head lands before it)
+    if (e < w.end)   ws.insert(window, { e, w.end });
+    if (w.start < s) ws.insert(window, { w.start, s });
+    m_used[day] += minutesOf(s, e);
+}
+
+int HabitEngine::addHabit(const SuperAI::Habit& h)
+{
+    QVector<Choice> choices;
+    for (int d = 0; d < m_windows.size(); ++d) {
+        const Choice c = bestOnDay(d, h);
+        if (c.day >= 0) choices.push_back(c);
+    }
+
+    // Fewer days than offered: keep the best-scoring ones, earlier days on ties
+    const int want = std::min<int>(std::clamp(h.daysPerWeek, 0, 7), m_windows.size());
+    if (choices.size() < want)
+        m_unplaced << QString("%1 (%2 of %3 days)").arg(h.title).arg(choices.size()).arg(want);
+    std::stable_sort(choices.begin(), choices.end(), [](const Choice& a, const Choice& b){
+        return a.score > b.score;
+    });
+    if (choices.size() > want) choices.resize(want);
+
+    for (const Choice& c : choices) {
+        const QDateTime e = c.start.addSecs(qint64(std::max(1, h.targetMinPerDay)) * 60);
+        carve(c.day, c.window, c.start, e);
+        m_placed.push_back({ h.title, c.start, e });
+    }
+    return choices.size();
+}
+
+int HabitEngine::addHabits(QVector<SuperAI::Habit> habits)
+{
+    std::stable_sort(habits.begin(), habits.end(), [this](const SuperAI::Habit& a, const SuperAI::Habit& b){
+        if (a.priority != b.priority) return a.priority > b.priority;
+        return currentStreak(a.title) > currentStreak(b.title);
+    });
+    int n = 0;
+    for (const auto& h : habits) n += addHabit(h);
+    return n;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include "Event.h"
+#include "PlannerWeights.h"
+#include "SuperAI.h"
+
+/**
+ * @brief HabitEngine
+ * Places habits across a span of days (typically a week) into free windows.
+ *
+ * The engine keeps a per-day free-window index. addHabit() scores the
+ * windows of each day, carves the chosen block out of its window and updates
+ * the index in place, so each added habit costs O(days × windows) and never
+ * recomputes windows from events.
+ *
+ * Rules
+ *  - a block needs a window of at least targetMinPerDay (no partial blocks)
+ *  - at most one block per habit per day, Habit::daysPerWeek days in total
+ *    (the best-scoring days win)
+ *  - habit minutes per day are capped by dailyCapMin
+ *  - anchors bias the choice of window and the start inside it
+ *    (morning 07–11, after-lunch 12–15, evening 17+)
+ *
+ * Streaks come from completed history: a day counts when it has a past
+ * "🟢 <habit>" block. Habits are placed by priority, then longest current
+ * streak, so an active streak gets first pick of the windows.
+ */
+class HabitEngine {
+public:
+    struct Placement {
+        QString   habit;
+        QDateTime start;
+        QDateTime end;
+    };
+
+    explicit HabitEngine(const PlannerWeights& w = {}) : m_w(w) {}
+
+    /// Start over with @windows per day, beginning at @first (one entry per day).
+    void reset(const QDate& first, const QVector<QVector<SuperAI::Slot>>& windows);
+
+    void setDailyCap(int minutes) { m_dailyCapMin = minutes; }
+    int  dailyCap() const         { return m_dailyCapMin; }
+
+    /// Completed habit blocks before @today (titles "🟢 <habit>").
+    void setHistory(const QVector<Event>& history, const QDate& today);
+
+    /// Consecutive completed days ending today (or yesterday, if today is still open).
+    int currentStreak(const QString& habit) const;
+    int longestStreak(const QString& habit) const;
+
+    /// Place one habit; returns how many days got a block.
+    int addHabit(const SuperAI::Habit& h);
+
+    /// Place several, ordered by priority ↓ then current streak ↓.
+    int addHabits(QVector<SuperAI::Habit> habits);
+
+    const QVector<Placement>& placements() const { return m_placed; }
+    QStringList               unplaced()   const { return m_unplaced; }   ///< "habit (k of n days)"
+
+    int days() const { return m_windows.size(); }
+    const QVector<SuperAI::Slot>& windows(int day) const { return m_windows[day]; }
+    int usedMinutes(int day) const { return m_used.value(day); }
+
+private:
+    struct Choice { int day = -1, window = -1; QDateTime start; double score = -1e9; };
+
+    Choice bestOnDay(int day, const SuperAI::Habit& h) const;
+    void   carve(int day, int window, const QDateTime& s, const QDateTime& e);
+
+    PlannerWeights                  m_w;
+    int                             m_dailyCapMin = 120;
+    QDate                           m_first;
+    QVector<QVector<SuperAI::Slot>> m_windows;   ///< free-window index, sorted per day
+    QVector<int>                    m_used;      ///< habit minutes per day
+    QVector<Placement>              m_placed;
+    QStringList                     m_unplaced;
+
+    QDate                           m_today;
+    QHash<QString, QSet<qint64>>    m_done;      ///< habit → Julian days completed
+};
@@ -0,0 +1,207 @@
+#include "JobScheduler.h"
+
+#include <QMetaObject>
+#include <algorithm>  // std::max
+
+// Index of the worker running on this thread; -1 elsewhere (GUI thread, other pools)
+static thread_local int t_worker = -1;
+static thread_local const JobScheduler* t_owner = nullptr;
+
+JobScheduler::JobScheduler(int threads, QObject* parent)
+    : QObject(parent)
+{
+    m_clock.start();
+    const int n = threads > 0 ? threads : std::max(2, QThread::idealThreadCount());
+    for (int i = 0; i < n; ++i) m_workers.push_back(std::make_unique<Worker>());
+    for (int i = 0; i < n; ++i) {
+        m_workers[i]->thread = QThread::create([this, i] { workerLoop(i); });
+        m_workers[i]->thread->setObjectName(QString("JobScheduler-%1").arg(i));
+        m_workers[i]->thread->start();
+    }
+}
+
+JobScheduler::~JobScheduler()
+{
+    m_stop.storeRelaxed(1);
+    {
+        QMutexLocker lock(&m_sleepMutex);
+        m_wake.wakeAll();
+    }
+    for (auto& w : m_workers) {
+        w->thread->wait();
+        delete w->thread;
+    }
+}
+
+const char* JobScheduler::className(Priority prio)
+{
+    switch (prio) {
+    case Priority::Interactive: return "interactive";
+    case Priority::Prefetch:    return "prefetch";
+    case Priority::Batch:       return "batch";
+    }
+    return "?";
+}
+
+// ============================================================================
+// Submission and dependencies
+// ============================================================================
+
+JobScheduler::JobId JobScheduler::submit(Priority prio, Work work, Options opts)
+{
+    auto job   = std::make_shared<Job>();
+    job->id    = ++m_nextId;
+    job->prio  = prio;
+    job->work  = std::move(work);
+    job->opts  = std::move(opts);
+
+    bool ready = false;
+    {
+        QMutexLocker lock(&m_graphMutex);
+        for (JobId dep : job->opts.after) {
+            const auto it = m_live.constFind(dep);
+            if (it == m_live.constEnd()) continue;   // already finished
+            (*it)->dependents.push_back(job->id);
+            ++job->waitingOn;
+        }
+        m_live.insert(job->id, job);
+        ready = job->waitingOn == 0;
+        if (!ready) m_stats[int(prio)].blocked.ref();
+    }
+    if (ready) enqueue(job);
+    return job->id;
+}
+
+void JobScheduler::enqueue(const JobPtr& job)
+{
+    job->readyNs = m_clock.nsecsElapsed();
+    const int n = int(m_workers.size());
+    const int w = (t_owner == this && t_worker >= 0) ? t_worker
+                                                     : int(quint32(m_nextWorker.fetchAndAddRelaxed(1)) % n);
+    {
+        QMutexLocker lock(&m_workers[w]->mutex);
+        m_workers[w]->queues[int(job->prio)].push_back(job);
+    }
+    m_stats[int(job->prio)].ready.ref();
+    m_queued.ref();
+
+    QMutexLocker lock(&m_sleepMutex);
+    m_wake.wakeOne();
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+/**
+ * @brief take
+ * Highest class first; within a class the worker's own oldest job, else
+ * the newest job of another worker (thieves take the other end).
+ */
+JobScheduler::JobPtr JobScheduler::take(int self)
+{
+    const int n = int(m_workers.size());
+    for (int c = 0; c < kClasses; ++c) {
+        for (int k = 0; k < n; ++k) {
+            const int w = (self + k) % n;
+            Worker& wk = *m_workers[w];
+            QMutexLocker lock(&wk.mutex);
+            auto& q = wk.queues[c];
+            if (q.empty()) continue;
+            JobPtr job;
+            if (k == 0) { job = q.front(); q.pop_front(); }
+            else        { job = q.back();  q.pop_back();  }
+            m_queued.deref();
+            m_stats[c].ready.deref();
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobScheduler::workerLoop(int self)
+{
+    t_worker = self;
+    t_owner  = this;
+    while (!m_stop.loadRelaxed()) {
+        if (JobPtr job = take(self)) { run(self, job); continue; }
+
+        // enqueue() counts the job before it takes m_sleepMutex to wake us, so
+        // a job queued after this check still wakes the wait below
+        QMutexLocker lock(&m_sleepMutex);
+        if (m_queued.loadRelaxed() == 0 && !m_stop.loadRelaxed())
+            m_wake.wait(&m_sleepMutex);
+    }
+}
+
+void JobScheduler::run(int self, const JobPtr& job)
+{
+    Q_UNUSED(self);
+    ClassStats& st = m_stats[int(job->prio)];
+    const qint64 start = m_clock.nsecsElapsed();
+    const bool cancelled = job->depCancelled || job->opts.token.isCancelled();
+
+    QVariant result;
+    if (!cancelled) {
+        st.running.ref();
+        result = job->work(job->opts.token);
+        st.running.deref();
+    }
+    const qint64 end = m_clock.nsecsElapsed();
+    const bool dropped = cancelled || job->opts.token.isCancelled();
+
+    {
+        QMutexLocker lock(&st.mutex);
+        const qint64 wait = start - job->readyNs;
+        st.waitNs   += wait;
+        st.waitMaxNs = std::max(st.waitMaxNs, wait);
+        if (!cancelled) st.runNs += end - start;
+    }
+    if (dropped) st.cancelled.ref(); else st.done.ref();
+
+    // Release dependents; a cancelled job cancels what was waiting for it
+    QVector<JobPtr> ready;
+    {
+        QMutexLocker lock(&m_graphMutex);
+        m_live.remove(job->id);
+        for (JobId id : std::as_const(job->dependents)) {
+            const auto it = m_live.constFind(id);
+            if (it == m_live.constEnd()) continue;
+            const JobPtr& dep = *it;
+            if (dropped) dep->depCancelled = true;
+            if (--dep->waitingOn == 0) {
+                m_stats[int(dep->prio)].blocked.deref();
+                ready.push_back(dep);
+            }
+        }
+    }
+    for (const JobPtr& r : ready) enqueue(r);
+
+    if (dropped) {
+        emit jobCancelled(job->id, job->prio);
+        return;
+    }
+    if (job->opts.done && job->opts.context)
+        QMetaObject::invokeMethod(job->opts.context.data(), [done = job->opts.done, result] {
+            done(result);
+        }, Qt::QueuedConnection);
+    emit jobFinished(job->id, job->prio);
+}
+
+JobScheduler::Stats JobScheduler::stats(Priority prio) const
+{
+    const ClassStats& st = m_stats[int(prio)];
+    Stats s;
+    s.ready     = st.ready.loadRelaxed();
+    s.blocked   = st.blocked.loadRelaxed();
+    s.running   = st.running.loadRelaxed();
+    s.done      = st.done.loadRelaxed();
+    s.cancelled = st.cancelled.loadRelaxed();
+
+    QMutexLocker lock(&st.mutex);
+    const quint64 started = s.done + s.cancelled;
+    if (started) s.avgWaitMs = st.waitNs / 1e6 / started;
+    if (s.done)  s.avgRunMs  = st.runNs  / 1e6 / s.done;
+    s.maxWaitMs = st.waitMaxNs / 1e6;
+    return s;
+}
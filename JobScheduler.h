@@ -0,0 +1,145 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QThread>
+#include <QVariant>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief JobScheduler
+ * Shared worker threads for everything that runs off the GUI thread
+ * (exports, forecasts, imports, prefetch), with priority classes,
+ * cancellation and dependencies.
+ *
+ * Scheduling
+ *  - Every worker has one deque per class. A job submitted from a worker
+ *    goes to that worker's deque; one submitted from any other thread is
+ *    dealt round-robin.
+ *  - A free worker takes the highest class that has work anywhere: its own
+ *    deque first (oldest job), then it steals from the back of the others.
+ *    An Interactive job never waits behind Batch work that is queued.
+ *    Running jobs are not pre-empted.
+ *
+ * Jobs
+ *  - A job may list jobs it runs after. It is queued once they have all
+ *    finished; if one of them was cancelled, it is cancelled too. Ids
+ *    that have already finished count as done.
+ *  - A job is skipped if its CancelToken is cancelled before it starts;
+ *    long jobs should poll the token themselves.
+ *  - The result goes to `done` on @context's thread through a queued
+ *    call, and jobFinished() / jobCancelled() are emitted the same way.
+ *
+ * Stats: per class, queue depth (ready and blocked), running jobs,
+ * done/cancelled counts, and wait (submit → start) and run times.
+ */
+class JobScheduler : public QObject {
+    Q_OBJECT
+public:
+    enum class Priority { Interactive, Prefetch, Batch };
+    Q_ENUM(Priority)
+    static constexpr int kClasses = 3;
+
+    using JobId = quint64;
+
+    /// Shared flag; copies cancel together.
+    class CancelToken {
+    public:
+        CancelToken() : m_flag(QSharedPointer<QAtomicInt>::create(0)) {}
+        void cancel() const          { m_flag->storeRelaxed(1); }
+        bool isCancelled() const     { return m_flag->loadRelaxed() != 0; }
+    private:
+        QSharedPointer<QAtomicInt> m_flag;
+    };
+
+    using Work = std::function<QVariant(const CancelToken&)>;
+
+    struct Options {
+        CancelToken       token;
+        QVector<JobId>    after;          ///< run once these are done
+        QPointer<QObject> context;        ///< thread (and lifetime) for @done
+        std::function<void(const QVariant&)> done;
+    };
+
+    struct Stats {
+        int     ready     = 0;   ///< queued and runnable
+        int     blocked   = 0;   ///< waiting for dependencies
+        int     running   = 0;
+        quint64 done      = 0;
+        quint64 cancelled = 0;
+        double  avgWaitMs = 0;   ///< submit (or unblock) → start
+        double  maxWaitMs = 0;
+        double  avgRunMs  = 0;
+    };
+
+    explicit JobScheduler(int threads = 0, QObject* parent = nullptr);   ///< 0 = ideal thread count
+    ~JobScheduler() override;
+
+    JobId submit(Priority prio, Work work, Options opts = {});
+
+    Stats stats(Priority prio) const;
+    int   threadCount() const { return int(m_workers.size()); }
+
+    static const char* className(Priority prio);
+
+signals:
+    void jobFinished(quint64 id, JobScheduler::Priority prio);
+    void jobCancelled(quint64 id, JobScheduler::Priority prio);
+
+private:
+    struct Job {
+        JobId            id = 0;
+        Priority         prio = Priority::Batch;
+        Work             work;
+        Options          opts;
+        int              waitingOn = 0;       ///< unfinished dependencies (m_graphMutex)
+        bool             depCancelled = false;
+        QVector<JobId>   dependents;          ///< (m_graphMutex)
+        qint64           readyNs = 0;         ///< when it became runnable
+    };
+    using JobPtr = std::shared_ptr<Job>;
+
+    struct Worker {
+        QMutex                                 mutex;
+        std::array<std::deque<JobPtr>, kClasses> queues;
+        QThread*                               thread = nullptr;
+    };
+
+    struct ClassStats {
+        QAtomicInt ready, blocked, running;
+        QAtomicInteger<quint64> done, cancelled;
+        mutable QMutex mutex;                 ///< guards the timing sums below
+        qint64  waitNs = 0, waitMaxNs = 0, runNs = 0;
+    };
+
+    void   enqueue(const JobPtr& job);
+    JobPtr take(int self);
+    void   run(int self, const JobPtr& job);
+    void   workerLoop(int self);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::array<ClassStats, kClasses>     m_stats;
+
+    QMutex                  m_graphMutex;     // m_live and Job::waitingOn/dependents
+    QHash<JobId, JobPtr>    m_live;           // submitted and not finished
+    QAtomicInteger<quint64> m_nextId{ 0 };
+    QAtomicInt              m_nextWorker{ 0 };
+
+    QMutex                  m_sleepMutex;
+    QWaitCondition          m_wake;
+    QAtomicInt              m_queued{ 0 };    // ready jobs across all deques
+    QAtomicInt              m_stop{ 0 };
+    QElapsedTimer           m_clock;
+};
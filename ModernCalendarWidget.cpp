@@ -13,6 +13,9 @@
 #include <QHoverEvent>
 #include <QModelIndex>
 #include <QCursor>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <algorithm>  // std::min, std::max
 
 /*
  * Helper: keep weekend cell text consistent with weekdays (no special colors).
@@ -32,6 +35,12 @@ static void applyWeekendAndHeaderColors(QCalendarWidget* cal,
     cal->setWeekdayTextFormat(Qt::Sunday,   fmt);
 }
 
+// Defined in "Grid helpers" below; the event filter needs it for tooltips.
+static inline QDate dateForIndex(QTableView* view,
+                                 const QModelIndex& idx,
+                                 int shownYear,
+                                 int shownMonth);
+
 /* ========================================================================== */
 /*  Header styling (weekday row)                                              */
 /* ========================================================================== */
@@ -222,10 +231,39 @@ bool ModernCalendarWidget::eventFilter(QObject* obj, QEvent* ev) {
 #endif
             return false;
         }
+        case QEvent::MouseButtonPress: {
+            // "+N" badge: open the overflow list instead of just selecting the day
+            if (!m_view) return false;
+#if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
+            const QPoint pos = static_cast<QMouseEvent*>(ev)->position().toPoint();
+#else
+            const QPoint pos = static_cast<QMouseEvent*>(ev)->pos();
+#endif
+            const QModelIndex idx = m_view->indexAt(pos);
+            const QDate d = idx.isValid() ? dateForIndex(m_view, idx, yearShown(), monthShown()) : QDate();
+            if (!d.isValid() || d.month() != monthShown() || d.year() != yearShown()) return false;
+            const auto l = CalendarPainter::dotsLayout(m_view->visualRect(idx), eventCount(d), font());
+            if (l.badge.isNull() || !l.badge.adjusted(-4, -4, 4, 4).contains(pos)) return false;
+            setSelectedDate(d);
+            m_selected = d;
+            emit overflowClicked(d, m_viewport->mapToGlobal(l.badge.bottomLeft()));
+            return true;
+        }
         case QEvent::Enter: {
             updateHoveredFromPos(m_viewport->mapFromGlobal(QCursor::pos()));
             return false;
         }
+        case QEvent::ToolTip: {
+            // Tooltip text comes from the owner's per-day cache; nothing on MouseMove.
+            if (!m_tipProvider || !m_view) return false;
+            auto *he = static_cast<QHelpEvent*>(ev);
+            const QModelIndex idx = m_view->indexAt(he->pos());
+            const QDate d = idx.isValid() ? dateForIndex(m_view, idx, yearShown(), monthShown()) : QDate();
+            const QString tip = d.isValid() ? m_tipProvider(d) : QString();
+            if (tip.isEmpty()) QToolTip::hideText();
+            else               QToolTip::showText(he->globalPos(), tip, m_viewport);
+            return true;
+        }
         case QEvent::Leave:
         case QEvent::HoverLeave: {
             if (m_hovered.isValid()) {
@@ -307,6 +345,21 @@ void ModernCalendarWidget::setEvents(const QList<Event>& evs)
     update();
 }
 
+void ModernCalendarWidget::setDayCells(const QDate& first, const QVector<DayCell>& cells)
+{
+    m_cellsFirst = first;
+    m_cells      = cells;
+    if (m_viewport) m_viewport->update();
+    else            update();
+}
+
+const DayCell* ModernCalendarWidget::cellFor(const QDate& d) const
+{
+    if (!m_cellsFirst.isValid()) return nullptr;
+    const qint64 i = m_cellsFirst.daysTo(d);
+    return (i >= 0 && i < m_cells.size()) ? &m_cells[int(i)] : nullptr;
+}
+
 void ModernCalendarWidget::applyHeaderStyleForTheme(bool light) {
     m_light = light;
     ensureHeaderStyled();
@@ -340,6 +393,7 @@ void ModernCalendarWidget::wheelEvent(QWheelEvent* e) {
 }
 
 void ModernCalendarWidget::keyPressEvent(QKeyEvent* e) {
+    m_keyRepeat = e->isAutoRepeat();
     switch (e->key()) {
     case Qt::Key_Left:    setSelectedDate(selectedDate().addDays(-1)); break;
     case Qt::Key_Right:   setSelectedDate(selectedDate().addDays(+1)); break;
@@ -355,6 +409,15 @@ void ModernCalendarWidget::keyPressEvent(QKeyEvent* e) {
     update();
 }
 
+void ModernCalendarWidget::keyReleaseEvent(QKeyEvent* e) {
+    // Auto-repeat generates release/press pairs; only the real release ends navigation.
+    if (!e->isAutoRepeat() && m_keyRepeat) {
+        m_keyRepeat = false;
+        emit navigationSettled();
+    }
+    QCalendarWidget::keyReleaseEvent(e);
+}
+
 void ModernCalendarWidget::setCurrentMonth(const QDate& anyDayInMonth) {
     m_month = QDate(anyDayInMonth.year(), anyDayInMonth.month(), 1);
     setCurrentPage(m_month.year(), m_month.month());
@@ -403,11 +466,7 @@ void ModernCalendarWidget::paintCell(QPainter* p, const QRect& rect, QDate date)
     // Day number in the top-left; dim spillover days
     QColor dayFg = palette().color(QPalette::Text);
     if (!inMonth) dayFg = QColor(light ? "#c7c9ce" : "#5a6168");
-    p->setPen(dayFg);
-    QFont f = p->font(); f.setBold(true); p->setFont(f);
-    p->drawText(rect.adjusted(10, 6, -10, -6),
-                Qt::AlignLeft | Qt::AlignTop,
-                QString::number(date.day()));
+    CalendarPainter::drawDayNumber(*p, rect, date.day(), dayFg);
 
     // Event glyphs/chips (only for current-month cells to avoid clutter)
     if (inMonth) {
@@ -422,54 +481,28 @@ void ModernCalendarWidget::paintCell(QPainter* p, const QRect& rect, QDate date)
 /*  Per-cell event adornments                                                  */
 /* ========================================================================== */
 
-void ModernCalendarWidget::drawEventsDots(QPainter& p, const QRect& cell, const QDate& d) const {
+int ModernCalendarWidget::eventCount(const QDate& d) const {
+    if (const DayCell* c = cellFor(d)) return c->count;
     int count = 0;
     for (const Event& e : m_events)
         if (e.isOnDate(d)) ++count;
-    if (!count) return;
-
-    const int dotR = 3;
-    const int gap  = 6;
-    const int totalW = count*dotR*2 + (count-1)*gap;
-    int x = cell.center().x() - totalW/2;
-    int y = cell.top() + 26;
-
-    p.setPen(Qt::NoPen);
-    p.setBrush(QColor(180,170,255));
-    for (int i=0;i<count;++i)
-        p.drawEllipse(QPoint(x + i*(2*dotR+gap), y), dotR, dotR);
+    return count;
 }
 
-void ModernCalendarWidget::drawEventChips(QPainter& p, const QRect& cell, const QDate& d) const {
-    QStringList titles;
-    for (const Event& e : m_events)
-        if (e.isOnDate(d)) titles << e.getTitle();
-    if (titles.isEmpty()) return;
-
-    const int maxChips = qMin(2, titles.size());
-    const int chipH = 18;
-    int y = cell.bottom() - 6 - maxChips * (chipH + 4);
-
-    QFont f = p.font();
-    f.setBold(false);
-    p.setFont(f);
-
-    for (int i = 0; i < maxChips; ++i) {
-        QRect r = cell.adjusted(6, y - cell.top(), -6, 0);
-        r.setHeight(chipH);
-
-        QFontMetrics fm(p.font());
-        const QString txt = fm.elidedText(titles[i], Qt::ElideRight, r.width() - 12); // 6px padding each side
-
-        p.setPen(Qt::NoPen);
-        p.setBrush(QColor(140, 70, 255));
-        p.drawRoundedRect(r, 6, 6);
-
-        p.setPen(QColor(250, 250, 255));
-        p.drawText(r.adjusted(6, 0, -6, 0), Qt::AlignVCenter | Qt::AlignLeft, txt);
+void ModernCalendarWidget::drawEventsDots(QPainter& p, const QRect& cell, const QDate& d) const {
+    CalendarPainter::drawDots(p, cell, eventCount(d), font());
+}
 
-        y += chipH + 4;
+void ModernCalendarWidget::drawEventChips(QPainter& p, const QRect& cell, const QDate& d) const {
+    QStringList    titles;
+    QVector<QColor> colors;
+    if (const DayCell* c = cellFor(d)) {
+        for (const auto& chip : c->chips) { titles << chip.title; colors << chip.color; }
+    } else {
+        for (const Event& e : m_events)
+            if (e.isOnDate(d)) titles << e.getTitle();
     }
+    CalendarPainter::drawChips(p, cell, titles, colors);
 }
 
 /* ========================================================================== */
@@ -12,7 +12,11 @@
 #include <QTimer>
 #include <QTableView>
 
+#include <functional>
+
 #include "Event.h"
+#include "CalendarLayers.h"   // DayCell
+#include "CalendarPainter.h"  // cell drawing shared with CalendarExporter
 
 class ModernCalendarWidget : public QCalendarWidget {
     Q_OBJECT
@@ -22,13 +26,26 @@ public:
     void setEvents(const QList<Event>& evs);
     const QList<Event>& events() const { return m_events; }
 
+    // Pre-composed per-day adornments for [first, first + cells.size()).
+    // When set, painting reads these instead of scanning events().
+    void setDayCells(const QDate& first, const QVector<DayCell>& cells);
+
+    // Hover text for a cell; only consulted on QEvent::ToolTip.
+    void setToolTipProvider(std::function<QString(const QDate&)> fn) { m_tipProvider = std::move(fn); }
+
     void setCurrentMonth(const QDate& anyDayInMonth);
     void applyHeaderStyleForTheme(bool light);
     void scheduleRestyle();
 
+    // True while an arrow key is held down (auto-repeat); expensive per-day
+    // work should wait for navigationSettled().
+    bool isKeyRepeating() const { return m_keyRepeat; }
+
 signals:
     void dateSelected(const QDate& date);
     void monthChanged(const QDate& firstOfMonth);
+    void navigationSettled();   // held arrow key released
+    void overflowClicked(const QDate& date, const QPoint& globalPos);   // "+N" badge under the dots
 
 protected:
     void paintCell(QPainter* p, const QRect& rect, QDate date) const override;
@@ -36,6 +53,7 @@ protected:
     void mousePressEvent(QMouseEvent* e) override;
     void wheelEvent(QWheelEvent* e) override;
     void keyPressEvent(QKeyEvent* e) override;
+    void keyReleaseEvent(QKeyEvent* e) override;
     void showEvent(QShowEvent* e) override;
     bool eventFilter(QObject* obj, QEvent* ev) override;
     void resizeEvent(QResizeEvent* e) override;
@@ -47,9 +65,11 @@ private:
     void updateHoveredFromPos(const QPoint& vp);
     QModelIndex indexForDate(const QDate& d) const;  // ← keep it here
 
-    // optional custom draw helpers
+    // optional custom draw helpers (shared with offscreen export via CalendarPainter)
+    int        eventCount(const QDate& d) const;
     void drawEventsDots(QPainter& p, const QRect& cell, const QDate& d) const;
     void drawEventChips(QPainter& p, const QRect& cell, const QDate& d) const;
+    const DayCell* cellFor(const QDate& d) const;
     void restyleNow();
 
     // cached internals
@@ -62,6 +82,10 @@ private:
     QDate m_month;
     QDate m_selected;
     QDate m_hovered;
+    bool  m_keyRepeat = false;
     QList<Event> m_events;
+    QDate            m_cellsFirst;   // first date covered by m_cells
+    QVector<DayCell> m_cells;
     QTimer* m_restyleTimer = nullptr;
+    std::function<QString(const QDate&)> m_tipProvider;
 };
@@ -0,0 +1,245 @@
+#include "PlannerRecorder.h"
+
+#include <QDataStream>
+#include <QTimeZone>
+#include <limits>
+
+static constexpr quint32 kRecMagic   = 0x45504c52; // "EPLR"
+static constexpr quint32 kRecVersion = 2;
+
+enum RecordKind : quint8 { PlanRecord = 0, CommittedRecord = 1 };
+
+// ---- field codecs -----------------------------------------------------------
+
+qint64 PlannerRecorder::toWallMs(const QDateTime& dt)
+{
+    if (!dt.isValid()) return std::numeric_limits<qint64>::min();
+    return dt.toMSecsSinceEpoch() + qint64(dt.offsetFromUtc()) * 1000;
+}
+
+QDateTime PlannerRecorder::fromWallMs(qint64 ms)
+{
+    if (ms == std::numeric_limits<qint64>::min()) return {};
+    const QDateTime utc = QDateTime::fromMSecsSinceEpoch(ms, QTimeZone::UTC);
+    return QDateTime(utc.date(), utc.time());   // same wall clock, local zone
+}
+
+static void writeEvents(QDataStream& ds, const QVector<Event>& evs)
+{
+    ds << qint32(evs.size());
+    for (const Event& e : evs)
+        ds << e.getTitle() << e.getDescription()
+           << PlannerRecorder::toWallMs(e.getStartTime())
+           << PlannerRecorder::toWallMs(e.getEndTime())
+           << quint32(e.getColor().rgba());
+}
+
+static QVector<Event> readEvents(QDataStream& ds)
+{
+    qint32 n = 0; ds >> n;
+    QVector<Event> evs;
+    for (qint32 i = 0; i < n && ds.status() == QDataStream::Ok; ++i) {
+        QString title, desc; qint64 s = 0, e = 0; quint32 rgba = 0;
+        ds >> title >> desc >> s >> e >> rgba;
+        evs.push_back(Event(title, desc, PlannerRecorder::fromWallMs(s),
+                            PlannerRecorder::fromWallMs(e), QColor::fromRgba(rgba)));
+    }
+    return evs;
+}
+
+static void writeTasks(QDataStream& ds, const QVector<SuperAI::Task>& ts)
+{
+    ds << qint32(ts.size());
+    for (const auto& t : ts)
+        ds << t.id << t.title << qint32(t.estimateMin) << qint32(t.priority)
+           << PlannerRecorder::toWallMs(t.deadline)
+           << t.mustMorning << t.mustAfternoon << t.flexible << t.splitOK
+           << qint32(t.maxChunkMin) << t.notes;
+}
+
+static QVector<SuperAI::Task> readTasks(QDataStream& ds)
+{
+    qint32 n = 0; ds >> n;
+    QVector<SuperAI::Task> ts;
+    for (qint32 i = 0; i < n && ds.status() == QDataStream::Ok; ++i) {
+        SuperAI::Task t; qint32 est = 0, pr = 0, chunk = 0; qint64 dl = 0;
+        ds >> t.id >> t.title >> est >> pr >> dl
+           >> t.mustMorning >> t.mustAfternoon >> t.flexible >> t.splitOK
+           >> chunk >> t.notes;
+        t.estimateMin = est; t.priority = pr; t.maxChunkMin = chunk;
+        t.deadline = PlannerRecorder::fromWallMs(dl);
+        ts.push_back(t);
+    }
+    return ts;
+}
+
+static void writeHabits(QDataStream& ds, const QVector<SuperAI::Habit>& hs)
+{
+    ds << qint32(hs.size());
+    for (const auto& h : hs)
+        ds << h.title << qint32(h.targetMinPerDay) << h.anchor << qint32(h.priority);
+}
+
+static QVector<SuperAI::Habit> readHabits(QDataStream& ds)
+{
+    qint32 n = 0; ds >> n;
+    QVector<SuperAI::Habit> hs;
+    for (qint32 i = 0; i < n && ds.status() == QDataStream::Ok; ++i) {
+        SuperAI::Habit h; qint32 target = 0, pr = 0;
+        ds >> h.title >> target >> h.anchor >> pr;
+        h.targetMinPerDay = target; h.priority = pr;
+        hs.push_back(h);
+    }
+    return hs;
+}
+
+
+// ============================================================================
+// PlannerRecorder
+// ============================================================================
+
+PlannerRecorder::PlannerRecorder(const QString& path)
+    : m_path(path), m_file(path)
+{
+    if (!m_file.open(QIODevice::ReadWrite)) return;
+    if (m_file.size() > 0) {
+        QDataStream in(&m_file);
+        quint32 magic = 0, version = 0;
+        in >> magic >> version;
+        if (magic != kRecMagic || version != kRecVersion) {
+            // Older layout: keep it (the tools still read it) and start a new file
+            m_file.close();
+            QFile::remove(path + ".old");
+            QFile::rename(path, path + ".old");
+            if (!m_file.open(QIODevice::ReadWrite)) return;
+        } else {
+            // Walk the records and drop a partial one (crash mid-write);
+            // appending behind it would hide every later record from load()
+            qint64 good = m_file.pos();   // end of the last complete record
+            while (!in.atEnd()) {
+                quint32 len = 0; in >> len;
+                if (in.status() != QDataStream::Ok || qint64(len) > m_file.size() - m_file.pos()) break;
+                m_file.seek(m_file.pos() + len);
+                good = m_file.pos();
+            }
+            if (good < m_file.size() && !m_file.resize(good)) { m_file.close(); return; }
+        }
+    }
+    if (m_file.size() == 0) {
+        QDataStream ds(&m_file);
+        ds << kRecMagic << kRecVersion;
+    }
+    m_file.seek(m_file.size());
+}
+
+bool PlannerRecorder::isPlannerBlock(const Event& e)
+{
+    const QString& t = e.getTitle();
+    return t.startsWith(QStringLiteral("🔵 ")) || t.startsWith(QStringLiteral("🟢 "));
+}
+
+bool PlannerRecorder::record(const Session& s)
+{
+    if (!isOpen()) return false;
+    m_planned.insert(s.day);
+
+    QByteArray raw;
+    {
+        QDataStream ds(&raw, QIODevice::WriteOnly);
+        ds.setVersion(QDataStream::Qt_6_0);
+        ds << quint8(PlanRecord);
+        ds << qint64(s.day.toJulianDay()) << toWallMs(s.now) << s.settings;
+        writeEvents(ds, s.existing);
+        writeTasks(ds, s.tasks);
+        writeHabits(ds, s.habits);
+        writeEvents(ds, s.output);
+        ds << s.elapsedNs;
+    }
+    return append(raw);
+}
+
+bool PlannerRecorder::recordCommitted(const QDate& day, const QVector<Event>& blocks)
+{
+    if (!isOpen()) return false;
+
+    QByteArray body;
+    {
+        QDataStream ds(&body, QIODevice::WriteOnly);
+        ds.setVersion(QDataStream::Qt_6_0);
+        writeEvents(ds, blocks);
+    }
+    const auto last = m_lastCommitted.constFind(day);
+    if (last == m_lastCommitted.constEnd() ? blocks.isEmpty() : *last == body) return true;
+    m_lastCommitted.insert(day, body);
+
+    QByteArray raw;
+    {
+        QDataStream ds(&raw, QIODevice::WriteOnly);
+        ds.setVersion(QDataStream::Qt_6_0);
+        ds << quint8(CommittedRecord) << qint64(day.toJulianDay());
+    }
+    return append(raw + body);
+}
+
+bool PlannerRecorder::append(const QByteArray& raw)
+{
+    const QByteArray packed = qCompress(raw);
+
+    QDataStream out(&m_file);
+    out << quint32(packed.size());
+    out.writeRawData(packed.constData(), packed.size());
+    return m_file.flush() && out.status() == QDataStream::Ok;
+}
+
+QVector<PlannerRecorder::Session> PlannerRecorder::load(const QString& path, QString* error,
+                                                       QVector<Committed>* committed)
+{
+    QVector<Session> sessions;
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (error) *error = f.errorString();
+        return sessions;
+    }
+
+    QDataStream in(&f);
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+    if (magic != kRecMagic || version < 1 || version > kRecVersion) {
+        if (error) *error = "not a planner recording (or unsupported version)";
+        return sessions;
+    }
+
+    while (!in.atEnd()) {
+        quint32 len = 0; in >> len;
+        QByteArray packed(int(len), Qt::Uninitialized);
+        if (in.readRawData(packed.data(), int(len)) != int(len)) break;   // truncated tail
+
+        QDataStream ds(qUncompress(packed));
+        ds.setVersion(QDataStream::Qt_6_0);
+        quint8 kind = PlanRecord;
+        if (version >= 2) ds >> kind;
+        if (kind == CommittedRecord) {
+            Committed c; qint64 jd = 0;
+            ds >> jd;
+            c.day          = QDate::fromJulianDay(jd);
+            c.afterSession = sessions.size();
+            c.blocks       = readEvents(ds);
+            if (ds.status() != QDataStream::Ok) break;
+            if (committed) committed->push_back(c);
+            continue;
+        }
+
+        Session s; qint64 jd = 0, now = 0;
+        ds >> jd >> now >> s.settings;
+        s.day      = QDate::fromJulianDay(jd);
+        s.now      = fromWallMs(now);
+        s.existing = readEvents(ds);
+        s.tasks    = readTasks(ds);
+        s.habits   = readHabits(ds);
+        s.output   = readEvents(ds);
+        ds >> s.elapsedNs;
+        if (ds.status() != QDataStream::Ok) break;
+        sessions.push_back(s);
+    }
+    return sessions;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+
+#include "Event.h"
+#include "SuperAI.h"
+
+/**
+ * @brief PlannerRecorder
+ * Append-only log of SuperAI::planDay() calls for offline replay/profiling.
+ *
+ * File layout
+ *   "EPLR" magic + version, then one record per planDay() or commit:
+ *   [quint32 length][qCompress(QDataStream payload)]
+ *   The payload starts with a kind byte (version 2; version 1 files hold
+ *   plan records only).
+ *
+ * A plan record holds everything the planner reads (day, injected "now",
+ * settings, existing events, tasks, habits) plus what it produced and how
+ * long it took. Times are stored as local wall-clock milliseconds, so a
+ * session replays the same way in any time zone.
+ *
+ * A committed record holds the planner blocks the user has in the calendar
+ * for a day that was planned (accepted suggestions, after any edits). It is
+ * written whenever that set changes and is the tuner's ground truth.
+ *
+ * Notes
+ *  - Only titles, times, colours and descriptions of events are kept.
+ *  - A truncated last record (crash mid-write) is ignored by load().
+ */
+class PlannerRecorder {
+public:
+    struct Session {
+        QDate                   day;
+        QDateTime               now;        ///< clock value the planner used
+        QVariantMap             settings;   ///< planner knobs in effect
+        QVector<Event>          existing;
+        QVector<SuperAI::Task>  tasks;      ///< after pool substitution
+        QVector<SuperAI::Habit> habits;     ///< after pool substitution
+        QVector<Event>          output;
+        qint64                  elapsedNs = 0;
+    };
+
+    struct Committed {
+        QDate          day;
+        int            afterSession = 0;   ///< plan sessions before it in the same file
+        QVector<Event> blocks;             ///< planner blocks on @day in the calendar
+    };
+
+    /// Opens (or creates) @path for appending.
+    explicit PlannerRecorder(const QString& path);
+
+    bool isOpen() const { return m_file.isOpen(); }
+    const QString& path() const { return m_path; }
+
+    /// Append one session; flushed immediately.
+    bool record(const Session& s);
+
+    /// Append @day's planner blocks if they differ from the last ones written.
+    bool recordCommitted(const QDate& day, const QVector<Event>& blocks);
+
+    /// Days planned through this recorder (candidates for recordCommitted()).
+    const QSet<QDate>& plannedDays() const { return m_planned; }
+
+    /// Read every complete session in @path (and, if asked, the committed records).
+    static QVector<Session> load(const QString& path, QString* error = nullptr,
+                                 QVector<Committed>* committed = nullptr);
+
+    /// Event produced by the planner ("🔵 task" / "🟢 habit").
+    static bool isPlannerBlock(const Event& e);
+
+    /// Local wall-clock ms ↔ QDateTime (time-zone independent encoding).
+    static qint64    toWallMs(const QDateTime& dt);
+    static QDateTime fromWallMs(qint64 ms);
+
+private:
+    bool append(const QByteArray& raw);
+
+    QString m_path;
+    QFile   m_file;
+    QSet<QDate>               m_planned;
+    QHash<QDate, QByteArray>  m_lastCommitted;   // serialized blocks last written per day
+};
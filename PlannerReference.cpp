@@ -0,0 +1,284 @@
+#include "PlannerReference.h"
+#include <QTime>
+#include <algorithm>  // std::sort, std::min, std::max, std::clamp
+#include <cmath>      // std::abs
+
+// Same palette/helpers as SuperAI.cpp and UltraDashboardRender.cpp
+static QColor kTaskBlue()    { return QColor("#2f6feb"); }
+static QColor kBufferGray()  { return QColor("#9aa3ab"); }
+
+static int minutesBetween(const QDateTime& s, const QDateTime& e) {
+    return std::max(0, int(s.secsTo(e) / 60));
+}
+
+static Event mkEvent(const QString& title, const QDateTime& s, const QDateTime& e, const QColor& c) {
+    return Event(title, title, s, e, c);
+}
+
+static inline QString mmLocal(int minutes){
+    if (minutes <= 0) return "0m";
+    const int h = minutes/60, m = minutes%60;
+    if (h && m) return QString("%1h %2m").arg(h).arg(m);
+    if (h) return QString("%1h").arg(h);
+    return QString("%1m").arg(m);
+}
+
+// Parses the packed description (independent of Event's category()/notes() split)
+static inline QString descCategory(const Event& e) {
+    const QString d = e.getDescription();
+    const int i = d.indexOf("::");
+    return (i < 0 ? d : d.left(i)).trimmed();
+}
+
+static inline bool isMeetingTitle(const QString& t){
+    const QString s = t.toLower();
+    return s.contains("meeting") || s.contains("standup") || s.contains("sync")
+        || s.contains("review")  || s.contains("1:1")     || s.contains("retro")
+        || s.contains("interview");
+}
+
+
+// ============================================================================
+// Planner
+// ============================================================================
+
+QVector<PlannerReference::Slot> PlannerReference::freeWindows(const QDate& day,
+                                                              const QVector<Event>& busy,
+                                                              int minBlockMin) {
+    const QDateTime dayStart(day, QTime(6,0));
+    const QDateTime dayEnd  (day, QTime(22,0));
+
+    struct Seg { QDateTime s,e; };
+    QVector<Seg> segs;
+
+    for (const auto& e : busy) {
+        const QDateTime s = e.getStartTime();
+        const QDateTime t = e.getEndTime();
+        if (s.date() > day || t.date() < day) continue;
+
+        const QDateTime clampedS = std::max(dayStart, s);
+        const QDateTime clampedE = std::min(dayEnd,   t);
+        if (clampedS < clampedE)
+            segs.push_back({clampedS, clampedE});
+    }
+
+    std::sort(segs.begin(), segs.end(), [](const Seg& a, const Seg& b){ return a.s < b.s; });
+
+    QVector<Seg> merged;
+    for (const auto& s : segs) {
+        if (merged.isEmpty() || s.s > merged.back().e) merged.push_back(s);
+        else merged.back().e = std::max(merged.back().e, s.e);
+    }
+
+    QVector<Slot> freeSlots;
+    QDateTime cur = dayStart;
+
+    for (const auto& m : merged) {
+        if (cur < m.s && minutesBetween(cur, m.s) >= minBlockMin)
+            freeSlots.push_back({cur, m.s});
+        cur = std::max(cur, m.e);
+    }
+
+    if (cur < dayEnd && minutesBetween(cur, dayEnd) >= minBlockMin)
+        freeSlots.push_back({cur, dayEnd});
+
+    return freeSlots;
+}
+
+double PlannerReference::slotScore(const Slot& window, const Task& t, const QDateTime& now) {
+    const int durMin = minutesBetween(window.start, window.end);
+    if (durMin < 15) return -1e9;
+
+    const int h = window.start.time().hour();
+
+    double circ = 0.0;
+    if (t.mustMorning)    circ += (h>=7  && h<=12) ? 1.0 : -0.3;
+    if (t.mustAfternoon)  circ += (h>=13 && h<=17) ? 1.0 : -0.3;
+
+    double urgency = 0.0;
+    if (t.deadline.isValid()) {
+        const int minsLeft = int(now.secsTo(t.deadline)/60);
+        urgency = std::clamp(1.0 - (minsLeft / (60.0*24*7.0)), 0.0, 1.0);
+    }
+
+    const double early  = 1.0 / std::max(1.0, double(now.secsTo(window.start))/3600.0);
+    const double length = std::min(1.0, durMin / 120.0);
+
+    const double pr = (t.priority - 1) / 4.0;
+
+    return 1.8*pr + 1.4*urgency + 0.8*circ + 0.5*length + 0.2*early;
+}
+
+QVector<Event> PlannerReference::scheduleTasksIntoWindows(const QVector<Slot>& windows,
+                                                          QVector<Task> tasks,
+                                                          const QDateTime& now) {
+    QVector<Event> out;
+    if (tasks.isEmpty() || windows.isEmpty()) return out;
+
+    std::sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b){
+        if (a.priority != b.priority) return a.priority > b.priority;
+        if (a.deadline.isValid() && b.deadline.isValid())
+            return a.deadline < b.deadline;
+        if (a.deadline.isValid() != b.deadline.isValid())
+            return a.deadline.isValid();
+        return a.estimateMin > b.estimateMin;
+    });
+
+    struct MSlot { QDateTime s,e; };
+    QVector<MSlot> pool; pool.reserve(windows.size());
+    for (auto& w : windows) pool.push_back({w.start, w.end});
+
+    auto carve = [&](int needMin, const Task& t, QVector<Event>& acc){
+        while (needMin > 0) {
+            int bestIdx = -1; double bestScore = -1e9;
+
+            for (int i=0;i<pool.size();++i) {
+                Slot w{pool[i].s, pool[i].e};
+                if (minutesBetween(w.start, w.end) < 15) continue;
+                const double sc = slotScore(w, t, now);
+                if (sc > bestScore) { bestScore = sc; bestIdx = i; }
+            }
+            if (bestIdx < 0) break;
+
+            auto &chosen = pool[bestIdx];
+            const int availMin = minutesBetween(chosen.s, chosen.e);
+            const int chunk    = std::min({t.maxChunkMin, needMin, availMin});
+
+            const QDateTime s = chosen.s;
+            const QDateTime e = s.addSecs(chunk*60);
+
+            const int pre = 5, post = 10;
+            const QDateTime sBuf = s.addSecs(-pre*60);
+            const QDateTime eBuf = e.addSecs( post*60);
+
+            acc.push_back(mkEvent(QString("🔵 %1").arg(t.title), s, e, kTaskBlue()));
+            acc.push_back(mkEvent("Buffer", sBuf, s, kBufferGray()));
+            acc.push_back(mkEvent("Buffer", e,   eBuf, kBufferGray()));
+
+            chosen.s = eBuf;
+            if (chosen.s >= chosen.e) pool.removeAt(bestIdx);
+
+            needMin -= chunk;
+            if (!t.splitOK) break;
+        }
+        return needMin <= 0;
+    };
+
+    for (const auto& t : tasks) {
+        const int need = std::max(15, t.estimateMin);
+        carve(need, t, out);
+    }
+    return out;
+}
+
+
+// ============================================================================
+// Dashboard aggregation
+// ============================================================================
+
+DayStats PlannerReference::dayStats(const QVector<Event>& events, const QDate& day)
+{
+    DayStats st;
+    st.dateLabel = day.toString("ddd, MMM d");
+
+    // collect today's events
+    QVector<const Event*> todays;
+    todays.reserve(events.size());
+    for (const auto& e : events) if (e.isOnDate(day)) todays.push_back(&e);
+    std::sort(todays.begin(), todays.end(),
+              [](const Event* a, const Event* b){ return a->getStartTime() < b->getStartTime(); });
+
+    // aggregate
+    int focusMin=0, breakMin=0, exerciseMin=0, sessions=0, longestFocus=0;
+    int meetingCount=0, fragments=0;
+    QTime firstStart, lastEnd;
+    QDateTime prevEnd;
+
+    for (const Event* e : todays) {
+        const int dur = e->getStartTime().secsTo(e->getEndTime())/60;
+        const QString cat = descCategory(*e).toLower();
+
+        if (cat == "break")              breakMin    += dur;
+        else if (cat == "exercise")      exerciseMin += dur;
+        else                              { focusMin += dur; sessions++; longestFocus = std::max(longestFocus, dur); }
+
+        if (isMeetingTitle(e->getTitle())) meetingCount++;
+
+        if (!firstStart.isValid() || e->getStartTime().time() < firstStart) firstStart = e->getStartTime().time();
+        if (!lastEnd.isValid()   || e->getEndTime().time()     > lastEnd)   lastEnd   = e->getEndTime().time();
+
+        if (prevEnd.isValid()) {
+            const int gap = prevEnd.secsTo(e->getStartTime())/60;
+            if (gap > 0 && gap < 25) fragments++; // tiny gaps = fragmentation
+        }
+        prevEnd = e->getEndTime();
+    }
+
+    const int daySpan = (firstStart.isValid() && lastEnd.isValid())
+                        ? QTime(0,0).secsTo(lastEnd) / 60 - QTime(0,0).secsTo(firstStart) / 60
+                        : 0;
+    const int activeMin = focusMin + breakMin + exerciseMin;
+    const int freeMin   = std::max(0, daySpan - activeMin);
+
+    // metrics
+    const int contextSwitches = std::max(0, sessions + meetingCount + fragments - 1);
+    const int load    = qBound(0, focusMin/9 + sessions*3 + meetingCount*4 + fragments*2, 100);
+    const int balance = qBound(0, 70 + (exerciseMin/15) - (std::abs(focusMin - (breakMin*2))/10), 100);
+    const int risk    = qBound(0, load - (breakMin/6) - (exerciseMin/10), 100);
+
+    // time windows free minutes helper
+    auto minutesFreeIn = [&](int startH, int endH){
+        int used = 0;
+        for (const Event* e : todays) {
+            const auto s = e->getStartTime().time();
+            const auto t = e->getEndTime().time();
+            const int a = qBound(startH*60, s.hour()*60 + s.minute(), endH*60);
+            const int b = qBound(startH*60, t.hour()*60 + t.minute(), endH*60);
+            used += std::max(0, b - a);
+        }
+        return std::max(0, (endH-startH)*60 - used);
+    };
+
+    const int morningSpan   = (12-8)*60, afternoonSpan=(17-12)*60, eveningSpan=(21-17)*60;
+    const int freeMorning   = minutesFreeIn(8,12);
+    const int freeAfternoon = minutesFreeIn(12,17);
+    const int freeEvening   = minutesFreeIn(17,21);
+
+    // Build smart moves
+    QStringList actions;
+    if (breakMin < 20) actions << "Add 2×10m micro-breaks to reduce fatigue";
+    if (exerciseMin < 30) actions << "Schedule a 30–45m exercise block";
+    if (meetingCount >= 4 && fragments >= 2) actions << "Defragment: stack adjacent meetings or move one to tomorrow";
+    if (freeAfternoon >= 60 && longestFocus < 60 && focusMin >= 90)
+        actions << "Convert afternoon into a 90m deep-work block";
+    if (freeMorning < 30 && freeEvening >= 60)
+        actions << "Shift low-priority work to evening to free morning focus time";
+    if (actions.isEmpty()) actions << "You’re set — cadence looks healthy";
+
+    // Fill DayStats
+    st.sessions         = sessions;
+    st.meetings         = meetingCount;
+    st.defense = (balance >= 70) ? 1 : 0;
+    st.focusOn          = (focusMin > 0);
+    st.breaksMin        = breakMin;
+    st.exerciseMin      = exerciseMin;
+    st.freeMin          = freeMin;
+    st.loadMin          = activeMin;   // total active minutes (focus+break+exercise)
+    st.fragmentation    = fragments;
+    st.contextSwitches  = contextSwitches;
+    st.balancePercent   = balance;
+    st.riskPercent      = risk;
+    st.riskLabel        = (risk >= 70 ? "High" : (risk >= 40 ? "Medium" : "Low"));
+    st.firstStart       = firstStart.isValid()? firstStart.toString("hh:mm") : "--";
+    st.lastEnd          = lastEnd.isValid()?   lastEnd.toString("hh:mm")     : "--";
+    st.longestFocus     = mmLocal(longestFocus);
+    st.smartMoves       = actions;
+
+    st.timeMap = {
+        TimeBucket{ "Morning",   mmLocal(freeMorning),   morningSpan>0   ? (freeMorning   *100)/morningSpan   : 0 },
+        TimeBucket{ "Afternoon", mmLocal(freeAfternoon), afternoonSpan>0 ? (freeAfternoon *100)/afternoonSpan : 0 },
+        TimeBucket{ "Evening",   mmLocal(freeEvening),   eveningSpan>0   ? (freeEvening   *100)/eveningSpan   : 0 },
+    };
+
+    return st;
+}
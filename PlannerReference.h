@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+#include <QVector>
+
+#include "Event.h"
+#include "SuperAI.h"
+#include "UltraDashboardRender.h"
+
+/**
+ * @brief PlannerReference
+ * Straightforward reference versions of the planner and dashboard kernels.
+ *
+ * These are the original implementations of SuperAI::freeWindows,
+ * SuperAI::slotScore, SuperAI::scheduleTasksIntoWindows and the DayStats
+ * aggregation, kept verbatim so optimised versions can be checked against
+ * them (tools/diff_harness.cpp). Do not optimise this file; change it only
+ * when the intended behaviour changes, together with the production code.
+ *
+ * Notes
+ *  - "now" is an explicit argument here (production reads SuperAI's clock).
+ *  - Not linked into the application.
+ */
+struct PlannerReference {
+    using Slot  = SuperAI::Slot;
+    using Task  = SuperAI::Task;
+
+    static QVector<Slot> freeWindows(const QDate& day, const QVector<Event>& busy,
+                                     int minBlockMin = 15);
+
+    static double slotScore(const Slot& window, const Task& t, const QDateTime& now);
+
+    static QVector<Event> scheduleTasksIntoWindows(const QVector<Slot>& windows,
+                                                   QVector<Task> tasks,
+                                                   const QDateTime& now);
+
+    static DayStats dayStats(const QVector<Event>& events, const QDate& day);
+};
@@ -0,0 +1,74 @@
+#include "PlannerWeights.h"
+
+#include <QFileInfo>
+#include <QSettings>
+
+double& PlannerWeights::operator[](int i)
+{
+    switch (i) {
+    case 0:  return priority;
+    case 1:  return urgency;
+    case 2:  return circadian;
+    case 3:  return length;
+    case 4:  return early;
+    case 5:  return circadianMiss;
+    case 6:  return habitLength;
+    case 7:  return habitAnchorHit;
+    case 8:  return habitAnchorMiss;
+    default: return habitPriority;
+    }
+}
+
+const char* PlannerWeights::name(int i)
+{
+    static const char* kNames[kCount] = {
+        "priority", "urgency", "circadian", "length", "early", "circadianMiss",
+        "habitLength", "habitAnchorHit", "habitAnchorMiss", "habitPriority"
+    };
+    return (i >= 0 && i < kCount) ? kNames[i] : "";
+}
+
+QVariantMap PlannerWeights::toMap() const
+{
+    QVariantMap m;
+    for (int i = 0; i < kCount; ++i) m.insert(name(i), (*this)[i]);
+    return m;
+}
+
+PlannerWeights PlannerWeights::fromMap(const QVariantMap& m)
+{
+    PlannerWeights w;
+    for (int i = 0; i < kCount; ++i) {
+        bool ok = false;
+        const double v = m.value(name(i)).toDouble(&ok);
+        if (ok) w[i] = v;
+    }
+    return w;
+}
+
+bool PlannerWeights::save(const QString& path) const
+{
+    QSettings ini(path, QSettings::IniFormat);
+    ini.beginGroup("weights");
+    for (int i = 0; i < kCount; ++i) ini.setValue(name(i), (*this)[i]);
+    ini.endGroup();
+    ini.sync();
+    return ini.status() == QSettings::NoError;
+}
+
+PlannerWeights PlannerWeights::load(const QString& path, bool* ok)
+{
+    if (ok) *ok = false;
+    if (!QFileInfo::exists(path)) return {};
+
+    QSettings ini(path, QSettings::IniFormat);
+    if (ini.status() != QSettings::NoError) return {};
+
+    ini.beginGroup("weights");
+    QVariantMap m;
+    for (const QString& k : ini.childKeys()) m.insert(k, ini.value(k));
+    ini.endGroup();
+
+    if (ok) *ok = !m.isEmpty();
+    return fromMap(m);
+}
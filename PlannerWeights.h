@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QString>
+#include <QVariantMap>
+
+/**
+ * @brief PlannerWeights
+ * Scoring knobs of SuperAI's planner (slotScore and scheduleHabits).
+ *
+ * Defaults reproduce the original hand-picked heuristics. A tuned profile
+ * (see tools/planner_tune.cpp) is an INI file with a [weights] group and
+ * is loaded at startup from <AppData>/planner-weights.ini when present.
+ */
+struct PlannerWeights {
+    // slotScore: score = priority*pr + urgency*u + circadian*c + length*l + early*e
+    double priority      = 1.8;
+    double urgency       = 1.4;
+    double circadian     = 0.8;
+    double length        = 0.5;
+    double early         = 0.2;
+    double circadianMiss = 0.3;   ///< penalty when a morning/afternoon task lands elsewhere
+
+    // scheduleHabits: length per hour, anchor hit/miss, priority
+    double habitLength      = 0.2;
+    double habitAnchorHit   = 1.0;
+    double habitAnchorMiss  = 0.2;
+    double habitPriority    = 0.5;
+
+    static constexpr int kCount = 10;
+
+    /// Field access by index (0..kCount-1), used by the tuner.
+    double&       operator[](int i);
+    double        operator[](int i) const { return const_cast<PlannerWeights&>(*this)[i]; }
+    static const char* name(int i);
+
+    QVariantMap           toMap() const;
+    static PlannerWeights fromMap(const QVariantMap& m);   ///< missing keys keep defaults
+
+    /// INI profile I/O. load() returns defaults (and false) if @path is missing/empty.
+    bool                  save(const QString& path) const;
+    static PlannerWeights load(const QString& path, bool* ok = nullptr);
+};
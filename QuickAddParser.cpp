@@ -0,0 +1,316 @@
+#include "QuickAddParser.h"
+
+#include <QHash>
+#include <QRegularExpression>
+#include <algorithm>  // std::min
+
+// ---- word tables ------------------------------------------------------------
+
+static int weekdayOf(const QString& t)
+{
+    static const QHash<QString, int> kDays = {
+        { "mon", 1 }, { "monday", 1 },
+        { "tue", 2 }, { "tues", 2 }, { "tuesday", 2 },
+        { "wed", 3 }, { "weds", 3 }, { "wednesday", 3 },
+        { "thu", 4 }, { "thur", 4 }, { "thurs", 4 }, { "thursday", 4 },
+        { "fri", 5 }, { "friday", 5 },
+        { "sat", 6 }, { "saturday", 6 },
+        { "sun", 7 }, { "sunday", 7 },
+    };
+    return kDays.value(t, 0);
+}
+
+static int monthOf(const QString& t)
+{
+    static const QHash<QString, int> kMonths = {
+        { "jan", 1 }, { "january", 1 }, { "feb", 2 }, { "february", 2 }, { "mar", 3 }, { "march", 3 },
+        { "apr", 4 }, { "april", 4 }, { "may", 5 }, { "jun", 6 }, { "june", 6 },
+        { "jul", 7 }, { "july", 7 }, { "aug", 8 }, { "august", 8 },
+        { "sep", 9 }, { "sept", 9 }, { "september", 9 }, { "oct", 10 }, { "october", 10 },
+        { "nov", 11 }, { "november", 11 }, { "dec", 12 }, { "december", 12 },
+    };
+    return kMonths.value(t, 0);
+}
+
+static bool isFiller(const QString& t)
+{
+    return t == "at" || t == "on" || t == "from" || t == "for";
+}
+
+static QDate nextWeekday(const QDate& base, int dow)
+{
+    return base.addDays((dow - base.dayOfWeek() + 7) % 7);
+}
+
+// "3", "15", "30", "pm" → QTime; invalid if out of range
+static QTime clockOf(const QString& h, const QString& m, const QString& mer)
+{
+    int hour = h.toInt();
+    const int min = m.isEmpty() ? 0 : m.toInt();
+    if (!mer.isEmpty()) {
+        if (hour < 1 || hour > 12) return {};
+        hour = (hour % 12) + (mer == "pm" ? 12 : 0);
+    }
+    return QTime(hour, min);   // QTime rejects hour > 23 / min > 59
+}
+
+
+// ============================================================================
+// QuickAddParser
+// ============================================================================
+
+const QuickAddParser::Result& QuickAddParser::parse(const QString& text)
+{
+    // Tokens that end before the first edited character keep their state
+    int p = 0;
+    const int common = std::min(text.size(), m_text.size());
+    while (p < common && text[p] == m_text[p]) ++p;
+
+    int keep = 0;
+    while (keep < m_snaps.size() && m_snaps[keep].end < p) ++keep;
+    m_snaps.resize(keep);
+    m_reused = keep;
+
+    State st  = keep ? m_snaps.back().st : State{};
+    int   pos = keep ? m_snaps.back().end : 0;
+    const int n = text.size();
+    while (pos < n) {
+        while (pos < n && text[pos].isSpace()) ++pos;
+        if (pos >= n) break;
+        int e = pos;
+        while (e < n && !text[e].isSpace()) ++e;
+        feed(st, text.mid(pos, e - pos));
+        m_snaps.push_back({ e, st });
+        pos = e;
+    }
+
+    m_text   = text;
+    m_result = finish(st);
+    return m_result;
+}
+
+QDate QuickAddParser::resolve(int month, int day, const QDate& notBefore) const
+{
+    int year = notBefore.year();
+    auto make = [&](int y) {
+        const QDate first(y, month, 1);
+        return QDate(y, month, std::min(day, first.daysInMonth()));
+    };
+    QDate d = make(year);
+    if (d < notBefore) d = make(year + 1);
+    return d;
+}
+
+bool QuickAddParser::takeDate(State& st, const QString& t, bool forUntil) const
+{
+    const QDate base = forUntil && st.date.isValid() ? st.date : m_today;
+    QDate d;
+    if      (t == "today")                                 d = m_today;
+    else if (t == "tomorrow" || t == "tmr" || t == "tmrw") d = m_today.addDays(1);
+    else if (const int dow = weekdayOf(t))                 d = nextWeekday(base, dow);
+    else if (const int m = monthOf(t)) {
+        st.month = m; st.monthForUntil = forUntil;          // day number may follow
+        return true;
+    } else {
+        bool ok = false;
+        const int num = t.toInt(&ok);
+        if (ok && num >= 1 && num <= 31) {
+            st.dayNum = num; st.dayForUntil = forUntil;     // month name may follow
+            return true;
+        }
+        d = QDate::fromString(t, Qt::ISODate);
+        if (!d.isValid()) return false;
+    }
+    (forUntil ? st.until : st.date) = d;
+    return true;
+}
+
+bool QuickAddParser::takeTime(State& st, const QString& t) const
+{
+    static const QRegularExpression kRange(
+        R"(^(\d{1,2})(?::(\d{2}))?(am|pm)?[-–](\d{1,2})(?::(\d{2}))?(am|pm)?$)");
+    static const QRegularExpression kOpen(R"(^(\d{1,2})(?::(\d{2}))?(am|pm)?[-–]$)");
+    static const QRegularExpression kSingle(R"(^(\d{1,2})(?::(\d{2})(am|pm)?|()(am|pm))$)");
+    static const QRegularExpression kDuration(R"(^(?:(\d{1,2})h(?:(\d{1,2})m?)?|(\d{1,3})m(?:in)?)$)");
+
+    if (const auto m = kRange.match(t); m.hasMatch()) {
+        // "3-5pm": the first bound borrows the second's am/pm
+        const QString mer1 = m.captured(3).isEmpty() ? m.captured(6) : m.captured(3);
+        const QTime s = clockOf(m.captured(1), m.captured(2), mer1);
+        const QTime e = clockOf(m.captured(4), m.captured(5), m.captured(6));
+        if (!s.isValid() || !e.isValid()) return false;
+        st.start = s; st.end = e;
+        return true;
+    }
+    if (const auto m = kOpen.match(t); m.hasMatch()) {
+        const QTime s = clockOf(m.captured(1), m.captured(2), m.captured(3));
+        if (!s.isValid()) return false;
+        st.start = s; st.end = {}; st.pending = Pending::EndTime;
+        return true;
+    }
+    if (const auto m = kSingle.match(t); m.hasMatch()) {
+        const QString mer = m.captured(3).isEmpty() ? m.captured(5) : m.captured(3);
+        const QTime c = clockOf(m.captured(1), m.captured(2), mer);
+        if (!c.isValid()) return false;
+        st.start = c; st.end = {};
+        return true;
+    }
+    if (const auto m = kDuration.match(t); m.hasMatch()) {
+        st.durationMin = m.captured(3).isEmpty()
+                       ? m.captured(1).toInt() * 60 + m.captured(2).toInt()
+                       : m.captured(3).toInt();
+        return st.durationMin > 0;
+    }
+    return false;
+}
+
+/**
+ * @brief feed
+ * Advance @st by one whitespace-separated token. Multi-token constructs
+ * ("Dec 1", "every Tue", "15:00 to 17:00", "until …", fillers) are carried
+ * in State so a snapshot after any token is a complete resume point.
+ */
+void QuickAddParser::feed(State& st, const QString& token) const
+{
+    const QString t = token.toLower();
+
+    // "1" waiting for "Dec"
+    if (st.dayNum > 0) {
+        const int day = st.dayNum; const bool u = st.dayForUntil;
+        st.dayNum = 0;
+        if (const int m = monthOf(t)) {
+            (u ? st.until : st.date) = resolve(m, day, u && st.date.isValid() ? st.date : m_today);
+            return;
+        }
+        if (!u) st.titleWords << QString::number(day);
+    }
+    // "Dec" waiting for "1" (a bare month means the 1st)
+    if (st.month > 0) {
+        const int m = st.month; const bool u = st.monthForUntil;
+        st.month = 0;
+        bool ok = false;
+        const int day = t.toInt(&ok);
+        const QDate base = u && st.date.isValid() ? st.date : m_today;
+        const bool isDay = ok && day >= 1 && day <= 31;
+        (u ? st.until : st.date) = resolve(m, isDay ? day : 1, base);
+        if (isDay) return;
+    }
+
+    const Pending pending = st.pending;
+    const QString held    = st.filler;
+    st.pending = Pending::None;
+    st.filler.clear();
+
+    switch (pending) {
+    case Pending::Every:
+        if (t == "day")   { st.recur = 1; return; }
+        if (t == "week")  { st.recur = 2; return; }
+        if (t == "month") { st.recur = 3; return; }
+        if (const int dow = weekdayOf(t)) { st.recur = 2; st.date = nextWeekday(m_today, dow); return; }
+        st.titleWords << "every";
+        break;
+    case Pending::Until:
+        if (takeDate(st, t, true)) return;
+        st.titleWords << "until";
+        break;
+    case Pending::EndTime: {
+        State probe = st;
+        if (takeTime(probe, t) && !probe.end.isValid() && probe.durationMin == st.durationMin) {
+            st.end = probe.start;   // "15:00 to 17:00"
+            return;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    // Recognised pieces swallow a held filler ("at 3pm", "on Tue")
+    bool known = true;
+    if (t.startsWith('#') && t.size() > 1) {
+        static const QStringList kCats = { "Study", "Work", "Break", "Exercise", "Personal" };
+        const QString raw = token.mid(1);
+        st.category = raw.left(1).toUpper() + raw.mid(1);
+        for (const QString& c : kCats)
+            if (c.compare(raw, Qt::CaseInsensitive) == 0) st.category = c;
+    }
+    else if (t == "daily")                     st.recur = 1;
+    else if (t == "weekly")                    st.recur = 2;
+    else if (t == "monthly")                   st.recur = 3;
+    else if (t == "every")                     st.pending = Pending::Every;
+    else if (t == "until" || t == "till")      st.pending = Pending::Until;
+    else if ((t == "-" || t == "–" || t == "to") && st.start.isValid() && !st.end.isValid())
+                                               st.pending = Pending::EndTime;
+    else if (takeTime(st, t))                  ;
+    else if (takeDate(st, t, false))           ;
+    else                                       known = false;
+    if (known) return;
+
+    if (!held.isEmpty()) st.titleWords << held;
+    if (isFiller(t)) { st.pending = Pending::Filler; st.filler = token; return; }
+    st.titleWords << token;
+}
+
+QuickAddParser::Result QuickAddParser::finish(const State& st) const
+{
+    Result r;
+    QStringList words = st.titleWords;
+    if (st.dayNum > 0 && !st.dayForUntil) words << QString::number(st.dayNum);
+    if (st.pending == Pending::Filler)    words << st.filler;
+    r.title    = words.join(' ').trimmed();
+    r.category = st.category;
+    r.recur    = st.recur;
+
+    r.date  = st.date.isValid() ? st.date : m_today;
+    r.until = st.until;
+    if (st.month > 0) {
+        const QDate d = resolve(st.month, 1, st.monthForUntil ? r.date : m_today);
+        (st.monthForUntil ? r.until : r.date) = d;
+    }
+
+    r.start = st.start;
+    if (st.end.isValid())        r.end = st.end;
+    else if (st.start.isValid()) r.end = st.start.addSecs(60 * (st.durationMin > 0 ? st.durationMin : 60));
+    return r;
+}
+
+
+// ============================================================================
+// Result
+// ============================================================================
+
+QVector<QPair<QDateTime, QDateTime>> QuickAddParser::Result::occurrences() const
+{
+    QVector<QPair<QDateTime, QDateTime>> out;
+    if (!isValid()) return out;
+
+    static const int kDefaultCount[] = { 1, 365, 52, 12 };
+    const int r     = std::clamp(recur, 0, 3);
+    const int count = (r && until.isValid()) ? 3660 : kDefaultCount[r];
+
+    for (int i = 0; i < count; ++i) {
+        const QDate d = r == 1 ? date.addDays(i)
+                      : r == 2 ? date.addDays(7 * i)
+                      : r == 3 ? date.addMonths(i)
+                      :          date;
+        if (until.isValid() && r && d > until) break;
+
+        const QDateTime s(d, start);
+        QDateTime e(d, end);
+        if (e <= s) e = e.addDays(1);   // "22:00-01:00" runs past midnight
+        out.push_back({ s, e });
+    }
+    return out;
+}
+
+QString QuickAddParser::Result::describe() const
+{
+    QString s = date.toString("ddd d MMM");
+    if (start.isValid()) s += " " + start.toString("hh:mm") + "–" + end.toString("hh:mm");
+    static const char* kRecur[] = { "", "daily", "weekly", "monthly" };
+    if (recur > 0 && recur <= 3) {
+        s += QString(" · %1").arg(kRecur[recur]);
+        if (until.isValid()) s += " until " + until.toString("ddd d MMM");
+    }
+    return s + " · #" + category;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QTime>
+#include <QVector>
+
+/**
+ * @brief QuickAddParser
+ * Incremental parser for one-line event entry, e.g.
+ *   "Calc study Tue 15:00-17:00 weekly until Dec 1 #study"
+ *
+ * Recognised pieces (anything else becomes the title)
+ *  - day:        today, tomorrow, mon..sun (next such day), "Dec 1", "1 Dec", 2025-12-01
+ *  - time:       15:00-17:00, 3pm-5pm, 9-10:30, 15:00 to 17:00, 9am; duration 90m, 2h, 1h30
+ *  - recurrence: daily, weekly, monthly, every day/week/month, every Tue
+ *  - end:        until/till <day>
+ *  - category:   #study (matches the dialog's categories case-insensitively)
+ * Fillers (at, on, from, for) are dropped only when a recognised piece follows.
+ *
+ * The parser keeps the state after every token of the previous input. On each
+ * call it resumes from the last token that ends before the first edited
+ * character, so typing at the end of the line costs one token, not a re-parse.
+ */
+class QuickAddParser {
+public:
+    struct Result {
+        QString title;
+        QString category = "Personal";
+        QDate   date;
+        QTime   start;
+        QTime   end;
+        int     recur = 0;   ///< 0 none, 1 daily, 2 weekly, 3 monthly (as the New-event dialog)
+        QDate   until;       ///< last day of the series (inclusive); invalid = dialog defaults
+
+        bool isValid() const { return !title.isEmpty() && date.isValid() && start.isValid() && end.isValid(); }
+
+        /// Expanded [start, end) pairs; counts default to 365/52/12 like the dialog.
+        QVector<QPair<QDateTime, QDateTime>> occurrences() const;
+
+        /// "Tue 21 Oct 15:00–17:00 · weekly until Mon 1 Dec"
+        QString describe() const;
+    };
+
+    /// @today anchors relative days ("Tue", "tomorrow") and year-less dates.
+    explicit QuickAddParser(const QDate& today = QDate::currentDate()) : m_today(today) {}
+
+    void setToday(const QDate& d) { if (d != m_today) { m_today = d; m_text.clear(); m_snaps.clear(); } }
+
+    const Result& parse(const QString& text);
+    const Result& result() const { return m_result; }
+
+    int lastReusedTokens() const { return m_reused; }   ///< tokens skipped by the last parse()
+
+private:
+    enum class Pending { None, Until, Every, EndTime, Filler };
+
+    struct State {
+        QStringList titleWords;
+        QString     category = "Personal";
+        QDate       date;
+        QDate       until;
+        QTime       start, end;
+        int         durationMin = -1;
+        int         recur       = 0;
+        Pending     pending     = Pending::None;
+        QString     filler;              ///< held filler word (Pending::Filler)
+        int         dayNum      = 0;     ///< "1" waiting for a month name
+        bool        dayForUntil = false;
+        int         month       = 0;     ///< month name waiting for a day number
+        bool        monthForUntil = false;
+    };
+
+    struct Snapshot { int end; State st; };
+
+    void   feed(State& st, const QString& token) const;
+    bool   takeDate(State& st, const QString& t, bool forUntil) const;
+    bool   takeTime(State& st, const QString& t) const;
+    QDate  resolve(int month, int day, const QDate& notBefore) const;
+    Result finish(const State& st) const;
+
+    QDate             m_today;
+    QString           m_text;
+    QVector<Snapshot> m_snaps;   ///< state after each token of m_text
+    Result            m_result;
+    int               m_reused = 0;
+};
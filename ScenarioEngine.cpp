@@ -0,0 +1,166 @@
+#include "ScenarioEngine.h"
+
+#include <QElapsedTimer>
+#include <QSharedPointer>
+#include <algorithm>  // std::sort, std::max, std::min
+
+static int minutesClipped(const Event& e, const QDateTime& a, const QDateTime& b)
+{
+    const QDateTime s = std::max(e.getStartTime(), a);
+    const QDateTime t = std::min(e.getEndTime(),   b);
+    return s < t ? int(s.secsTo(t) / 60) : 0;
+}
+
+// ============================================================================
+// Scenario
+// ============================================================================
+
+void ScenarioEngine::Scenario::addWeekly(const QString& title, Qt::DayOfWeek dow,
+                                         const QTime& start, const QTime& end,
+                                         const QDate& from, int weeks, const QColor& color)
+{
+    QDate d = from.addDays((int(dow) - from.dayOfWeek() + 7) % 7);
+    for (int w = 0; w < weeks; ++w, d = d.addDays(7))
+        adds.push_back(Event(title, title, QDateTime(d, start), QDateTime(d, end), color));
+}
+
+bool ScenarioEngine::Scenario::removes(const Event& e) const
+{
+    if (!removeUids.isEmpty()   && removeUids.contains(e.uid()))            return true;
+    if (!removeSeries.isEmpty() && !e.seriesId().isEmpty()
+        && removeSeries.contains(e.seriesId()))                              return true;
+    for (const QString& t : removeTitles)
+        if (e.getTitle().compare(t, Qt::CaseInsensitive) == 0)               return true;
+    return false;
+}
+
+
+// ============================================================================
+// ScenarioEngine
+// ============================================================================
+
+ScenarioEngine::ScenarioEngine(JobScheduler* jobs, QObject* parent)
+    : QObject(parent), m_jobs(jobs)
+{
+}
+
+ScenarioEngine::~ScenarioEngine()
+{
+    m_cancel.cancel();
+}
+
+/**
+ * @brief evaluateOne
+ * Materialises the scenario's horizon (base minus removes, plus adds), then
+ * walks it day by day: busy/free minutes, planDay() with the tasks still
+ * open, and stress/balance on existing + planned blocks.
+ */
+ScenarioEngine::Metrics ScenarioEngine::evaluateOne(const QVector<Event>& base,
+                                                    const Scenario& sc, const Params& p)
+{
+    QElapsedTimer timer; timer.start();
+    Metrics m;
+    m.name = sc.name;
+
+    const int days = std::max(0, p.days);
+    const QDateTime h0 = p.from.startOfDay();
+    const QDateTime h1 = p.from.addDays(days).startOfDay();
+
+    // Only the horizon is copied; the base vector itself stays shared
+    QVector<Event> eff;
+    for (const Event& e : base)
+        if (e.getStartTime() < h1 && e.getEndTime() > h0 && !sc.removes(e)) eff.push_back(e);
+    for (const Event& e : sc.adds)
+        if (e.getStartTime() < h1 && e.getEndTime() > h0) eff.push_back(e);
+    std::sort(eff.begin(), eff.end(), [](const Event& a, const Event& b){
+        return a.getStartTime() < b.getStartTime();
+    });
+
+    SuperAI ai;
+    ai.setWeights(p.weights);
+    if (p.now.isValid()) { const QDateTime now = p.now; ai.setClock([now]{ return now; }); }
+
+    QVector<SuperAI::Task> open = p.tasks;
+    int riskSum = 0, balanceSum = 0;
+
+    for (int d = 0; d < days; ++d) {
+        const QDate     day = p.from.addDays(d);
+        const QDateTime ds  = day.startOfDay();
+        const QDateTime de  = day.addDays(1).startOfDay();
+
+        QVector<Event> today;
+        for (const Event& e : eff) {
+            if (e.getStartTime() >= de) break;
+            if (e.getEndTime() > ds) { today.push_back(e); m.busyMin += minutesClipped(e, ds, de); }
+        }
+        for (const auto& w : ai.freeWindows(day, today))
+            m.freeMin += int(w.start.secsTo(w.end) / 60);
+
+        // Plan what is still open; placed minutes come off the task estimates
+        const QVector<Event> plan = open.isEmpty() && p.habits.isEmpty()
+                                  ? QVector<Event>()
+                                  : ai.planDay(day, today, open, p.habits);
+        for (const Event& b : plan) {
+            if (!b.getTitle().startsWith(QStringLiteral("🔵 "))) continue;
+            const QString title = b.getTitle().mid(3);
+            const int     mins  = int(b.getStartTime().secsTo(b.getEndTime()) / 60);
+            for (auto& t : open)
+                if (t.title == title && t.estimateMin > 0) {
+                    const int used = std::min(mins, t.estimateMin);
+                    t.estimateMin -= used;
+                    m.plannedMin  += used;
+                    m.finishDay    = d;
+                    break;
+                }
+        }
+        open.erase(std::remove_if(open.begin(), open.end(),
+                                  [](const SuperAI::Task& t){ return t.estimateMin <= 0; }),
+                   open.end());
+
+        today += plan;
+        const auto st = SuperAI::stressScore(today);
+        riskSum    += st.risk;
+        m.peakRisk  = std::max(m.peakRisk, st.risk);
+        balanceSum += SuperAI::balanceScore(today).score;
+    }
+
+    for (const auto& t : open) m.unplacedMin += t.estimateMin;
+    if (days > 0) { m.avgRisk = riskSum / days; m.avgBalance = balanceSum / days; }
+    m.elapsedUs = timer.nsecsElapsed() / 1000;
+    return m;
+}
+
+int ScenarioEngine::evaluate(const QVector<Event>& base, const QVector<Scenario>& scenarios,
+                             const Params& p)
+{
+    const int runId = ++m_lastRun;
+
+    QVector<Scenario> all;
+    all.reserve(scenarios.size() + 1);
+    all.push_back(Scenario{ "Current", {}, {}, {}, {} });
+    all += scenarios;
+
+    struct Run { QVector<Metrics> results; };
+    auto run = QSharedPointer<Run>::create();
+    run->results.resize(all.size());
+    Metrics* out = run->results.data();   // detached once here; jobs write disjoint entries
+
+    JobScheduler::Options so;
+    so.token = m_cancel;
+    JobScheduler::Options mo;
+    mo.token = m_cancel;
+    for (int i = 0; i < all.size(); ++i)
+        mo.after.push_back(m_jobs->submit(JobScheduler::Priority::Batch,
+                                          [run, out, base, sc = all[i], p, i](const JobScheduler::CancelToken&) {
+            out[i] = evaluateOne(base, sc, p);
+            return QVariant();
+        }, so));
+
+    // Runs once every scenario is in; finished() arrives on the engine's thread
+    mo.context = this;
+    mo.done    = [this, run, runId](const QVariant&) {
+        emit finished(runId, run->results);
+    };
+    m_jobs->submit(JobScheduler::Priority::Batch, [](const JobScheduler::CancelToken&) { return QVariant(); }, mo);
+    return runId;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "Event.h"
+#include "JobScheduler.h"
+#include "PlannerWeights.h"
+#include "SuperAI.h"
+
+/**
+ * @brief ScenarioEngine
+ * "What if" evaluation: the current events plus hypothetical adds/removes,
+ * planned and scored over a horizon, several scenarios in parallel.
+ *
+ * Each scenario is a delta against one shared base snapshot. The base
+ * QVector is implicitly shared and never detached; a scenario only copies
+ * the events inside its horizon (shallow Event copies), so ten scenarios
+ * do not cost ten copies of the calendar.
+ *
+ * Per scenario and day the planner places the remaining task pool (what is
+ * placed on one day is not needed on the next) and SuperAI's stress and
+ * balance scores are taken on existing + planned blocks.
+ *
+ * Notes
+ *  - Each scenario is a Batch job on the shared JobScheduler with a private
+ *    SuperAI; a merge job after them delivers finished() on the engine's
+ *    thread. Pending jobs are cancelled when the engine is destroyed.
+ *  - Result 0 is always the unchanged base ("Current"), so callers can
+ *    show deltas without adding a baseline themselves.
+ */
+class ScenarioEngine : public QObject {
+    Q_OBJECT
+public:
+    /// Hypothetical change set against the base snapshot.
+    struct Scenario {
+        QString        name;
+        QVector<Event> adds;
+        QSet<QString>  removeUids;     ///< single events
+        QSet<QString>  removeSeries;   ///< whole recurring series (e.g. a course)
+        QStringList    removeTitles;   ///< case-insensitive exact title match
+
+        /// Adds @title every @dow between @from and @from + @weeks weeks.
+        void addWeekly(const QString& title, Qt::DayOfWeek dow,
+                       const QTime& start, const QTime& end,
+                       const QDate& from, int weeks, const QColor& color = QColor("#f59e0b"));
+
+        bool removes(const Event& e) const;
+    };
+
+    /// Planner inputs shared by all scenarios of a run.
+    struct Params {
+        QDate                   from;           ///< first day of the horizon
+        int                     days = 7;
+        QVector<SuperAI::Task>  tasks;
+        QVector<SuperAI::Habit> habits;
+        PlannerWeights          weights;
+        QDateTime               now;            ///< planner clock (invalid = wall clock)
+    };
+
+    /// Comparable numbers for one scenario over the horizon.
+    struct Metrics {
+        QString name;
+        int     busyMin      = 0;   ///< existing events in the horizon
+        int     freeMin      = 0;   ///< free time (06–22) before planning
+        int     plannedMin   = 0;   ///< task minutes the planner could place
+        int     unplacedMin  = 0;   ///< task minutes left over at the end
+        int     finishDay    = -1;  ///< horizon day index of the last task block; -1 = none
+        int     avgRisk      = 0;   ///< SuperAI::stressScore().risk, daily mean
+        int     peakRisk     = 0;
+        int     avgBalance   = 0;   ///< SuperAI::balanceScore().score, daily mean
+        qint64  elapsedUs    = 0;
+    };
+
+    explicit ScenarioEngine(JobScheduler* jobs, QObject* parent = nullptr);
+    ~ScenarioEngine() override;
+
+    /**
+     * @brief evaluate
+     * Queues "Current" + @scenarios against @base; returns the run id that
+     * finished() will carry. A newer run does not cancel older ones; callers
+     * ignore results whose id is not the latest.
+     */
+    int evaluate(const QVector<Event>& base, const QVector<Scenario>& scenarios, const Params& p);
+
+    /// Evaluate a single scenario on the calling thread.
+    static Metrics evaluateOne(const QVector<Event>& base, const Scenario& sc, const Params& p);
+
+signals:
+    void finished(int runId, const QVector<ScenarioEngine::Metrics>& results);
+
+private:
+    JobScheduler*             m_jobs = nullptr;
+    JobScheduler::CancelToken m_cancel;   // cancelled on destruction
+    int                       m_lastRun = 0;
+};
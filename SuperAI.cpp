@@ -1,4 +1,8 @@
 #include "SuperAI.h"
+#include "HabitEngine.h"
+#include "PlannerRecorder.h"
+#include <QElapsedTimer>
+#include <QPair>
 #include <algorithm>  // std::sort, std::min, std::max, std::clamp
 #include <cmath>      // std::abs
 
@@ -71,7 +75,7 @@ Event SuperAI::mkEvent(const QString& title,
 // Public API – called by UltraMainWindow
 // ============================================================================
 
-void SuperAI::setTasks(const QVector<Task>& t)   { m_tasks = t; }
+void SuperAI::setTasks(const QVector<Task>& t)   { m_tasks = t; emit tasksChanged(); }
 void SuperAI::setHabits(const QVector<Habit>& h) { m_habits = h; }
 
 /**
@@ -107,6 +111,21 @@ void SuperAI::analyzeSchedule(const QVector<Event>& events) {
     emit analysisComplete(msg);
 }
 
+void SuperAI::analyzeSchedule(const EventColumns& cols) {
+    const qint64 totalMin = cols.totalMinutes();
+    const QTime  first    = cols.earliestStart();
+    const QTime  last     = cols.latestEnd();
+
+    const QString msg = QString("Blocks: %1  |  Total: %2h%3m  |  Window: %4–%5  |  Meetings: %6")
+        .arg(cols.size())
+        .arg(totalMin/60).arg(totalMin%60)
+        .arg(first.isValid()? first.toString("hh:mm") : "--")
+        .arg(last.isValid()?  last.toString("hh:mm")  : "--")
+        .arg(cols.countFlag(EventColumns::Meeting));
+
+    emit analysisComplete(msg);
+}
+
 /**
  * @brief generateSmartSuggestions
  * Plans a day using current tasks/habits only (ignores “existing” events here).
@@ -181,14 +200,13 @@ void SuperAI::recommendHabits(const QVector<Event>& events) {
 }
 
 /**
- * @brief analyzeStress
+ * @brief stressScore
  * Very rough “density vs. recovery” model:
  *  - density ~ total minutes / 6
  *  - recovery ~ gap minutes / 3
  *  - risk ~ density - recovery/2 (clamped 0..100)
- * Emits: stressAnalysisReady(QString)
  */
-void SuperAI::analyzeStress(const QVector<Event>& events) {
+SuperAI::StressScore SuperAI::stressScore(const QVector<Event>& events) {
     int totalMin = 0, gaps = 0;
     QDateTime lastEnd;
 
@@ -205,25 +223,35 @@ void SuperAI::analyzeStress(const QVector<Event>& events) {
         lastEnd = e.getEndTime();
     }
 
-    const int density  = std::min(100, totalMin / 6);
-    const int recovery = std::max(0, std::min(100, gaps / 3));
-    const int risk     = std::clamp(density - (recovery/2), 0, 100);
+    StressScore st;
+    st.load     = std::min(100, totalMin / 6);
+    st.recovery = std::max(0, std::min(100, gaps / 3));
+    st.risk     = std::clamp(st.load - (st.recovery/2), 0, 100);
+    return st;
+}
+
+/**
+ * @brief analyzeStress
+ * Reports stressScore() as text.
+ * Emits: stressAnalysisReady(QString)
+ */
+void SuperAI::analyzeStress(const QVector<Event>& events) {
+    const StressScore st = stressScore(events);
 
     const QString s =
         QString("Load: %1/100\nRecovery: %2/100\nStress risk: %3/100\n"
                 "Tip: add micro-buffers (5–10m) after meetings and one 30m walk.")
-        .arg(density).arg(recovery).arg(risk);
+        .arg(st.load).arg(st.recovery).arg(st.risk);
 
     emit stressAnalysisReady(s);
 }
 
 /**
- * @brief optimizeWorkLifeBalance
+ * @brief balanceScore
  * Splits day into focus vs. recovery minutes and produces a naive score.
- * Emits: optimizationReady(QString)
  */
-void SuperAI::optimizeWorkLifeBalance(const QVector<Event>& events) {
-    int focusMin = 0, recoveryMin = 0;
+SuperAI::BalanceScore SuperAI::balanceScore(const QVector<Event>& events) {
+    BalanceScore b;
 
     for (const auto& e : events) {
         const QString t = e.getTitle().toLower();
@@ -231,18 +259,28 @@ void SuperAI::optimizeWorkLifeBalance(const QVector<Event>& events) {
 
         if (t.contains("buffer") || t.contains("walk") ||
             t.contains("break")  || t.contains("exercise"))
-            recoveryMin += m;
+            b.recoveryMin += m;
         else
-            focusMin += m;
+            b.focusMin += m;
     }
 
     // Heuristic: more recovery (up to a point) raises score; large mismatch penalizes.
-    const int score = std::clamp(70 + (recoveryMin/15) - std::abs(focusMin - recoveryMin)/10, 0, 100);
+    b.score = std::clamp(70 + (b.recoveryMin/15) - std::abs(b.focusMin - b.recoveryMin)/10, 0, 100);
+    return b;
+}
+
+/**
+ * @brief optimizeWorkLifeBalance
+ * Reports balanceScore() as text.
+ * Emits: optimizationReady(QString)
+ */
+void SuperAI::optimizeWorkLifeBalance(const QVector<Event>& events) {
+    const BalanceScore b = balanceScore(events);
 
     const QString s =
         QString("Balance score: %1/100\nFocus: %2m | Recovery: %3m\n"
                 "Suggestion: schedule recovery up to ~35%% of total focus time.")
-        .arg(score).arg(focusMin).arg(recoveryMin);
+        .arg(b.score).arg(b.focusMin).arg(b.recoveryMin);
 
     emit optimizationReady(s);
 }
@@ -257,49 +295,44 @@ void SuperAI::optimizeWorkLifeBalance(const QVector<Event>& events) {
  * Builds a list of free Slots in [06:00, 22:00] for a given day,
  * subtracting all overlapping “busy” events. Merges overlaps and enforces a
  * minimum slot length (minBlockMin).
+ *
+ * Works on epoch milliseconds (one conversion per event, integer sort) and
+ * merges + inverts in a single pass. Must match PlannerReference::freeWindows.
  */
 QVector<SuperAI::Slot> SuperAI::freeWindows(const QDate& day,
                                             const QVector<Event>& busy,
                                             int minBlockMin) const {
-    const QDateTime dayStart(day, QTime(6,0));
-    const QDateTime dayEnd  (day, QTime(22,0));
-
-    struct Seg { QDateTime s,e; };
-    QVector<Seg> segs;
+    const qint64 dayStart = QDateTime(day, QTime(6,0)).toMSecsSinceEpoch();
+    const qint64 dayEnd   = QDateTime(day, QTime(22,0)).toMSecsSinceEpoch();
+    const qint64 minMs    = qint64(minBlockMin) * 60 * 1000;
 
     // Clamp each busy event to the day window and collect
+    QVector<QPair<qint64, qint64>> segs;
+    segs.reserve(busy.size());
     for (const auto& e : busy) {
-        const QDateTime s = e.getStartTime();
-        const QDateTime t = e.getEndTime();
+        const QDateTime& s = e.getStartTime();
+        const QDateTime& t = e.getEndTime();
         if (s.date() > day || t.date() < day) continue;
 
-        const QDateTime clampedS = std::max(dayStart, s);
-        const QDateTime clampedE = std::min(dayEnd,   t);
-        if (clampedS < clampedE)
-            segs.push_back({clampedS, clampedE});
+        const qint64 a = std::max(dayStart, s.toMSecsSinceEpoch());
+        const qint64 b = std::min(dayEnd,   t.toMSecsSinceEpoch());
+        if (a < b) segs.push_back({a, b});
     }
+    std::sort(segs.begin(), segs.end());
 
-    // Merge overlaps
-    std::sort(segs.begin(), segs.end(), [](const Seg& a, const Seg& b){ return a.s < b.s; });
-
-    QVector<Seg> merged;
-    for (const auto& s : segs) {
-        if (merged.isEmpty() || s.s > merged.back().e) merged.push_back(s);
-        else merged.back().e = std::max(merged.back().e, s.e);
-    }
-
-    // Invert merged to get free windows
+    // Sweep: every start beyond the covered prefix opens a gap
     QVector<Slot> freeSlots;
-    QDateTime cur = dayStart;
+    auto addGap = [&](qint64 a, qint64 b) {
+        if (b - a >= minMs)
+            freeSlots.push_back({ QDateTime::fromMSecsSinceEpoch(a), QDateTime::fromMSecsSinceEpoch(b) });
+    };
 
-    for (const auto& m : merged) {
-        if (cur < m.s && minutesBetween(cur, m.s) >= minBlockMin)
-            freeSlots.push_back({cur, m.s});
-        cur = std::max(cur, m.e);
+    qint64 cur = dayStart;
+    for (const auto& sg : segs) {
+        if (sg.first > cur) addGap(cur, sg.first);
+        cur = std::max(cur, sg.second);
     }
-
-    if (cur < dayEnd && minutesBetween(cur, dayEnd) >= minBlockMin)
-        freeSlots.push_back({cur, dayEnd});
+    if (cur < dayEnd) addGap(cur, dayEnd);
 
     return freeSlots;
 }
@@ -313,33 +346,36 @@ QVector<SuperAI::Slot> SuperAI::freeWindows(const QDate& day,
  *  - circadian anchors (morning/afternoon preference)
  *  - slot length (up to 120m)
  *  - “earliness” (sooner slots get a small boost)
+ * Each factor is scaled by its PlannerWeights entry (setWeights()).
  */
 double SuperAI::slotScore(const Slot& window, const Task& t) const {
     const int durMin = minutesBetween(window.start, window.end);
     if (durMin < 15) return -1e9; // unusable
 
     const int h = window.start.time().hour();
+    const QDateTime now = m_planNow.isValid() ? m_planNow : this->now();
 
     // Circadian bias
     double circ = 0.0;
-    if (t.mustMorning)    circ += (h>=7  && h<=12) ? 1.0 : -0.3;
-    if (t.mustAfternoon)  circ += (h>=13 && h<=17) ? 1.0 : -0.3;
+    if (t.mustMorning)    circ += (h>=7  && h<=12) ? 1.0 : -m_weights.circadianMiss;
+    if (t.mustAfternoon)  circ += (h>=13 && h<=17) ? 1.0 : -m_weights.circadianMiss;
 
     // Deadline urgency (linear within ~1 week)
     double urgency = 0.0;
     if (t.deadline.isValid()) {
-        const int minsLeft = int(QDateTime::currentDateTime().secsTo(t.deadline)/60);
+        const int minsLeft = int(now.secsTo(t.deadline)/60);
         urgency = std::clamp(1.0 - (minsLeft / (60.0*24*7.0)), 0.0, 1.0);
     }
 
     // Small preference for earlier start & longer windows
-    const double early  = 1.0 / std::max(1.0, double(QDateTime::currentDateTime().secsTo(window.start))/3600.0);
+    const double early  = 1.0 / std::max(1.0, double(now.secsTo(window.start))/3600.0);
     const double length = std::min(1.0, durMin / 120.0);
 
     // Normalize priority (1..5) to 0..1
     const double pr = (t.priority - 1) / 4.0;
 
-    return 1.8*pr + 1.4*urgency + 0.8*circ + 0.5*length + 0.2*early;
+    const PlannerWeights& w = m_weights;
+    return w.priority*pr + w.urgency*urgency + w.circadian*circ + w.length*length + w.early*early;
 }
 
 /**
@@ -421,36 +457,44 @@ QVector<Event> SuperAI::scheduleTasksIntoWindows(const QDate& /*day*/,
 /**
  * @brief scheduleHabits
  * Chooses one window per habit; light scoring by anchor and priority.
+ * Blocks are carved out of their window, so habits never share a start.
  */
-QVector<Event> SuperAI::scheduleHabits(const QDate& /*day*/,
+QVector<Event> SuperAI::scheduleHabits(const QDate& day,
                                        const QVector<Slot>& windows,
                                        const QVector<Habit>& habits) const {
-    QVector<Event> out;
-
-    for (const auto& h : habits) {
-        int    bestIdx = -1;
-        double best    = -1e9;
-
-        for (int i=0;i<windows.size();++i) {
-            const int startH = windows[i].start.time().hour();
+    HabitEngine engine(m_weights);
+    engine.reset(day, { windows });
+    engine.addHabits(habits);
 
-            // Prefer longer windows a bit; bias per “anchor”; plus priority
-            double sc = 0.2 * (minutesBetween(windows[i].start, windows[i].end)/60.0);
-            if (h.anchor=="morning")     sc += (startH<=11)                  ? 1.0 : -0.2;
-            if (h.anchor=="after-lunch") sc += (startH>=12 && startH<=15)    ? 1.0 : -0.2;
-            if (h.anchor=="evening")     sc += (startH>=17)                  ? 1.0 : -0.2;
-            sc += 0.5 * ((h.priority-1)/4.0);
-
-            if (sc > best) { best = sc; bestIdx = i; }
-        }
+    QVector<Event> out;
+    for (const auto& p : engine.placements())
+        out.push_back(mkEvent(QString("🟢 %1").arg(p.habit), p.start, p.end, kHabitGreen()));
+    return out;
+}
 
-        if (bestIdx >= 0) {
-            const QDateTime s = windows[bestIdx].start;
-            const QDateTime e = s.addSecs(h.targetMinPerDay*60);
-            out.push_back(mkEvent(QString("🟢 %1").arg(h.title), s, e, kHabitGreen()));
-        }
-    }
+/**
+ * @brief planHabitsWeek
+ * Builds the free-window index for each day once, then lets HabitEngine
+ * place all habits incrementally across the span.
+ */
+QVector<Event> SuperAI::planHabitsWeek(const QDate& first,
+                                       const QVector<Event>& existing,
+                                       const QVector<Habit>& habits,
+                                       const QVector<Event>& history,
+                                       int days) const {
+    QVector<QVector<Slot>> windows;
+    windows.reserve(days);
+    for (int d = 0; d < days; ++d)
+        windows.push_back(freeWindows(first.addDays(d), existing, 15));
+
+    HabitEngine engine(m_weights);
+    engine.reset(first, windows);
+    engine.setHistory(history, now().date());
+    engine.addHabits(habits);
 
+    QVector<Event> out;
+    for (const auto& p : engine.placements())
+        out.push_back(mkEvent(QString("🟢 %1").arg(p.habit), p.start, p.end, kHabitGreen()));
     return out;
 }
 
@@ -471,25 +515,44 @@ QVector<Event> SuperAI::planDay(const QDate& day,
                                 const QVector<Event>& existing,
                                 const QVector<Task>& tasks,
                                 const QVector<Habit>& habits) {
+    // One clock read per plan keeps scoring consistent (and replayable)
+    m_planNow = now();
+    QElapsedTimer timer; timer.start();
+
+    const QVector<Task>&  useTasks  = tasks.isEmpty()  ? m_tasks  : tasks;
+    const QVector<Habit>& useHabits = habits.isEmpty() ? m_habits : habits;
+
     // 1) Free windows before planning
     const auto freeSlots = freeWindows(day, existing, /*minBlockMin*/15);
 
     // 2) Tasks into those windows
-    const auto plannedTasks  = scheduleTasksIntoWindows(day,
-                                                        freeSlots,
-                                                        tasks.isEmpty()? m_tasks : tasks);
+    const auto plannedTasks  = scheduleTasksIntoWindows(day, freeSlots, useTasks);
 
     // 3) Recompute free windows with the new task blocks
     QVector<Event> busy = existing; busy += plannedTasks;
     const auto freeAfterTasks = freeWindows(day, busy, 15);
 
     //    Habits in the remaining time
-    const auto plannedHabits = scheduleHabits(day,
-                                              freeAfterTasks,
-                                              habits.isEmpty()? m_habits : habits);
+    const auto plannedHabits = scheduleHabits(day, freeAfterTasks, useHabits);
 
     // 4) Merge & summarize
     QVector<Event> all = plannedTasks; all += plannedHabits;
+    const qint64 elapsedNs = timer.nsecsElapsed();
+
+    if (m_recorder) {
+        PlannerRecorder::Session s;
+        s.day       = day;
+        s.now       = m_planNow;
+        s.settings  = { { "minBlockMin", 15 }, { "bufferPreMin", 5 }, { "bufferPostMin", 10 },
+                        { "weights", m_weights.toMap() } };
+        s.existing  = existing;
+        s.tasks     = useTasks;
+        s.habits    = useHabits;
+        s.output    = all;
+        s.elapsedNs = elapsedNs;
+        m_recorder->record(s);
+    }
+    m_planNow = QDateTime();
 
     int totalTaskMin = 0;
     for (const auto& e : plannedTasks)
@@ -7,8 +7,13 @@
 #include <QStringList>
 #include <QVector>
 #include <QColor>
+#include <functional>
 
 #include "Event.h" // Event(title, description, start, end, color)
+#include "EventColumns.h"
+#include "PlannerWeights.h"
+
+class PlannerRecorder;
 
 /**
  * @brief SuperAI
@@ -59,6 +64,27 @@ public:
         int     targetMinPerDay = 20; ///< desired minutes to schedule
         QString anchor;               ///< "morning", "after-lunch", "evening" (soft bias)
         int     priority = 3;         ///< 1..5 (5 = highest)
+        int     daysPerWeek = 7;      ///< week planning: how many days get a block
+    };
+
+    /**
+     * @brief StressScore
+     * Numbers behind analyzeStress(); all 0..100.
+     */
+    struct StressScore {
+        int load     = 0;   ///< density (total minutes / 6)
+        int recovery = 0;   ///< gaps between blocks (minutes / 3)
+        int risk     = 0;   ///< load - recovery/2
+    };
+
+    /**
+     * @brief BalanceScore
+     * Numbers behind optimizeWorkLifeBalance().
+     */
+    struct BalanceScore {
+        int score       = 0;   ///< 0..100
+        int focusMin    = 0;
+        int recoveryMin = 0;
     };
 
     // ---------------------------------------------------------------------
@@ -72,6 +98,9 @@ public:
      */
     void analyzeSchedule(const QVector<Event>& events);
 
+    /// Same summary from a columnar snapshot (no per-Event QDateTime/QString access).
+    void analyzeSchedule(const EventColumns& cols);
+
     /**
      * @brief generateSmartSuggestions
      * Plans the given date using current pools (m_tasks/m_habits) only.
@@ -114,6 +143,10 @@ public:
      */
     void optimizeWorkLifeBalance(const QVector<Event>& events);
 
+    /// Pure metric versions of analyzeStress()/optimizeWorkLifeBalance() (no signals).
+    static StressScore  stressScore(const QVector<Event>& events);
+    static BalanceScore balanceScore(const QVector<Event>& events);
+
     /**
      * @brief planDay
      * Orchestrates planning for a day:
@@ -140,6 +173,74 @@ public:
     const QVector<Task>&   tasks()  const { return m_tasks;  }
     const QVector<Habit>&  habits() const { return m_habits; }
 
+    // ---------------------------------------------------------------------
+    // Determinism / diagnostics
+    // ---------------------------------------------------------------------
+
+    /// Clock read once per planDay() (urgency, earliness); injectable for replay.
+    void setClock(std::function<QDateTime()> now) { m_now = std::move(now); }
+
+    /// Record every planDay() call (inputs, now, outputs, timing); nullptr = off. Not owned.
+    void setRecorder(PlannerRecorder* rec) { m_recorder = rec; }
+
+    /// Scoring weights for slotScore()/scheduleHabits(); defaults = original heuristics.
+    void setWeights(const PlannerWeights& w) { m_weights = w; }
+    const PlannerWeights& weights() const { return m_weights; }
+
+    // ---------------------------------------------------------------------
+    // Planner kernels (public so tools/diff_harness can check them against
+    // PlannerReference; the UI only calls planDay())
+    // ---------------------------------------------------------------------
+
+    /// Simple time window used during planning.
+    struct Slot { QDateTime start; QDateTime end; };
+
+    /**
+     * @brief freeWindows
+     * Compute free Slots in [06:00, 22:00] for @day given busy events.
+     * Merges overlaps and enforces minBlockMin.
+     */
+    QVector<Slot> freeWindows(const QDate& day,
+                              const QVector<Event>& busy,
+                              int minBlockMin = 15) const;
+
+    /**
+     * @brief slotScore
+     * Suitability of a free Slot for a Task (priority, urgency, circadian, length, earliness).
+     */
+    double slotScore(const Slot& window, const Task& t) const;
+
+    /**
+     * @brief scheduleTasksIntoWindows
+     * Greedy carving of tasks into free windows, inserting small pre/post buffers.
+     */
+    QVector<Event> scheduleTasksIntoWindows(const QDate& day,
+                                            const QVector<Slot>& windows,
+                                            QVector<Task> tasks) const;
+
+    /**
+     * @brief scheduleHabits
+     * Places one block per habit into remaining windows using a light bias by
+     * anchor/priority (HabitEngine on a single day: blocks are carved, never overlap).
+     */
+    QVector<Event> scheduleHabits(const QDate& day,
+                                  const QVector<Slot>& windows,
+                                  const QVector<Habit>& habits) const;
+
+    /**
+     * @brief planHabitsWeek
+     * Habit blocks for @days days from @first around @existing, honouring
+     * daysPerWeek, anchors and the daily cap; @history feeds streaks (HabitEngine).
+     */
+    QVector<Event> planHabitsWeek(const QDate& first,
+                                  const QVector<Event>& existing,
+                                  const QVector<Habit>& habits,
+                                  const QVector<Event>& history = {},
+                                  int days = 7) const;
+
+    /// Planner clock: setClock() if given, otherwise the wall clock.
+    QDateTime now() const { return m_now ? m_now() : QDateTime::currentDateTime(); }
+
 signals:
     // High-level text outputs
     void analysisComplete(const QString& text);
@@ -149,6 +250,9 @@ signals:
     void stressAnalysisReady(const QString& text);
     void optimizationReady(const QString& text);
 
+    // Task pool replaced (setTasks)
+    void tasksChanged();
+
     // Concrete block suggestions (used by multiple UI surfaces)
     void suggestionsReady(const QList<Event>& events);
     void plannedEventsReady(const QVector<Event>& suggestions);
@@ -158,18 +262,6 @@ private:
     // Internal helpers
     // ---------------------------------------------------------------------
 
-    /// Simple time window used during planning.
-    struct Slot { QDateTime start; QDateTime end; };
-
-    /**
-     * @brief freeWindows
-     * Compute free Slots in [06:00, 22:00] for @day given busy events.
-     * Merges overlaps and enforces minBlockMin.
-     */
-    QVector<Slot> freeWindows(const QDate& day,
-                              const QVector<Event>& busy,
-                              int minBlockMin = 15) const;
-
     /**
      * @brief mkEvent
      * Convenience factory: uses title for both title and description.
@@ -193,29 +285,12 @@ private:
     static int overlapMin(const QDateTime& a1, const QDateTime& a2,
                           const QDateTime& b1, const QDateTime& b2);
 
-    /**
-     * @brief slotScore
-     * Suitability of a free Slot for a Task (priority, urgency, circadian, length, earliness).
-     */
-    double slotScore(const Slot& window, const Task& t) const;
-
-    /**
-     * @brief scheduleTasksIntoWindows
-     * Greedy carving of tasks into free windows, inserting small pre/post buffers.
-     */
-    QVector<Event> scheduleTasksIntoWindows(const QDate& day,
-                                            const QVector<Slot>& windows,
-                                            QVector<Task> tasks) const;
-
-    /**
-     * @brief scheduleHabits
-     * Places one block per habit into remaining windows using a light bias by anchor/priority.
-     */
-    QVector<Event> scheduleHabits(const QDate& day,
-                                  const QVector<Slot>& windows,
-                                  const QVector<Habit>& habits) const;
-
 private:
     QVector<Task>  m_tasks;   ///< task pool used by generateSmartSuggestions/planDay
     QVector<Habit> m_habits;  ///< habit pool used by generateSmartSuggestions/planDay
+
+    std::function<QDateTime()> m_now;        ///< null = wall clock
+    QDateTime                  m_planNow;    ///< "now" of the planDay() in progress
+    PlannerRecorder*           m_recorder = nullptr;
+    PlannerWeights             m_weights;
 };
@@ -0,0 +1,297 @@
+#include "SyncEngine.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <algorithm>  // std::sort, std::max
+
+// ============================================================================
+// SyncEngine.cpp
+// Folder-based delta replication with hybrid logical clocks.
+//
+// Delta file (after qUncompress):
+//   { "v":1, "node":"<id>", "seq":N,
+//     "changes":[ { "uid":"…", "hlc":"<wallMs>:<counter>:<node>", "del":true }
+//               | { "uid":"…", "hlc":"…", "ev":{ Event::toJson() } } ] }
+// ============================================================================
+
+static constexpr int kFormatVersion = 1;
+static const char*   kDeltaSuffix   = ".delta";
+
+bool operator<(const SyncEngine::Hlc& a, const SyncEngine::Hlc& b) {
+    if (a.wallMs  != b.wallMs)  return a.wallMs  < b.wallMs;
+    if (a.counter != b.counter) return a.counter < b.counter;
+    return a.node < b.node;   // deterministic tie-break across devices
+}
+
+QString SyncEngine::Hlc::toString() const {
+    return QString("%1:%2:%3").arg(wallMs).arg(counter).arg(node);
+}
+
+SyncEngine::Hlc SyncEngine::Hlc::fromString(const QString& s) {
+    Hlc h;
+    const int a = s.indexOf(':');
+    const int b = a < 0 ? -1 : s.indexOf(':', a + 1);
+    if (a < 0 || b < 0) return h;
+    h.wallMs  = s.left(a).toLongLong();
+    h.counter = s.mid(a + 1, b - a - 1).toUInt();
+    h.node    = s.mid(b + 1);
+    return h;
+}
+
+SyncEngine::SyncEngine(const QString& nodeId,
+                       const QString& sharedDir,
+                       const QString& stateFile,
+                       QObject* parent)
+    : QObject(parent)
+    , m_node(nodeId)
+    , m_shared(sharedDir)
+    , m_stateFile(stateFile)
+    , m_nowMs([]{ return QDateTime::currentMSecsSinceEpoch(); })
+{
+    m_clock.node = m_node;
+    loadState();
+    QDir().mkpath(nodeDir(m_node));
+}
+
+
+// ============================================================================
+// Hybrid logical clock
+// ============================================================================
+
+SyncEngine::Hlc SyncEngine::tick() {
+    const qint64 pt = m_nowMs();
+    if (pt > m_clock.wallMs) { m_clock.wallMs = pt; m_clock.counter = 0; }
+    else                     { ++m_clock.counter; }
+    m_clock.node = m_node;
+    return m_clock;
+}
+
+void SyncEngine::observe(const Hlc& r) {
+    const qint64 pt = m_nowMs();
+    const qint64 l  = std::max({ m_clock.wallMs, r.wallMs, pt });
+    if      (l == m_clock.wallMs && l == r.wallMs) m_clock.counter = std::max(m_clock.counter, r.counter) + 1;
+    else if (l == m_clock.wallMs)                  m_clock.counter = m_clock.counter + 1;
+    else if (l == r.wallMs)                        m_clock.counter = r.counter + 1;
+    else                                           m_clock.counter = 0;
+    m_clock.wallMs = l;
+    m_clock.node   = m_node;
+}
+
+
+// ============================================================================
+// Local edits
+// ============================================================================
+
+void SyncEngine::recordUpsert(const Event& e) {
+    if (e.uid().isEmpty()) return;
+    Change c;
+    c.uid   = e.uid();
+    c.stamp = tick();
+    c.event = e;
+    m_versions.insert(c.uid, c.stamp);
+    m_pending.insert(c.uid, c);   // later edits to the same uid overwrite
+}
+
+void SyncEngine::recordDelete(const QString& uid) {
+    if (uid.isEmpty()) return;
+    Change c;
+    c.uid     = uid;
+    c.stamp   = tick();
+    c.deleted = true;
+    m_versions.insert(uid, c.stamp);
+    m_pending.insert(uid, c);
+}
+
+void SyncEngine::resetReplica() {
+    m_cursors.clear();
+    m_versions.clear();
+    for (const Change& c : std::as_const(m_pending)) m_versions.insert(c.uid, c.stamp);
+    m_replayOwn = true;
+}
+
+QString SyncEngine::nodeDir(const QString& node) const {
+    return QDir(m_shared).filePath(node);
+}
+
+bool SyncEngine::publish() {
+    if (m_pending.isEmpty()) return true;
+
+    QJsonArray arr;
+    for (const Change& c : std::as_const(m_pending)) {
+        QJsonObject o;
+        o["uid"] = c.uid;
+        o["hlc"] = c.stamp.toString();
+        if (c.deleted) o["del"] = true;
+        else           o["ev"]  = c.event.toJson();
+        arr.append(o);
+    }
+
+    const quint64 seq = m_seq + 1;
+    QJsonObject doc;
+    doc["v"]       = kFormatVersion;
+    doc["node"]    = m_node;
+    doc["seq"]     = QString::number(seq);
+    doc["changes"] = arr;
+
+    // Zero-padded names sort naturally; QSaveFile renames atomically so peers
+    // never observe a half-written delta.
+    const QString name = QString("%1%2").arg(seq, 12, 10, QChar('0')).arg(kDeltaSuffix);
+    QSaveFile f(QDir(nodeDir(m_node)).filePath(name));
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(qCompress(QJsonDocument(doc).toJson(QJsonDocument::Compact)));
+    if (!f.commit()) return false;
+
+    m_seq = seq;
+    m_pending.clear();
+    saveState();
+    return true;
+}
+
+
+// ============================================================================
+// Remote changes
+// ============================================================================
+
+QVector<SyncEngine::Change> SyncEngine::pull() {
+    QHash<QString, Change> winners;
+
+    const QDir root(m_shared);
+    const QStringList peers = root.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& peer : peers) {
+        if (peer == m_node && !m_replayOwn) continue;
+
+        const quint64 cursor = m_cursors.value(peer, 0);
+        QDir dir(root.filePath(peer));
+
+        // Collect unseen sequence numbers from file names (no file reads yet)
+        QVector<quint64> seqs;
+        const QStringList files = dir.entryList({ QString("*%1").arg(kDeltaSuffix) }, QDir::Files);
+        for (const QString& fn : files) {
+            bool ok = false;
+            const quint64 seq = fn.left(fn.size() - int(qstrlen(kDeltaSuffix))).toULongLong(&ok);
+            if (ok && seq > cursor) seqs.push_back(seq);
+        }
+        std::sort(seqs.begin(), seqs.end());
+
+        for (quint64 seq : seqs) {
+            QFile f(dir.filePath(QString("%1%2").arg(seq, 12, 10, QChar('0')).arg(kDeltaSuffix)));
+            if (!f.open(QIODevice::ReadOnly)) break;   // retry from here next time
+
+            const QJsonDocument doc = QJsonDocument::fromJson(qUncompress(f.readAll()));
+            if (!doc.isObject() || doc.object().value("v").toInt() != kFormatVersion) {
+                m_cursors.insert(peer, seq);          // skip unreadable/foreign files
+                continue;
+            }
+
+            const QJsonArray arr = doc.object().value("changes").toArray();
+            for (const QJsonValue& v : arr) {
+                const QJsonObject o = v.toObject();
+                Change c;
+                c.uid     = o.value("uid").toString();
+                c.stamp   = Hlc::fromString(o.value("hlc").toString());
+                c.deleted = o.value("del").toBool(false);
+                if (c.uid.isEmpty() || c.stamp.isNull()) continue;
+                if (!c.deleted) {
+                    c.event = Event::fromJson(o.value("ev").toObject());
+                    c.event.setUid(c.uid);
+                }
+
+                observe(c.stamp);
+
+                // Last-writer-wins on HLC; equal stamps are the same change
+                const auto cur = m_versions.constFind(c.uid);
+                if (cur != m_versions.constEnd() && !(*cur < c.stamp)) continue;
+
+                m_versions.insert(c.uid, c.stamp);
+                m_pending.remove(c.uid);   // our unpublished edit lost the race
+                winners.insert(c.uid, c);
+            }
+            m_cursors.insert(peer, seq);
+        }
+    }
+
+    m_replayOwn = false;
+    saveState();
+
+    QVector<Change> out;
+    out.reserve(winners.size());
+    for (const Change& c : std::as_const(winners)) out.push_back(c);
+    if (!out.isEmpty()) emit remoteChangesReady(out);
+    return out;
+}
+
+
+// ============================================================================
+// Local state
+// ============================================================================
+
+bool SyncEngine::loadState() {
+    QFile f(m_stateFile);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+    const QJsonObject o = QJsonDocument::fromJson(f.readAll()).object();
+    if (o.value("node").toString() != m_node) return false;   // state of another install
+
+    m_seq   = o.value("seq").toString().toULongLong();
+    m_clock = Hlc::fromString(o.value("clock").toString());
+    m_clock.node = m_node;
+
+    const QJsonObject cur = o.value("cursors").toObject();
+    for (auto it = cur.begin(); it != cur.end(); ++it)
+        m_cursors.insert(it.key(), it.value().toString().toULongLong());
+
+    const QJsonObject ver = o.value("versions").toObject();
+    for (auto it = ver.begin(); it != ver.end(); ++it)
+        m_versions.insert(it.key(), Hlc::fromString(it.value().toString()));
+
+    const QJsonArray pend = o.value("pending").toArray();
+    for (const QJsonValue& v : pend) {
+        const QJsonObject p = v.toObject();
+        Change c;
+        c.uid     = p.value("uid").toString();
+        c.stamp   = Hlc::fromString(p.value("hlc").toString());
+        c.deleted = p.value("del").toBool(false);
+        if (!c.deleted) c.event = Event::fromJson(p.value("ev").toObject());
+        if (!c.uid.isEmpty()) m_pending.insert(c.uid, c);
+    }
+    return true;
+}
+
+bool SyncEngine::saveState() const {
+    QJsonObject cur;
+    for (auto it = m_cursors.cbegin(); it != m_cursors.cend(); ++it)
+        cur[it.key()] = QString::number(it.value());
+
+    QJsonObject ver;
+    for (auto it = m_versions.cbegin(); it != m_versions.cend(); ++it)
+        ver[it.key()] = it.value().toString();
+
+    QJsonArray pend;
+    for (const Change& c : m_pending) {
+        QJsonObject p;
+        p["uid"] = c.uid;
+        p["hlc"] = c.stamp.toString();
+        if (c.deleted) p["del"] = true;
+        else           p["ev"]  = c.event.toJson();
+        pend.append(p);
+    }
+
+    QJsonObject o;
+    o["node"]     = m_node;
+    o["seq"]      = QString::number(m_seq);
+    o["clock"]    = m_clock.toString();
+    o["cursors"]  = cur;
+    o["versions"] = ver;
+    o["pending"]  = pend;
+
+    QDir().mkpath(QFileInfo(m_stateFile).absolutePath());
+    QSaveFile f(m_stateFile);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(QJsonDocument(o).toJson(QJsonDocument::Compact));
+    return f.commit();
+}
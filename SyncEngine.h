@@ -0,0 +1,117 @@
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+#include "Event.h"
+
+/**
+ * @brief SyncEngine
+ * Delta sync of events between installations through a shared directory.
+ *
+ * Layout of the shared directory
+ *   <shared>/<nodeId>/<seq>.delta   one file per publish(), written atomically
+ *
+ * Each delta file holds only the events changed since the previous publish,
+ * serialized with Event::toJson() and qCompress'ed. Every change carries a
+ * hybrid logical clock (HLC) stamp; the highest stamp wins, so all nodes
+ * converge on the same result regardless of the order they read files in.
+ *
+ * Notes
+ *  - Events are matched by Event::uid(); events without a uid are not synced.
+ *  - Sync cost is proportional to the number of changes: publish() writes the
+ *    pending set, pull() reads only files newer than the per-peer cursor.
+ *  - Local state (cursors, winning stamps, unpublished changes) is kept in a
+ *    small JSON file so restarts don't resend or re-apply anything.
+ */
+class SyncEngine : public QObject {
+    Q_OBJECT
+public:
+    /// Hybrid logical clock stamp: (wall ms, counter, node) ordered lexicographically.
+    struct Hlc {
+        qint64  wallMs  = 0;
+        quint32 counter = 0;
+        QString node;
+
+        bool isNull() const { return wallMs == 0 && counter == 0 && node.isEmpty(); }
+        QString toString() const;
+        static Hlc fromString(const QString& s);
+    };
+
+    /// One replicated change (upsert when !deleted, tombstone otherwise).
+    struct Change {
+        QString uid;
+        Hlc     stamp;
+        bool    deleted = false;
+        Event   event;           ///< valid only when !deleted
+    };
+
+    SyncEngine(const QString& nodeId,
+               const QString& sharedDir,
+               const QString& stateFile,
+               QObject* parent = nullptr);
+
+    const QString& nodeId()    const { return m_node; }
+    const QString& sharedDir() const { return m_shared; }
+
+    // ---------------------------------------------------------------------
+    // Local edits (queued until publish())
+    // ---------------------------------------------------------------------
+    void recordUpsert(const Event& e);
+    void recordDelete(const QString& uid);
+    bool hasPending() const { return !m_pending.isEmpty(); }
+    bool knows(const QString& uid) const { return m_versions.contains(uid); }
+
+    /**
+     * @brief resetReplica
+     * Forget cursors and stamps so the next pull() replays every delta in the
+     * shared folder, including our own. Used when the local calendar starts empty.
+     */
+    void resetReplica();
+
+    /**
+     * @brief publish
+     * Writes all pending changes as one delta file. No-op when nothing is pending.
+     * @return false on I/O error (pending changes are kept for the next try)
+     */
+    bool publish();
+
+    /**
+     * @brief pull
+     * Reads unseen peer delta files, resolves conflicts and returns the
+     * winning changes (at most one per uid) that the caller should apply.
+     * Emits: remoteChangesReady(QVector<Change>) when the result is non-empty.
+     */
+    QVector<Change> pull();
+
+    /// Wall clock in ms since epoch; injectable for deterministic runs.
+    void setClock(std::function<qint64()> nowMs) { m_nowMs = std::move(nowMs); }
+
+signals:
+    void remoteChangesReady(const QVector<SyncEngine::Change>& changes);
+
+private:
+    Hlc  tick();                     ///< stamp for a local change
+    void observe(const Hlc& remote); ///< merge a remote stamp into the clock
+
+    QString nodeDir(const QString& node) const;
+    bool loadState();
+    bool saveState() const;
+
+    QString m_node;
+    QString m_shared;
+    QString m_stateFile;
+    std::function<qint64()> m_nowMs;
+
+    Hlc                     m_clock;     ///< last issued/observed stamp
+    quint64                 m_seq = 0;   ///< last published delta sequence
+    QHash<QString, quint64> m_cursors;   ///< peer node → last applied seq
+    QHash<QString, Hlc>     m_versions;  ///< uid → winning stamp (incl. tombstones)
+    QHash<QString, Change>  m_pending;   ///< uid → latest unpublished local change
+    bool                    m_replayOwn = false;  ///< next pull() also reads our own deltas
+};
+
+bool operator<(const SyncEngine::Hlc& a, const SyncEngine::Hlc& b);
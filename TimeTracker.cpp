@@ -0,0 +1,172 @@
+#include "TimeTracker.h"
+
+#include <QDataStream>
+#include <QSettings>
+#include <QUuid>
+#include <algorithm>  // std::min
+
+#include "PlannerRecorder.h"   // local wall-clock ms codec
+
+static constexpr quint32 kTrkMagic   = 0x4554524b; // "ETRK"
+static constexpr quint32 kTrkVersion = 1;
+
+enum : quint8 { kUuidKey = 1, kStringKey = 2, kAdHoc = 3 };
+
+static QString keyOf(const TimeTracker::Interval& iv)
+{
+    return iv.uid.isEmpty() ? "#" + iv.label : iv.uid;
+}
+
+TimeTracker::TimeTracker(QObject* parent) : QObject(parent)
+{
+    m_tick.setInterval(60 * 1000);
+    m_tick.setTimerType(Qt::VeryCoarseTimer);
+    connect(&m_tick, &QTimer::timeout, this, [this]{ emit tick(elapsedSeconds() / 60); });
+}
+
+// ============================================================================
+// Journal
+// ============================================================================
+
+bool TimeTracker::open(const QString& path)
+{
+    m_file.close();
+    m_days.clear();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite)) return false;
+
+    QDataStream ds(&m_file);
+    if (m_file.size() == 0) {
+        ds << kTrkMagic << kTrkVersion;
+    } else {
+        quint32 magic = 0, version = 0;
+        ds >> magic >> version;
+        if (magic != kTrkMagic || version != kTrkVersion) { m_file.close(); return false; }
+
+        qint64 good = m_file.pos();   // end of the last complete record
+        while (!ds.atEnd()) {
+            quint8 kind = 0; Interval iv; qint64 wall = 0; quint32 secs = 0;
+            ds >> kind;
+            if (kind == kUuidKey) {
+                QByteArray raw(16, Qt::Uninitialized);
+                if (ds.readRawData(raw.data(), 16) != 16) break;
+                iv.uid = QUuid::fromRfc4122(raw).toString(QUuid::WithoutBraces);
+            } else if (kind == kStringKey) {
+                ds >> iv.uid;
+            } else if (kind == kAdHoc) {
+                ds >> iv.label;
+            } else {
+                break;
+            }
+            ds >> wall >> secs;
+            if (ds.status() != QDataStream::Ok) break;   // truncated tail
+            iv.start   = PlannerRecorder::fromWallMs(wall);
+            iv.seconds = int(secs);
+            aggregate(iv);
+            good = m_file.pos();
+        }
+        // Drop a partial record (crash mid-write) so new ones don't land behind it
+        if (good < m_file.size() && !m_file.resize(good)) { m_file.close(); return false; }
+    }
+    m_file.seek(m_file.size());
+
+    // Resume a session left running by the previous run
+    QSettings s;
+    if (!m_running && s.contains("tracking/running/start")) {
+        m_cur = {};
+        m_cur.uid   = s.value("tracking/running/uid").toString();
+        m_cur.label = s.value("tracking/running/label").toString();
+        m_cur.start = PlannerRecorder::fromWallMs(s.value("tracking/running/start").toLongLong());
+        m_offsetMs  = std::max<qint64>(0, m_cur.start.msecsTo(QDateTime::currentDateTime()));
+        m_mono.start();
+        m_running = true;
+        m_tick.start();
+        emit started(m_cur);
+    }
+    return true;
+}
+
+bool TimeTracker::writeRecord(const Interval& iv)
+{
+    if (!isOpen()) return false;
+    QDataStream ds(&m_file);
+    const QUuid id = QUuid::fromString(iv.uid);
+    if (iv.uid.isEmpty())   ds << quint8(kAdHoc) << iv.label;
+    else if (!id.isNull()) { ds << quint8(kUuidKey); ds.writeRawData(id.toRfc4122().constData(), 16); }
+    else                    ds << quint8(kStringKey) << iv.uid;
+    ds << PlannerRecorder::toWallMs(iv.start) << quint32(std::max(0, iv.seconds));
+    return m_file.flush() && ds.status() == QDataStream::Ok;
+}
+
+// Split at local midnight so each day gets its own share
+void TimeTracker::aggregate(const Interval& iv)
+{
+    const QString key = keyOf(iv);
+    QDateTime s = iv.start;
+    int left = iv.seconds;
+    while (left > 0 && s.isValid()) {
+        const QDateTime midnight = s.date().addDays(1).startOfDay();
+        const int part = int(std::min<qint64>(left, s.secsTo(midnight)));
+        m_days[s.date().toJulianDay()][key] += part;
+        left -= part;
+        s = midnight;
+    }
+}
+
+int TimeTracker::dayTotalSeconds(const QDate& d) const
+{
+    int total = 0;
+    for (int v : m_days.value(d.toJulianDay())) total += v;
+    return total;
+}
+
+// ============================================================================
+// Sessions
+// ============================================================================
+
+int TimeTracker::elapsedSeconds() const
+{
+    return m_running ? int((m_offsetMs + m_mono.elapsed()) / 1000) : 0;
+}
+
+void TimeTracker::begin(const QString& uid, const QString& label)
+{
+    stop();
+    m_cur       = {};
+    m_cur.uid   = uid;
+    m_cur.label = label;
+    m_cur.start = QDateTime::currentDateTime();
+    m_offsetMs  = 0;
+    m_mono.start();
+    m_running   = true;
+    m_tick.start();
+
+    QSettings s;
+    s.setValue("tracking/running/uid",   uid);
+    s.setValue("tracking/running/label", label);
+    s.setValue("tracking/running/start", PlannerRecorder::toWallMs(m_cur.start));
+    emit started(m_cur);
+}
+
+void TimeTracker::start(const Event& e)
+{
+    begin(e.uid(), e.getTitle());
+}
+
+void TimeTracker::startAdHoc(const QString& label)
+{
+    begin(QString(), label.trimmed().isEmpty() ? QString("Ad-hoc") : label.trimmed());
+}
+
+void TimeTracker::stop()
+{
+    if (!m_running) return;
+    m_tick.stop();
+    m_running = false;
+    m_cur.seconds = int((m_offsetMs + m_mono.elapsed()) / 1000);
+
+    writeRecord(m_cur);
+    aggregate(m_cur);
+    QSettings().remove("tracking/running");
+    emit stopped(m_cur);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include "Event.h"
+
+/**
+ * @brief TimeTracker
+ * Start/stop tracking of what was actually done, against events or ad hoc.
+ *
+ * Journal layout (append-only, flushed per record)
+ *   "ETRK" magic + version, then one record per finished session:
+ *   quint8 kind (1 = event uid as 16 UUID bytes, 2 = uid string, 3 = ad-hoc label),
+ *   key, qint64 local wall-clock start ms, quint32 seconds
+ * A tracked lecture is ~29 bytes.
+ *
+ * Durations come from QElapsedTimer (monotonic); the wall clock is read
+ * once per session for the start. Per-day totals (split at midnight) are
+ * kept in memory and updated per record, so dashboard queries never scan
+ * the journal.
+ *
+ * Notes
+ *  - While a session runs, tick() fires once a minute (coarse timer); no
+ *    other wake-ups.
+ *  - The running session is mirrored in QSettings ("tracking/running/…")
+ *    so it survives a restart; its duration then also counts the downtime.
+ */
+class TimeTracker : public QObject {
+    Q_OBJECT
+public:
+    struct Interval {
+        QString   uid;       ///< linked event; empty for ad-hoc sessions
+        QString   label;     ///< event title or ad-hoc label
+        QDateTime start;
+        int       seconds = 0;
+    };
+
+    explicit TimeTracker(QObject* parent = nullptr);
+
+    /// Load @path (created if needed), rebuild per-day totals, resume a running session.
+    bool open(const QString& path);
+    bool isOpen() const { return m_file.isOpen(); }
+
+    void start(const Event& e);
+    void startAdHoc(const QString& label);
+    void stop();
+
+    bool            isRunning() const { return m_running; }
+    const Interval& current()   const { return m_cur; }
+    int             elapsedSeconds() const;
+
+    /// Tracked seconds on @d per key: event uid, or "#label" for ad-hoc sessions.
+    QHash<QString, int> daySeconds(const QDate& d) const { return m_days.value(d.toJulianDay()); }
+    int                 dayTotalSeconds(const QDate& d) const;
+
+signals:
+    void started(const TimeTracker::Interval& iv);
+    void stopped(const TimeTracker::Interval& iv);
+    void tick(int elapsedMinutes);
+
+private:
+    void begin(const QString& uid, const QString& label);
+    bool writeRecord(const Interval& iv);
+    void aggregate(const Interval& iv);
+
+    QFile         m_file;
+    QElapsedTimer m_mono;
+    qint64        m_offsetMs = 0;   ///< time already elapsed before m_mono started (resume)
+    Interval      m_cur;
+    bool          m_running = false;
+    QTimer        m_tick;
+    QHash<qint64, QHash<QString, int>> m_days;   ///< Julian day → key → seconds
+};
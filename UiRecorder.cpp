@@ -0,0 +1,260 @@
+#include "UiRecorder.h"
+
+#include <QAbstractButton>
+#include <QApplication>
+#include <QCalendarWidget>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QSettings>
+#include <QWidget>
+
+static const char* kUiFormat  = "edusync-ui-session";
+static constexpr int kUiVersion = 1;
+
+UiRecorder::UiRecorder(const QString& path, QWidget* window, const QVector<Event>& events, QObject* parent)
+    : QObject(parent), m_file(path), m_window(window)
+{
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return;
+
+    QJsonArray evs;
+    for (const Event& e : events) evs.append(e.toJson());
+    const auto* cal = window ? window->findChild<QCalendarWidget*>("UltraCalendar") : nullptr;
+    const QJsonObject head{
+        { "format",   kUiFormat },
+        { "version",  kUiVersion },
+        { "size",     QJsonArray{ window ? window->width() : 0, window ? window->height() : 0 } },
+        { "selected", cal ? cal->selectedDate().toString(Qt::ISODate) : QString() },
+        { "theme",    QSettings().value("theme").toString() },
+        { "events",   evs },
+    };
+    m_file.write(QJsonDocument(head).toJson(QJsonDocument::Compact) + '\n');
+    m_file.flush();
+
+    m_clock.start();
+    qApp->installEventFilter(this);
+}
+
+UiRecorder::~UiRecorder()
+{
+    qApp->removeEventFilter(this);
+}
+
+// ============================================================================
+// Widget paths
+// ============================================================================
+
+static QString segment(const QWidget* w)
+{
+    if (!w->objectName().isEmpty()) return w->objectName();
+    const QString cls = w->metaObject()->className();
+    if (w->isWindow() || !w->parentWidget()) return cls;
+
+    int n = 0;
+    for (const QObject* o : w->parentWidget()->children()) {
+        if (o == w) break;
+        if (o->isWidgetType() && o->objectName().isEmpty() && cls == o->metaObject()->className()) ++n;
+    }
+    return QString("%1#%2").arg(cls).arg(n);
+}
+
+static bool matches(const QWidget* w, const QString& seg)
+{
+    return w->objectName().isEmpty() ? seg == w->metaObject()->className() : seg == w->objectName();
+}
+
+QString UiRecorder::widgetPath(const QWidget* w)
+{
+    QStringList parts;
+    for (; w; w = w->isWindow() ? nullptr : w->parentWidget()) parts.prepend(segment(w));
+    return parts.join('/');
+}
+
+QWidget* UiRecorder::resolve(const QString& path)
+{
+    const QStringList parts = path.split('/');
+    if (parts.isEmpty()) return nullptr;
+
+    // The modal dialog on top wins; otherwise the first visible window by that name
+    QWidget* w = QApplication::activeModalWidget();
+    if (!w || !matches(w, parts.first())) {
+        w = nullptr;
+        for (QWidget* top : QApplication::topLevelWidgets())
+            if (top->isVisible() && matches(top, parts.first())) { w = top; break; }
+    }
+
+    for (int i = 1; w && i < parts.size(); ++i) {
+        const QString& seg = parts[i];
+        const int hash = seg.lastIndexOf('#');
+        const QString cls = hash > 0 ? seg.left(hash) : QString();
+        const int nth = hash > 0 ? seg.mid(hash + 1).toInt() : 0;
+
+        QWidget* next = nullptr;
+        int n = 0;
+        for (QObject* o : w->children()) {
+            if (!o->isWidgetType()) continue;
+            if (cls.isEmpty()) {
+                if (o->objectName() == seg) { next = static_cast<QWidget*>(o); break; }
+            } else if (o->objectName().isEmpty() && cls == o->metaObject()->className() && n++ == nth) {
+                next = static_cast<QWidget*>(o);
+                break;
+            }
+        }
+        w = next;
+    }
+    return w;
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+QString UiRecorder::labelFor(const QWidget* w, const QEvent* ev) const
+{
+    if (m_window && w->window() != m_window)
+        return (m_dialogOwner.isEmpty() ? QStringLiteral("other") : m_dialogOwner) + ":dialog";
+
+    const int key = ev->type() == QEvent::KeyPress ? static_cast<const QKeyEvent*>(ev)->key() : 0;
+    for (const QWidget* p = w; p; p = p->parentWidget()) {
+        const QString name = p->objectName();
+        if (name == "UltraCalendar") {
+            if (key == Qt::Key_PageUp || key == Qt::Key_PageDown) return "month-flip";
+            if (key >= Qt::Key_Left && key <= Qt::Key_Down)      return "arrow-nav";
+            return key ? "calendar-key" : "date-click";
+        }
+        if (name == "PrevMonth" || name == "NextMonth") return "month-flip";
+        if (name == "AddEvent")    return "add";
+        if (name == "AcceptPlan")  return "accept";
+        if (name == "EditEvent")   return "edit";
+        if (name == "DeleteEvent") return "delete";
+        if (name == "QuickAdd")
+            return key == Qt::Key_Return || key == Qt::Key_Enter ? "quick-add:commit" : "quick-add";
+        if (name.startsWith("Ai") && qobject_cast<const QAbstractButton*>(p)) return "ai:" + name.mid(2).toLower();
+    }
+    return "other";
+}
+
+bool UiRecorder::eventFilter(QObject* obj, QEvent* ev)
+{
+    const QEvent::Type type = ev->type();
+    const bool mouse = type == QEvent::MouseButtonPress || type == QEvent::MouseButtonRelease
+                    || type == QEvent::MouseButtonDblClick;
+    const bool key   = type == QEvent::KeyPress || type == QEvent::KeyRelease;
+    if ((!mouse && !key) || !ev->spontaneous() || !obj->isWidgetType() || !m_file.isOpen())
+        return QObject::eventFilter(obj, ev);
+
+    // Unhandled input is offered to the parents as the same event object
+    const auto* ie = static_cast<const QInputEvent*>(ev);
+    if (ev == m_last && ie->timestamp() == m_lastStamp) return QObject::eventFilter(obj, ev);
+    m_last      = ev;
+    m_lastStamp = ie->timestamp();
+
+    const auto* w = static_cast<const QWidget*>(obj);
+    Input in;
+    in.t    = m_clock.elapsed();
+    in.path = widgetPath(w);
+    in.mods = ie->modifiers().toInt();
+
+    bool starts = false;
+    if (mouse) {
+        const auto* me = static_cast<const QMouseEvent*>(ev);
+        in.type    = type == QEvent::MouseButtonPress ? "press"
+                   : type == QEvent::MouseButtonRelease ? "release" : "dblclick";
+        in.pos     = me->position().toPoint();
+        in.button  = int(me->button());
+        in.buttons = me->buttons().toInt();
+        starts     = type == QEvent::MouseButtonPress;
+    } else {
+        const auto* ke = static_cast<const QKeyEvent*>(ev);
+        in.type   = type == QEvent::KeyPress ? "keydown" : "keyup";
+        in.key    = ke->key();
+        in.text   = ke->text();
+        in.repeat = ke->isAutoRepeat();
+        const bool modifier = in.key == Qt::Key_Shift || in.key == Qt::Key_Control
+                           || in.key == Qt::Key_Alt   || in.key == Qt::Key_Meta;
+        starts = type == QEvent::KeyPress && !in.repeat && !modifier;
+    }
+
+    if (starts || m_action < 0) {
+        ++m_action;
+        m_label = labelFor(w, ev);
+        if (!m_window || w->window() == m_window) m_dialogOwner = m_label;
+    }
+    in.action = m_action;
+    in.label  = m_label;
+    write(in);
+    return QObject::eventFilter(obj, ev);
+}
+
+void UiRecorder::write(const Input& in)
+{
+    QJsonObject o{
+        { "t", in.t }, { "a", in.action }, { "label", in.label },
+        { "type", in.type }, { "path", in.path }, { "mods", in.mods },
+    };
+    if (in.key) {
+        o["key"] = in.key;
+        if (!in.text.isEmpty()) o["text"] = in.text;
+        if (in.repeat)          o["repeat"] = true;
+    } else {
+        o["x"] = in.pos.x();
+        o["y"] = in.pos.y();
+        o["button"]  = in.button;
+        o["buttons"] = in.buttons;
+    }
+    m_file.write(QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n');
+    m_file.flush();   // a crash keeps everything up to the last input
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+bool UiRecorder::load(const QString& path, Session* session, QString* error)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (error) *error = f.errorString();
+        return false;
+    }
+
+    const QJsonObject head = QJsonDocument::fromJson(f.readLine()).object();
+    if (head.value("format").toString() != kUiFormat || head.value("version").toInt() > kUiVersion) {
+        if (error) *error = "not a UI recording (or unsupported version)";
+        return false;
+    }
+
+    Session s;
+    const QJsonArray size = head.value("size").toArray();
+    s.size     = QSize(size.at(0).toInt(), size.at(1).toInt());
+    s.selected = QDate::fromString(head.value("selected").toString(), Qt::ISODate);
+    s.theme    = head.value("theme").toString();
+    for (const QJsonValue& v : head.value("events").toArray()) s.events.push_back(Event::fromJson(v.toObject()));
+
+    while (!f.atEnd()) {
+        const QByteArray line = f.readLine().trimmed();
+        if (line.isEmpty()) continue;
+        QJsonParseError pe;
+        const QJsonObject o = QJsonDocument::fromJson(line, &pe).object();
+        if (pe.error != QJsonParseError::NoError) break;   // truncated tail
+
+        Input in;
+        in.t       = qint64(o.value("t").toDouble());
+        in.action  = o.value("a").toInt();
+        in.label   = o.value("label").toString();
+        in.type    = o.value("type").toString();
+        in.path    = o.value("path").toString();
+        in.pos     = QPoint(o.value("x").toInt(), o.value("y").toInt());
+        in.button  = o.value("button").toInt();
+        in.buttons = o.value("buttons").toInt();
+        in.key     = o.value("key").toInt();
+        in.mods    = o.value("mods").toInt();
+        in.text    = o.value("text").toString();
+        in.repeat  = o.value("repeat").toBool();
+        s.inputs.push_back(in);
+    }
+    *session = s;
+    return true;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <QDate>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QObject>
+#include <QPoint>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+#include "Event.h"
+
+class QEvent;
+class QWidget;
+
+/**
+ * @brief UiRecorder
+ * Records mouse and key input on the application's widgets for headless
+ * replay (tools/ui_replay.cpp), to catch end-to-end latency regressions.
+ *
+ * File layout (JSON lines)
+ *   line 1: header {format, version, size, selected, theme, events[]} —
+ *           the window size, the selected day and the personal events at
+ *           the start, so a replay starts from the same screen.
+ *   then one object per input: {t, a, label, type, path, x, y, button,
+ *           buttons, key, mods, text, repeat}
+ *
+ * Input is grouped into actions (a): a mouse press or a key press starts
+ * one, and its release, a double click or auto-repeat join it. Every
+ * action gets a label ("date-click", "arrow-nav", "month-flip", "add",
+ * "edit", "delete", "ai:<button>", ...) from the widget it hit, so the
+ * replay report can compare like with like. Input inside a dialog is
+ * labelled after the action that opened it ("add:dialog").
+ *
+ * Widgets are addressed by object path from their top-level window:
+ * objectName where set, else "Class#n" among unnamed siblings of the same
+ * class. Positions are local to the widget.
+ *
+ * Notes
+ *  - Only spontaneous input is recorded; mouse moves and wheel are not.
+ *  - Shortcuts are resolved before widgets see the key, so they replay as
+ *    plain key input.
+ */
+class UiRecorder : public QObject {
+    Q_OBJECT
+public:
+    struct Input {
+        qint64  t = 0;           ///< ms since recording started
+        int     action = 0;
+        QString label;
+        QString type;            ///< press | release | dblclick | keydown | keyup
+        QString path;
+        QPoint  pos;
+        int     button = 0, buttons = 0;
+        int     key = 0, mods = 0;
+        QString text;
+        bool    repeat = false;
+    };
+
+    struct Session {
+        QSize          size;
+        QDate          selected;
+        QString        theme;
+        QVector<Event> events;
+        QVector<Input> inputs;
+    };
+
+    /// Starts recording input to @path; @window and @events give the starting screen.
+    UiRecorder(const QString& path, QWidget* window, const QVector<Event>& events,
+               QObject* parent = nullptr);
+    ~UiRecorder() override;
+
+    bool isOpen() const { return m_file.isOpen(); }
+
+    static bool load(const QString& path, Session* session, QString* error = nullptr);
+
+    /// Object path of @w from its window, and back (visible top-levels only).
+    static QString  widgetPath(const QWidget* w);
+    static QWidget* resolve(const QString& path);
+
+protected:
+    bool eventFilter(QObject* obj, QEvent* ev) override;
+
+private:
+    QString labelFor(const QWidget* w, const QEvent* ev) const;
+    void    write(const Input& in);
+
+    QFile            m_file;
+    QPointer<QWidget> m_window;
+    QElapsedTimer    m_clock;
+    int              m_action = -1;
+    QString          m_label;             // current action's label
+    QString          m_dialogOwner;       // label of the last action outside a dialog
+    const QEvent*    m_last = nullptr;    // propagated copies of one event reach the filter again
+    quint64          m_lastStamp = 0;
+};
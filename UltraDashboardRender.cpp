@@ -205,9 +205,7 @@ static inline QString mmLocal(int minutes){
     return QString("%1m").arg(m);
 }
 static inline QString descCategory(const Event& e) {
-    const QString d = e.getDescription();
-    const int i = d.indexOf("::");
-    return (i < 0 ? d : d.left(i)).trimmed();
+    return e.category().trimmed();
 }
 static inline bool isMeetingTitle(const QString& t){
     const QString s = t.toLower();
@@ -216,8 +214,8 @@ static inline bool isMeetingTitle(const QString& t){
         || s.contains("interview");
 }
 
-// Main computation: build stats then render
-QString buildDailyDashboardHtml(const QVector<Event>& events, bool lightTheme, const QDate& day)
+// Main computation: aggregate one day into DayStats
+DayStats computeDayStats(const QVector<Event>& events, const QDate& day)
 {
     DayStats st;
     st.dateLabel = day.toString("ddd, MMM d");
@@ -321,7 +319,11 @@ QString buildDailyDashboardHtml(const QVector<Event>& events, bool lightTheme, c
         TimeBucket{ "Evening",   mmLocal(freeEvening),   eveningSpan>0   ? (freeEvening   *100)/eveningSpan   : 0 },
     };
 
-    // Compose final HTML
+    return st;
+}
+
+QString buildDailyDashboardHtml(const QVector<Event>& events, bool lightTheme, const QDate& day)
+{
     const bool darkTheme = !lightTheme;
-    return buildDashboardHtml(st, darkTheme);
+    return buildDashboardHtml(computeDayStats(events, day), darkTheme);
 }
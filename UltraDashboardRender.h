@@ -49,6 +49,9 @@ struct DayStats {
 // Renders a pretty dashboard page
 QString buildDashboardHtml(const DayStats& s, bool dark);
 
+// Aggregates @day's events (focus/break/exercise, meetings, gaps, free time, moves)
+DayStats computeDayStats(const QVector<Event>& events, const QDate& day);
+
 // Computes stats for a given day then renders the page
 QString buildDailyDashboardHtml(const QVector<Event>& events,
                                 bool lightTheme,
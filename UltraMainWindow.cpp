@@ -39,6 +39,7 @@
 #include <QDebug>
 #include <algorithm>
 #include <QTableView>
+#include <QTableWidget>
 #include <QHeaderView>
 #include <QStyleOptionHeader>
 #include <QPainter>
@@ -46,6 +47,8 @@
 #include <QCheckBox>
 #include <QDateEdit>
 #include <QToolBar>
+#include <QToolButton>
+#include <QMenu>
 #include <QAction>
 #include <QTextCursor>
 #include <QTextList>
@@ -57,12 +60,38 @@
 #include <QStyle>
 #include <QUrl>
 #include <QRegularExpression>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFileDialog>
+#include <QFileSystemWatcher>
+#include <QSpinBox>
+#include <QListView>
+#include <QScrollBar>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QStatusBar>
+#include <QInputDialog>
 
 // Project headers
 #include "ModernCalendarWidget.h"
 #include "SuperAI.h"
+#include "AgendaModel.h"
+#include "PlannerRecorder.h"
 #include "WeekHeaderView.h"          // (currently not used; kept for future)
 #include "UltraDashboardRender.h"    // provides ::buildDailyDashboardHtml(...)
+#include "SyncEngine.h"
+#include "FreeBusy.h"
+#include "ClockService.h"
+#include "TimeTracker.h"
+#include "DayEventsPopup.h"
+#include "CalendarExporter.h"
+#include "WorkloadForecast.h"
+#include "ScenarioEngine.h"
+#include "JobScheduler.h"
 #include <QWebEngineView>
 
 
@@ -81,9 +110,11 @@ static QString ulList(const QStringList& items);
 // ============ Ctor/Dtor =========
 // ===============================
 
-UltraMainWindow::UltraMainWindow(QWidget *parent)
+UltraMainWindow::UltraMainWindow(CalendarStore* store, QWidget *parent)
     : QMainWindow(parent)
     , m_selectedDate(QDate::currentDate())
+    , m_store(store)
+    , m_superAI(store->planner())
 {
     setWindowTitle("🚀 EduSync - AI Calendar");
     setMinimumSize(1600, 1000);
@@ -123,8 +154,7 @@ UltraMainWindow::UltraMainWindow(QWidget *parent)
     // Subtle window animations (no heavy effects).
     setupAnimations();
 
-    // Create AI engine and connect outputs to UI.
-    m_superAI = new SuperAI(this);
+    // Connect the shared AI engine's outputs to this window's UI.
     connect(m_superAI, &SuperAI::analysisComplete,    this, &UltraMainWindow::onAIAnalysisComplete);
     connect(m_superAI, &SuperAI::suggestionsReady,    this, &UltraMainWindow::onAISuggestionsReady);
     connect(m_superAI, &SuperAI::insightsReady,       this, &UltraMainWindow::onAIInsightsReady);
@@ -133,15 +163,53 @@ UltraMainWindow::UltraMainWindow(QWidget *parent)
     connect(m_superAI, &SuperAI::stressAnalysisReady, this, &UltraMainWindow::onAIStressAnalysisReady);
     connect(m_superAI, &SuperAI::optimizationReady,   this, &UltraMainWindow::onAIOptimizationReady);
 
-    // Periodic timers for analytics/progress mock values, etc.
-    m_updateTimer = new QTimer(this);
-    connect(m_updateTimer, &QTimer::timeout, this, &UltraMainWindow::updateAdvancedFeatures);
-    m_updateTimer->start(2000);
+    // This window is a view of the shared store: redraw on its notifications,
+    // whichever window (or sync / archiving) changed it.
+    connect(m_store, &CalendarStore::eventsChanged, this, [this] {
+        if (m_calendar) m_calendar->setEvents(m_store->events());
+        recomposeCalendar();
+        if (m_agenda) m_agenda->refresh();
+        refreshMonthFormats();
+        emit eventsChanged();
+    });
+    connect(m_store, &CalendarStore::layersChanged, this, [this] {
+        rebuildLayerBar();
+        recomposeCalendar();
+        emit layersChanged();
+    });
+    connect(m_store, &CalendarStore::archiveChanged, this, [this] {
+        recomposeCalendar();
+        if (m_agenda) m_agenda->refresh();   // its row keys point into the layer indexes
+    });
+    connect(m_store, &CalendarStore::deadlinesChanged, this, [this] {
+        const auto& risk = m_store->deadlines().atRisk;
+        if (risk.isEmpty()) statusBar()->showMessage("✅ All task deadlines fit", 5000);
+        else statusBar()->showMessage(QString("⚠️ %1 task(s) won't fit before their deadline: %2 (%3 min short)")
+                                      .arg(risk.size()).arg(risk.first().title).arg(risk.first().shortMin), 10000);
+        // After an edit, eventsChanged follows and redraws the dashboard anyway
+        const quint64 gen = m_dashGen;
+        QTimer::singleShot(0, this, [this, gen] {
+            if (gen == m_dashGen && m_selectedDate.isValid()) setDashboardHtml(buildDailyDashboardHtml(m_selectedDate));
+        });
+    });
+
+    // Ctrl+N: another view on the same store (e.g. for a second monitor)
+    auto *newWindow = new QAction("New Window", this);
+    newWindow->setShortcut(QKeySequence::New);
+    connect(newWindow, &QAction::triggered, this, &UltraMainWindow::openNewWindow);
+    addAction(newWindow);
+
+    // Time-driven UI (midnight rollover, event starts/ends, reminders): one timer, no polling
+    setupClock();
+
+    // Actual-time tracking (planned vs actual card on the dashboard)
+    setupTracking();
 
     // (Optional) Other tabs — stubs are included but not added:
     // buildUltraAITab();
     // buildAnalyticsTab();
     // buildProductivityTab();
+    buildAgendaTab();
     buildSettingsTab();
 
     // Wire any AI outputs to the parts of UI already constructed.
@@ -155,12 +223,40 @@ UltraMainWindow::UltraMainWindow(QWidget *parent)
 
     // Kick off initial AI analysis with current (possibly empty) events list.
     QTimer::singleShot(0, this, [this] {
-        if (m_superAI) m_superAI->analyzeSchedule(m_events);
+        if (m_superAI) ai()->analyzeSchedule(m_store->columns());
     });
 }
 
 UltraMainWindow::~UltraMainWindow() = default;
 
+/**
+ * @brief Open another window on the same CalendarStore, on a second screen
+ *        when there is one. It shares events, caches and the planner.
+ */
+void UltraMainWindow::openNewWindow() {
+    auto *w = new UltraMainWindow(m_store);
+    w->setAttribute(Qt::WA_DeleteOnClose);
+
+    const QList<QScreen*> screens = QGuiApplication::screens();
+    const auto other = std::find_if(screens.cbegin(), screens.cend(),
+                                    [this](QScreen* sc) { return sc != screen(); });
+    if (other != screens.cend()) w->move((*other)->availableGeometry().topLeft());
+    else                         w->move(pos() + QPoint(40, 40));
+    w->show();
+}
+
+/**
+ * @brief The planner is shared and answers synchronously; remember that this
+ *        window asked so the other windows ignore the reply.
+ */
+SuperAI* UltraMainWindow::ai() {
+    return m_store->plannerFor(this);
+}
+
+bool UltraMainWindow::ownsAIReply() const {
+    return m_store->plannerView() == this;
+}
+
 
 // ==================================
 // ============ UI: Shell ============
@@ -184,12 +280,22 @@ void UltraMainWindow::setupUltraUI() {
     mainLayout->addWidget(m_mainTabs);
 }
 
+/**
+ * @brief True when nothing the user just did is still on its way to the
+ *        screen: the selected day's details ran and the dashboard rendered.
+ */
+bool UltraMainWindow::isSettled() const {
+    if (m_detailTimer && m_detailTimer->isActive()) return false;
+    return m_detailDoneGen == m_selectGen && m_dashDoneGen >= m_dashGen;
+}
+
 /**
  * @brief When using the web dashboard, route HTML to QWebEngineView;
  *        otherwise fallback to QTextEdit (if present).
  */
 void UltraMainWindow::setDashboardHtml(const QString& html) {
     if (m_aiWeb) {
+        ++m_dashGen;
         m_aiWeb->setHtml(html, QUrl("about:blank"));
     } else if (m_aiChat) {
         m_aiChat->setHtml(html);
@@ -235,6 +341,8 @@ void UltraMainWindow::setupCalendarPage() {
 
     m_prevBtn = new QPushButton(QString::fromUtf8("◀"), titleBar);
     m_nextBtn = new QPushButton(QString::fromUtf8("▶"), titleBar);
+    m_prevBtn->setObjectName("PrevMonth");
+    m_nextBtn->setObjectName("NextMonth");
     for (auto *b : { m_prevBtn, m_nextBtn }) {
         b->setFixedWidth(36);
         b->setCursor(Qt::PointingHandCursor);
@@ -253,6 +361,27 @@ void UltraMainWindow::setupCalendarPage() {
     rule->setFrameStyle(QFrame::NoFrame);
     leftLy->addWidget(rule);
 
+    // Layer toggles (one checkbox per calendar overlay + import button)
+    m_layerBar = new QWidget(leftCol);
+    new QHBoxLayout(m_layerBar);
+    m_layerBar->layout()->setContentsMargins(14, 0, 14, 0);
+    m_layerBar->layout()->setSpacing(12);
+    leftLy->addWidget(m_layerBar);
+
+    // Quick add: parsed as you type, committed with Enter (no dialog)
+    m_quickAdd = new QLineEdit(leftCol);
+    m_quickAdd->setObjectName("QuickAdd");
+    m_quickAdd->setPlaceholderText("Quick add — e.g. Calc study Tue 15:00-17:00 weekly until Dec 1 #study");
+    m_quickAdd->setClearButtonEnabled(true);
+    m_quickPreview = new QLabel(leftCol);
+    m_quickPreview->setObjectName("QuickAddPreview");
+    m_quickPreview->setStyleSheet("font-size:12px; opacity:.8;");
+    m_quickPreview->hide();
+    leftLy->addWidget(m_quickAdd);
+    leftLy->addWidget(m_quickPreview);
+    connect(m_quickAdd, &QLineEdit::textEdited,    this, [=]{ updateQuickAddPreview(); });
+    connect(m_quickAdd, &QLineEdit::returnPressed, this, [=]{ commitQuickAdd(); });
+
     // Calendar creation & baseline configuration
     m_calendar = new ModernCalendarWidget(leftCol);
     m_calendar->setObjectName("UltraCalendar");
@@ -306,10 +435,7 @@ void UltraMainWindow::setupCalendarPage() {
     // Day events list
     m_dayEvents = new QListWidget(right);
     m_dayEvents->setMinimumHeight(160);
-    m_dayEvents->setMouseTracking(true);
-    m_dayEvents->viewport()->setMouseTracking(true);
-    m_dayEvents->viewport()->setAttribute(Qt::WA_Hover, true);
-    m_dayEvents->viewport()->installEventFilter(this);
+    m_dayEvents->viewport()->installEventFilter(this);   // QEvent::ToolTip only (see eventFilter)
 
     // Helper to make small action buttons
     auto mkBtn = [](const QString& t) {
@@ -330,12 +456,31 @@ void UltraMainWindow::setupCalendarPage() {
     QPushButton *addBtn    = mkBtn("Add");
     QPushButton *editBtn   = mkBtn("Edit");
     QPushButton *deleteBtn = mkBtn("Delete");
+    m_trackBtn             = mkBtn("Track");
+    m_acceptBtn            = mkBtn("Accept");
+
+    // Stable names: UI recordings address widgets by object path
+    m_aiAnalyzeButton->setObjectName("AiAnalyze");
+    m_aiSuggestButton->setObjectName("AiSuggest");
+    m_aiInsightsButton->setObjectName("AiInsights");
+    m_aiGoalsButton->setObjectName("AiGoals");
+    m_aiHabitsButton->setObjectName("AiHabits");
+    m_aiStressButton->setObjectName("AiStress");
+    m_aiOptimizeButton->setObjectName("AiOptimize");
+    addBtn->setObjectName("AddEvent");
+    editBtn->setObjectName("EditEvent");
+    deleteBtn->setObjectName("DeleteEvent");
+    m_trackBtn->setObjectName("TrackTime");
+    m_trackBtn->setToolTip("Track time on the selected event (or an ad-hoc session if none is selected)");
+    m_acceptBtn->setObjectName("AcceptPlan");
+    m_acceptBtn->setToolTip("Add the planner's suggested blocks for this day to the calendar");
+    m_acceptBtn->setEnabled(false);
 
     // Button row layout
     QHBoxLayout *btnRow = new QHBoxLayout();
     for (auto *b : { m_aiAnalyzeButton, m_aiSuggestButton, m_aiInsightsButton,
                      m_aiGoalsButton,   m_aiHabitsButton,  m_aiStressButton,
-                     m_aiOptimizeButton, addBtn, editBtn, deleteBtn }) {
+                     m_aiOptimizeButton, m_acceptBtn, addBtn, editBtn, deleteBtn, m_trackBtn }) {
         btnRow->addWidget(b);
     }
 
@@ -348,6 +493,16 @@ void UltraMainWindow::setupCalendarPage() {
     if (m_aiWeb->page())
         m_aiWeb->page()->setBackgroundColor(Qt::transparent);
 
+    // A dashboard counts as rendered once its load finished and the page laid out
+    connect(m_aiWeb, &QWebEngineView::loadFinished, this, [this](bool ok) {
+        if (!ok) return;   // superseded by a newer setHtml()
+        const quint64 gen = m_dashGen;
+        m_aiWeb->page()->runJavaScript("document.body ? document.body.offsetHeight : 0",
+                                       [this, gen](const QVariant&) {
+            m_dashDoneGen = std::max(m_dashDoneGen, gen);
+        });
+    });
+
     // Assemble right column
     rLy->addWidget(dayLabel);
     rLy->addWidget(m_dayEvents);
@@ -406,46 +561,34 @@ void UltraMainWindow::setupCalendarPage() {
         styleActionButtons();
     };
 
-    // Extract "Category::Notes" → "Notes"
-    auto extractNotes = [](const QString& packed) {
-        const int i = packed.indexOf("::");
-        return (i >= 0) ? packed.mid(i + 2).trimmed() : QString();
-    };
-
-    // Refresh day list on the right for m_selectedDate
+    // Refresh day list on the right for m_selectedDate.
+    // Rows come from the visible layers merged by start time; each item carries its
+    // (layer slot, row-in-day) so edit/delete/tooltips can find the event again.
     auto refreshDayList = [=] {
         m_dayEvents->clear();
         if (!m_selectedDate.isValid()) return;
 
-        QVector<const Event*> todays; todays.reserve(m_events.size());
-        for (const auto& e : m_events)
-            if (e.isOnDate(m_selectedDate)) todays.push_back(&e);
-
-        std::sort(todays.begin(), todays.end(),
-                  [](const Event* a, const Event* b){ return a->getStartTime() < b->getStartTime(); });
-
-        for (const Event* e : todays) {
+        for (const auto& lr : m_store->layers().rowsOn(m_selectedDate)) {
+            const Event& e = m_store->layers().eventAt(lr.first, m_selectedDate, lr.second);
             const QString timeRange = QString("%1–%2")
-                .arg(e->getStartTime().toString("hh:mm"),
-                     e->getEndTime().toString("hh:mm"));
-            auto *it = new QListWidgetItem(QString("%1  —  %2").arg(e->getTitle(), timeRange));
-            const QString notes = extractNotes(e->getDescription());
-            if (!notes.isEmpty()) it->setToolTip(notes);
+                .arg(e.getStartTime().toString("hh:mm"),
+                     e.getEndTime().toString("hh:mm"));
+            QString text = QString("%1  —  %2").arg(e.getTitle(), timeRange);
+            if (lr.first != 0) text = QString("[%1]  %2").arg(m_store->layers().at(lr.first).name, text);
+
+            auto *it = new QListWidgetItem(text);
+            it->setData(Qt::UserRole,     lr.first);
+            it->setData(Qt::UserRole + 1, lr.second);
+            if (m_store->layers().at(lr.first).readOnly) it->setForeground(QColor("#9aa3ab"));
             m_dayEvents->addItem(it);
         }
     };
 
-    // Helpers to detect "series" (same title + same time window)
-    auto sameSeries = [&](const Event& a, const Event& b) {
-        return a.getTitle() == b.getTitle()
-            && a.getStartTime().time() == b.getStartTime().time()
-            && a.getEndTime().time()   == b.getEndTime().time();
-    };
-    auto isSeriesInstance = [&](const Event& target) {
-        int count = 0; for (const auto& e : m_events) if (sameSeries(e, target)) ++count;
-        return count > 1;
-    };
-    auto hasSeries = isSeriesInstance; // alias
+    // Layer toggles / imports change what the day list shows
+    connect(this, &UltraMainWindow::layersChanged, this, [=] {
+        refreshDayList();
+        setDashboardHtml(buildDailyDashboardHtml(m_selectedDate));
+    });
 
     // ---------------------------
     // Signals/Slots wiring
@@ -455,14 +598,53 @@ void UltraMainWindow::setupCalendarPage() {
     connect(m_prevBtn, &QPushButton::clicked, m_calendar, &QCalendarWidget::showPreviousMonth);
     connect(m_nextBtn, &QPushButton::clicked, m_calendar, &QCalendarWidget::showNextMonth);
 
-    // When a date is clicked/selected:
+    // Deferred stage of a selection: day list, dashboard, planning.
+    // Each step yields to the event loop and bails out if the date moved meanwhile.
+    auto runDayDetails = [=] {
+        const quint64 gen = m_selectGen;
+        refreshDayList();
+        // The day's stats and page are built on a worker as an Interactive job,
+        // ahead of any export or forecast work queued there
+        m_dashJob.cancel();
+        m_dashJob = JobScheduler::CancelToken();
+        const QDate d     = m_selectedDate;
+        const bool  light = (m_theme == ThemeMode::Light);
+        JobScheduler::Options o;
+        o.token   = m_dashJob;
+        o.context = this;
+        o.done    = [=](const QVariant& html) {
+            if (gen != m_selectGen) return;
+            setDashboardHtml(appendDayCards(html.toString(), d));
+            QTimer::singleShot(0, this, [=] {
+                if (gen != m_selectGen) return;
+                if (m_superAI) ai()->generateSmartSuggestions(m_selectedDate); // Suggest is hidden but this preserves behavior
+                m_detailDoneGen = gen;
+            });
+        };
+        m_store->jobs()->submit(JobScheduler::Priority::Interactive,
+                                [day = dashboardEvents(d), light, d](const JobScheduler::CancelToken&) {
+            return QVariant(::buildDailyDashboardHtml(day, light, d));
+        }, o);
+    };
+    m_detailTimer = new QTimer(this);
+    m_detailTimer->setSingleShot(true);
+    connect(m_detailTimer, &QTimer::timeout, this, runDayDetails);
+    connect(m_calendar, &ModernCalendarWidget::navigationSettled, this, [=] {
+        if (m_detailTimer->isActive()) { m_detailTimer->stop(); runDayDetails(); }
+    });
+
+    // When a date is clicked/selected: cheap stage now (ring + label), details once
+    // navigation settles. Held arrow keys therefore pay only for the final date.
     auto onPickDate = [=](const QDate& d) {
-        if (m_calendar) m_calendar->setSelectedDate(d);
+        if (m_calendar && m_calendar->selectedDate() != d) m_calendar->setSelectedDate(d);
+        if (d == m_selectedDate && m_detailTimer->isActive()) return;   // clicked + selectionChanged
         m_selectedDate = d;
         dayLabel->setText(d.toString("dddd, MMM d"));
-        refreshDayList();
-        setDashboardHtml(buildDailyDashboardHtml(m_selectedDate));
-        if (m_superAI) m_superAI->generateSmartSuggestions(d); // Suggest is hidden but this preserves behavior
+
+        ++m_selectGen;
+        const bool repeating = m_calendar && m_calendar->isKeyRepeating();
+        if (repeating) m_dayEvents->clear();   // don't show the previous day's rows under the new label
+        m_detailTimer->start(repeating ? 150 : 0);
     };
     connect(m_calendar, &QCalendarWidget::clicked,           this, onPickDate);
     connect(m_calendar, &QCalendarWidget::selectionChanged,  this, [=]{ onPickDate(m_calendar->selectedDate()); });
@@ -472,6 +654,7 @@ void UltraMainWindow::setupCalendarPage() {
             [this, styleCalendar, updateMonthTitle, styleChrome](int, int) {
                 styleCalendar();
                 refreshMonthFormats();
+                recomposeCalendar();
                 updateMonthTitle();
                 styleChrome();
                 updateCalendarChrome();
@@ -482,123 +665,42 @@ void UltraMainWindow::setupCalendarPage() {
         updateCalendarChrome();
     });
 
-    // Tooltips for items in the day list (hover & click)
-    connect(m_dayEvents, &QListWidget::itemEntered, this, [=](QListWidgetItem* it) {
-        if (!it) return;
-        QToolTip::showText(QCursor::pos(), it->toolTip(), m_dayEvents);
+    // Events changed outside this page (e.g. sync): refresh the right column
+    connect(this, &UltraMainWindow::eventsChanged, this, [=] {
+        refreshDayList();
+        setDashboardHtml(buildDailyDashboardHtml(m_selectedDate));
     });
+
+    // Day-cell hover text comes from the same per-day cache
+    m_calendar->setToolTipProvider([this](const QDate& d) { return tooltipForDate(d); });
+
+    // "+N" badge under a busy day's dots: the whole day in a popup list
+    m_dayPopup = new DayEventsPopup(&m_store->layers(), this);
+    connect(m_calendar, &ModernCalendarWidget::overflowClicked, m_dayPopup, &DayEventsPopup::showFor);
+    connect(m_dayPopup, &DayEventsPopup::editRequested,   this, &UltraMainWindow::editEventAt);
+    connect(m_dayPopup, &DayEventsPopup::deleteRequested, this, &UltraMainWindow::deleteEventAt);
+
+    // Show an item's notes on click (hover tooltips are handled in eventFilter)
     connect(m_dayEvents, &QListWidget::itemClicked, this, [=](QListWidgetItem* it) {
         if (!it) return;
-        QToolTip::showText(QCursor::pos(), it->toolTip(), m_dayEvents);
-        if (!m_aiChat) return; // currently dashboard uses webview
-        const QString tip = it->toolTip();
+        const QString tip = itemTooltip(it);
         if (tip.isEmpty()) return;
+        QToolTip::showText(QCursor::pos(), tip, m_dayEvents);
         // (Optional) could echo description to chat; left minimal here.
     });
 
-    // Delete event (supports single instance vs. whole series)
-    connect(deleteBtn, &QPushButton::clicked, this, [=] {
-        if (!m_selectedDate.isValid()) return;
-        const int row = m_dayEvents->currentRow(); if (row < 0) return;
-
-        QVector<int> todayIdx;
-        for (int i = 0; i < m_events.size(); ++i)
-            if (m_events[i].isOnDate(m_selectedDate)) todayIdx.push_back(i);
-        if (row >= todayIdx.size()) return;
-
-        const int idx = todayIdx[row];
-        const Event target = m_events[idx];
-
-        if (!isSeriesInstance(target)) {
-            m_events.removeAt(idx);
-        } else {
-            QMessageBox box(this);
-            box.setWindowTitle("Apply changes");
-            box.setText("Apply changes to just this event or the whole series?");
-            QPushButton* btnThis   = box.addButton("This event",    QMessageBox::ActionRole);
-            QPushButton* btnAll    = box.addButton("All in series", QMessageBox::ActionRole);
-            QPushButton* btnCancel = box.addButton(QMessageBox::Cancel);
-            box.setDefaultButton(btnThis);
-            box.setEscapeButton(btnCancel);
-            box.exec();
-
-            if (box.clickedButton() == btnThis) {
-                m_events.removeAt(idx);
-            } else if (box.clickedButton() == btnAll) {
-                for (int i = m_events.size() - 1; i >= 0; --i)
-                    if (sameSeries(m_events[i], target)) m_events.removeAt(i);
-            } else {
-                return; // canceled
-            }
-        }
+    connect(m_trackBtn, &QPushButton::clicked, this, [=] { toggleTracking(); });
 
-        if (m_calendar) {
-            m_calendar->setEvents(m_events);
-            m_calendar->setSelectedDate(m_selectedDate);
-            m_calendar->update();
-        }
-        refreshMonthFormats();
-        refreshDayList();
-        setDashboardHtml(buildDailyDashboardHtml(m_selectedDate));
+    // Edit/delete act on the personal-layer row picked in the day list
+    connect(deleteBtn, &QPushButton::clicked, this, [=] {
+        const QListWidgetItem* cur = m_dayEvents->currentItem(); if (!cur) return;
+        if (cur->data(Qt::UserRole).toInt() != 0) return;   // only slot 0 is editable
+        deleteEventAt(m_selectedDate, cur->data(Qt::UserRole + 1).toInt());
     });
-
-    // Edit event (single item or entire series handling occurs after dialog)
     connect(editBtn, &QPushButton::clicked, this, [=]{
-        if (!m_selectedDate.isValid()) return;
-        const int row = m_dayEvents->currentRow(); if (row < 0) return;
-
-        QVector<int> todayIdx; todayIdx.reserve(m_events.size());
-        for (int i = 0; i < m_events.size(); ++i)
-            if (m_events[i].isOnDate(m_selectedDate)) todayIdx.push_back(i);
-        if (row >= todayIdx.size()) return;
-
-        const int idx = todayIdx[row];
-        Event original = m_events[idx];
-        Event updated  = original;
-
-        if (!openEditEventDialog(updated)) return;
-
-        if (!hasSeries(original)) {
-            m_events[idx] = updated;
-        } else {
-            QMessageBox box(this);
-            box.setWindowTitle("Apply changes");
-            box.setText("Apply changes to just this event or the whole series?");
-            QPushButton* btnThis   = box.addButton("This event",    QMessageBox::ActionRole);
-            QPushButton* btnAll    = box.addButton("All in series", QMessageBox::ActionRole);
-            QPushButton* btnCancel = box.addButton(QMessageBox::Cancel);
-            box.setDefaultButton(btnThis);
-            box.setEscapeButton(btnCancel);
-            box.exec();
-
-            if (box.clickedButton() == btnThis) {
-                m_events[idx] = updated;
-            } else if (box.clickedButton() == btnAll) {
-                const QTime newStartT = updated.getStartTime().time();
-                const QTime newEndT   = updated.getEndTime().time();
-                for (auto& e : m_events) {
-                    if (!sameSeries(e, original)) continue;
-                    e.setTitle(updated.getTitle());
-                    e.setDescription(updated.getDescription());
-                    e.setColor(colorForCategory(descCategory(updated)));
-                    const QDate ds = e.getStartTime().date();
-                    const QDate de = e.getEndTime().date();
-                    e.setStartTime(QDateTime(ds, newStartT));
-                    e.setEndTime(  QDateTime(de, newEndT));
-                }
-            } else {
-                return; // canceled
-            }
-        }
-
-        if (m_calendar) {
-            m_calendar->setEvents(m_events);
-            m_calendar->setSelectedDate(m_selectedDate);
-            m_calendar->update();
-        }
-        refreshMonthFormats();
-        refreshDayList();
-        setDashboardHtml(buildDailyDashboardHtml(m_selectedDate));
+        const QListWidgetItem* cur = m_dayEvents->currentItem(); if (!cur) return;
+        if (cur->data(Qt::UserRole).toInt() != 0) return;
+        editEventAt(m_selectedDate, cur->data(Qt::UserRole + 1).toInt());
     });
 
     // Add a new event (with recurrence expansion)
@@ -612,7 +714,7 @@ void UltraMainWindow::setupCalendarPage() {
 
     // AI action buttons
     connect(m_aiAnalyzeButton,  &QPushButton::clicked, this, [=] {
-        if (m_superAI) m_superAI->analyzeSchedule(m_events);
+        if (m_superAI) ai()->analyzeSchedule(m_store->columns());
     });
 
     // Even though Suggest is hidden, keep the slot to preserve behavior and not break connections.
@@ -627,30 +729,52 @@ void UltraMainWindow::setupCalendarPage() {
         }
 
         // Then ask the AI as well; when it returns, onAISuggestionsReady enhances the view.
-        if (m_superAI) m_superAI->generateSmartSuggestions(m_selectedDate);
+        if (m_superAI) ai()->generateSmartSuggestions(m_selectedDate);
+    });
+
+    // Accepted blocks become ordinary events; while planner recording is on,
+    // the store logs them as the tuner's ground truth
+    connect(m_acceptBtn, &QPushButton::clicked, this, [=]{
+        if (m_suggestions.isEmpty() || m_selectedDate < m_suggestionsDay
+            || m_selectedDate >= m_suggestionsDay.addDays(m_suggestionsDays)) return;
+        for (Event ev : std::as_const(m_suggestions)) {
+            ev.ensureUid();
+            if (m_store->sync()) m_store->sync()->recordUpsert(ev);
+            m_store->events().append(ev);
+        }
+        const int n = m_suggestions.size();
+        m_suggestions.clear();
+        m_acceptBtn->setEnabled(false);
+        m_store->commit();
+        statusBar()->showMessage(QString("✅ Added %1 planned block(s) to %2%3")
+                                 .arg(n).arg(m_suggestionsDays > 1 ? "the week of " : "")
+                                 .arg(m_suggestionsDay.toString("ddd, MMM d")), 5000);
     });
 
     connect(m_aiInsightsButton, &QPushButton::clicked, this, [=]{
-        if (m_superAI) m_superAI->provideInsights(m_events);
+        if (m_superAI) ai()->provideInsights(m_store->events());
     });
     connect(m_aiGoalsButton,    &QPushButton::clicked, this, [=]{
-        if (m_superAI) m_superAI->suggestGoals(m_events);
+        if (m_superAI) ai()->suggestGoals(m_store->events());
     });
     connect(m_aiHabitsButton,   &QPushButton::clicked, this, [=]{
-        if (m_superAI) m_superAI->recommendHabits(m_events);
+        if (m_superAI) planHabitWeek();
     });
     connect(m_aiStressButton,   &QPushButton::clicked, this, [=]{
-        if (m_superAI) m_superAI->analyzeStress(m_events);
+        if (m_superAI) ai()->analyzeStress(m_store->events());
     });
     connect(m_aiOptimizeButton, &QPushButton::clicked, this, [=]{
-        if (m_superAI) m_superAI->optimizeWorkLifeBalance(m_events);
+        if (m_superAI) ai()->optimizeWorkLifeBalance(m_store->events());
     });
 
     // Initial render after building the page
+    m_calendar->setEvents(m_store->events());
     updateMonthTitle();
     styleChrome();
     styleCalendar();
     refreshMonthFormats();
+    rebuildLayerBar();
+    recomposeCalendar();
     styleActionButtons();
 
     // Seed the right panel with today's info
@@ -666,22 +790,15 @@ void UltraMainWindow::setupCalendarPage() {
 
 /**
  * @brief Handles tooltips for the day events list viewport.
+ *        Driven by QEvent::ToolTip only; text comes from m_store->index() (built lazily, memoised).
  */
 bool UltraMainWindow::eventFilter(QObject* obj, QEvent* ev) {
     if (obj == (m_dayEvents ? m_dayEvents->viewport() : nullptr)) {
-        if (ev->type() == QEvent::MouseMove) {
-            auto *me = static_cast<QMouseEvent*>(ev);
-            const QPoint p = me->pos();
-            if (QListWidgetItem* it = m_dayEvents->itemAt(p)) {
-                const QString tip = it->toolTip();
-                if (!tip.isEmpty())
-                    QToolTip::showText(m_dayEvents->mapToGlobal(p), tip, m_dayEvents);
-            }
-        } else if (ev->type() == QEvent::ToolTip) {
+        if (ev->type() == QEvent::ToolTip) {
             auto *he = static_cast<QHelpEvent*>(ev);
             const QPoint p = he->pos();
             if (QListWidgetItem* it = m_dayEvents->itemAt(p)) {
-                const QString tip = it->toolTip();
+                const QString tip = itemTooltip(it);
                 if (!tip.isEmpty()) {
                     QToolTip::showText(m_dayEvents->mapToGlobal(p), tip, m_dayEvents);
                     return true; // handled
@@ -707,32 +824,35 @@ void UltraMainWindow::bindAIOutputs() {
     if (!m_superAI) return;
 
     // Optional AI tab wires (exist only if tab was created)
-    if (m_btnAnalyze)  connect(m_btnAnalyze,  &QPushButton::clicked, this, [=]{ m_superAI->analyzeSchedule(m_events); });
-    if (m_btnSuggest)  connect(m_btnSuggest,  &QPushButton::clicked, this, [=]{ m_superAI->generateSmartSuggestions(m_selectedDate); });
-    if (m_btnInsights) connect(m_btnInsights, &QPushButton::clicked, this, [=]{ m_superAI->provideInsights(m_events); });
-    if (m_btnGoals)    connect(m_btnGoals,    &QPushButton::clicked, this, [=]{ m_superAI->suggestGoals(m_events); });
-    if (m_btnHabits)   connect(m_btnHabits,   &QPushButton::clicked, this, [=]{ m_superAI->recommendHabits(m_events); });
-    if (m_btnStress)   connect(m_btnStress,   &QPushButton::clicked, this, [=]{ m_superAI->analyzeStress(m_events); });
-    if (m_btnOptimize) connect(m_btnOptimize, &QPushButton::clicked, this, [=]{ m_superAI->optimizeWorkLifeBalance(m_events); });
+    if (m_btnAnalyze)  connect(m_btnAnalyze,  &QPushButton::clicked, this, [=]{ ai()->analyzeSchedule(m_store->columns()); });
+    if (m_btnSuggest)  connect(m_btnSuggest,  &QPushButton::clicked, this, [=]{ ai()->generateSmartSuggestions(m_selectedDate); });
+    if (m_btnInsights) connect(m_btnInsights, &QPushButton::clicked, this, [=]{ ai()->provideInsights(m_store->events()); });
+    if (m_btnGoals)    connect(m_btnGoals,    &QPushButton::clicked, this, [=]{ ai()->suggestGoals(m_store->events()); });
+    if (m_btnHabits)   connect(m_btnHabits,   &QPushButton::clicked, this, [=]{ ai()->recommendHabits(m_store->events()); });
+    if (m_btnStress)   connect(m_btnStress,   &QPushButton::clicked, this, [=]{ ai()->analyzeStress(m_store->events()); });
+    if (m_btnOptimize) connect(m_btnOptimize, &QPushButton::clicked, this, [=]{ ai()->optimizeWorkLifeBalance(m_store->events()); });
 
     // Pipe to AI panel if it exists
-    auto toAiPanel = [this](const QString& s) { if (m_aiPanel) m_aiPanel->setPlainText(s); };
+    auto toAiPanel = [this](const QString& s) { if (m_aiPanel && ownsAIReply()) m_aiPanel->setPlainText(s); };
     connect(m_superAI, &SuperAI::analysisComplete,    this, toAiPanel);
     connect(m_superAI, &SuperAI::insightsReady,       this, toAiPanel);
     connect(m_superAI, &SuperAI::stressAnalysisReady, this, toAiPanel);
     connect(m_superAI, &SuperAI::optimizationReady,   this, toAiPanel);
 
     connect(m_superAI, &SuperAI::goalsReady,  this, [=](const QStringList& gl){
+        if (!ownsAIReply()) return;
         if (m_aiPanel) m_aiPanel->setPlainText("🎯 GOALS:\n- " + gl.join("\n- "));
         onAIGoalsReady(gl);
     });
     connect(m_superAI, &SuperAI::habitsReady, this, [=](const QStringList& hb){
+        if (!ownsAIReply()) return;
         if (m_aiPanel) m_aiPanel->setPlainText("🔁 HABITS:\n- " + hb.join("\n- "));
         onAIHabitsReady(hb);
     });
 
     // Calendar-side dashboard: show details block appended to ::buildDailyDashboardHtml
     connect(m_superAI, &SuperAI::analysisComplete, this, [=](const QString& s){
+        if (!ownsAIReply()) return;
         QString html = buildDailyDashboardHtml(m_selectedDate);
         if (!s.isEmpty()) {
             html += QString(
@@ -787,13 +907,14 @@ void UltraMainWindow::applyStunningEffects() {
  */
 void UltraMainWindow::onDateSelected(const QDate& date) {
     m_selectedDate = date;
-    if (m_superAI) m_superAI->analyzeSchedule(m_events);
+    if (m_superAI) ai()->analyzeSchedule(m_store->columns());
 }
 
 /**
  * @brief Append the AI "Details" section to the daily dashboard card.
  */
 void UltraMainWindow::onAIAnalysisComplete(const QString& analysis) {
+    if (!ownsAIReply()) return;   // another window asked
     const bool light = (m_theme == ThemeMode::Light);
     QString html = buildDailyDashboardHtml(m_selectedDate);
     if (!analysis.isEmpty()) {
@@ -809,6 +930,11 @@ void UltraMainWindow::onAIAnalysisComplete(const QString& analysis) {
  *        Otherwise we leave the local suggestions/dashboard as-is.
  */
 void UltraMainWindow::onAISuggestionsReady(const QList<Event>& aiSuggestions) {
+    if (!ownsAIReply()) return;   // another window asked
+    m_suggestions    = QVector<Event>(aiSuggestions.cbegin(), aiSuggestions.cend());
+    m_suggestionsDay = m_suggestions.isEmpty() ? QDate() : m_suggestions.first().getStartTime().date();
+    m_suggestionsDays = 1;
+    if (m_acceptBtn) m_acceptBtn->setEnabled(m_suggestionsDay.isValid() && m_suggestionsDay == m_selectedDate);
     if (!m_aiChat) return; // dashboard now uses webview; this preserves compatibility
 
     if (!aiSuggestions.isEmpty()) {
@@ -840,6 +966,7 @@ void UltraMainWindow::onAISuggestionsReady(const QList<Event>& aiSuggestions) {
  * @brief Add "Insights" section to dashboard.
  */
 void UltraMainWindow::onAIInsightsReady(const QString& insights) {
+    if (!ownsAIReply()) return;   // another window asked
     const bool light = (m_theme == ThemeMode::Light);
     QString html = buildDailyDashboardHtml(m_selectedDate);
     if (!insights.isEmpty()) {
@@ -854,6 +981,7 @@ void UltraMainWindow::onAIInsightsReady(const QString& insights) {
  * @brief Add "Stress" section to dashboard.
  */
 void UltraMainWindow::onAIStressAnalysisReady(const QString& text) {
+    if (!ownsAIReply()) return;   // another window asked
     const bool light = (m_theme == ThemeMode::Light);
     QString html = buildDailyDashboardHtml(m_selectedDate);
     if (!text.isEmpty()) {
@@ -868,6 +996,7 @@ void UltraMainWindow::onAIStressAnalysisReady(const QString& text) {
  * @brief Add "Optimization" section to dashboard.
  */
 void UltraMainWindow::onAIOptimizationReady(const QString& text) {
+    if (!ownsAIReply()) return;   // another window asked
     const bool light = (m_theme == ThemeMode::Light);
     QString html = buildDailyDashboardHtml(m_selectedDate);
     if (!text.isEmpty()) {
@@ -882,6 +1011,7 @@ void UltraMainWindow::onAIOptimizationReady(const QString& text) {
  * @brief Update right-side list and append "Goals" section to dashboard.
  */
 void UltraMainWindow::onAIGoalsReady(const QStringList& goals) {
+    if (!ownsAIReply()) return;   // another window asked
     if (m_goalsPanel) { m_goalsPanel->clear(); m_goalsPanel->addItems(goals); }
     const bool light = (m_theme == ThemeMode::Light);
     QString html = buildDailyDashboardHtml(m_selectedDate);
@@ -893,6 +1023,7 @@ void UltraMainWindow::onAIGoalsReady(const QStringList& goals) {
  * @brief Update right-side list and append "Habits" section to dashboard.
  */
 void UltraMainWindow::onAIHabitsReady(const QStringList& habits) {
+    if (!ownsAIReply()) return;   // another window asked
     if (m_habitsPanel) { m_habitsPanel->clear(); m_habitsPanel->addItems(habits); }
     const bool light = (m_theme == ThemeMode::Light);
     QString html = buildDailyDashboardHtml(m_selectedDate);
@@ -900,6 +1031,53 @@ void UltraMainWindow::onAIHabitsReady(const QStringList& habits) {
     setDashboardHtml(html);
 }
 
+/**
+ * @brief Plan the habit pool over the selected week (from today on) around
+ *        the calendar: daysPerWeek, anchors and the daily cap apply, and
+ *        past 🟢 blocks count as completed days so active streaks pick first.
+ *        The blocks are offered like planner suggestions (Accept adds them).
+ *        With an empty pool this falls back to the generic tips.
+ */
+void UltraMainWindow::planHabitWeek() {
+    const QVector<SuperAI::Habit>& habits = m_superAI->habits();
+    if (habits.isEmpty()) {
+        statusBar()->showMessage("No habits to plan yet; add them under ⚙️Settings → 🟢 Habits…", 5000);
+        ai()->recommendHabits(m_store->events());
+        return;
+    }
+
+    const QDateTime now   = m_superAI->now();
+    const QDate     sel   = m_selectedDate.isValid() ? m_selectedDate : now.date();
+    const QDate     first = std::max(sel.addDays(1 - sel.dayOfWeek()), now.date());
+    const int       days  = int(first.daysTo(sel.addDays(8 - sel.dayOfWeek())));
+    if (days <= 0) {
+        statusBar()->showMessage("That week is over; pick a day in this week or later.", 5000);
+        return;
+    }
+
+    QVector<Event> history;
+    for (const Event& e : std::as_const(m_store->events()))
+        if (e.getEndTime() <= now && e.getTitle().startsWith(QStringLiteral("🟢 "))) history.push_back(e);
+    const QVector<Event> plan = m_superAI->planHabitsWeek(first, m_store->events(), habits, history, days);
+
+    m_suggestions     = plan;
+    m_suggestionsDay  = first;
+    m_suggestionsDays = days;
+    if (m_acceptBtn) m_acceptBtn->setEnabled(!plan.isEmpty());
+
+    QStringList items;
+    for (const Event& e : plan)
+        items << QString("%1 %2–%3  %4").arg(e.getStartTime().toString("ddd d MMM"),
+                                            e.getStartTime().time().toString("hh:mm"),
+                                            e.getEndTime().time().toString("hh:mm"), e.getTitle().mid(3));
+    if (m_habitsPanel) { m_habitsPanel->clear(); m_habitsPanel->addItems(items); }
+    const bool light = (m_theme == ThemeMode::Light);
+    QString html = buildDailyDashboardHtml(m_selectedDate);
+    html = appendSectionCard(html, QString("Habits, week of %1").arg(first.toString("d MMM")),
+                             items.isEmpty() ? QString("No free time fits the habit pool this week.") : ulList(items), light);
+    setDashboardHtml(html);
+}
+
 
 // ==========================================
 // ============ Periodic Updates ============
@@ -1000,14 +1178,14 @@ void UltraMainWindow::buildUltraAITab() {
     // Wire actions
     connect(m_btnAnalyze, &QPushButton::clicked, this, [=]{
         qDebug() << "[UI] Analyze clicked";
-        if (m_superAI) m_superAI->analyzeSchedule(m_events);
+        if (m_superAI) ai()->analyzeSchedule(m_store->columns());
     });
-    connect(m_btnSuggest,  &QPushButton::clicked, this, [=]{ if (m_superAI) m_superAI->generateSmartSuggestions(m_selectedDate); });
-    connect(m_btnInsights, &QPushButton::clicked, this, [=]{ if (m_superAI) m_superAI->provideInsights(m_events); });
-    connect(m_btnGoals,    &QPushButton::clicked, this, [=]{ if (m_superAI) m_superAI->suggestGoals(m_events); });
-    connect(m_btnHabits,   &QPushButton::clicked, this, [=]{ if (m_superAI) m_superAI->recommendHabits(m_events); });
-    connect(m_btnStress,   &QPushButton::clicked, this, [=]{ if (m_superAI) m_superAI->analyzeStress(m_events); });
-    connect(m_btnOptimize, &QPushButton::clicked, this, [=]{ if (m_superAI) m_superAI->optimizeWorkLifeBalance(m_events); });
+    connect(m_btnSuggest,  &QPushButton::clicked, this, [=]{ if (m_superAI) ai()->generateSmartSuggestions(m_selectedDate); });
+    connect(m_btnInsights, &QPushButton::clicked, this, [=]{ if (m_superAI) ai()->provideInsights(m_store->events()); });
+    connect(m_btnGoals,    &QPushButton::clicked, this, [=]{ if (m_superAI) ai()->suggestGoals(m_store->events()); });
+    connect(m_btnHabits,   &QPushButton::clicked, this, [=]{ if (m_superAI) ai()->recommendHabits(m_store->events()); });
+    connect(m_btnStress,   &QPushButton::clicked, this, [=]{ if (m_superAI) ai()->analyzeStress(m_store->events()); });
+    connect(m_btnOptimize, &QPushButton::clicked, this, [=]{ if (m_superAI) ai()->optimizeWorkLifeBalance(m_store->events()); });
 
     // Mirror AI outputs to this panel as plain text
     connect(m_superAI, &SuperAI::analysisComplete,    this, [=](const QString& s){ if (m_aiPanel) m_aiPanel->setPlainText(s); });
@@ -1060,7 +1238,7 @@ void UltraMainWindow::buildAnalyticsTab() {
     grid->addWidget(makeLabel("Monthly Progress:"), 2,0); grid->addWidget(m_pbMonthly, 2,1);
     grid->addWidget(makeLabel("Work-Life Balance:"),3,0); grid->addWidget(m_pbBalance, 3,1);
 
-    connect(m_updateTimer, &QTimer::timeout, this, [=]{
+    connect(this, &UltraMainWindow::eventsChanged, this, [=]{
         if (!isVisible()) return;
         if (m_pbDaily)   m_pbDaily->setValue(QRandomGenerator::global()->bounded(70, 100));
         if (m_pbWeekly)  m_pbWeekly->setValue(QRandomGenerator::global()->bounded(60, 95));
@@ -1100,6 +1278,68 @@ void UltraMainWindow::buildProductivityTab() {
     m_mainTabs->addTab(w, "⚡ Productivity");
 }
 
+/**
+ * @brief Agenda tab: everything coming up, across visible layers, as one endless list.
+ *        Rows are paged in (and far-off days dropped) by AgendaModel as the view scrolls.
+ */
+void UltraMainWindow::buildAgendaTab() {
+    auto* w = new QWidget; auto* lay = new QVBoxLayout(w);
+    lay->setContentsMargins(12, 12, 12, 12); lay->setSpacing(8);
+
+    auto* row   = new QHBoxLayout; lay->addLayout(row);
+    auto* title = new QLabel("🗓️ Agenda"); title->setStyleSheet("font-weight:700; font-size:16px;");
+    auto* from  = new QDateEdit(QDate::currentDate()); from->setCalendarPopup(true);
+    auto* today = new QPushButton("Today");
+    row->addWidget(title);
+    row->addStretch(1);
+    row->addWidget(from);
+    row->addWidget(today);
+
+    m_agenda = new AgendaModel(&m_store->layers(), this);
+
+    auto* view = new QListView;
+    view->setModel(m_agenda);
+    view->setUniformItemSizes(true);   // no per-row size queries → only visible rows are formatted
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->setStyleSheet(kListStyle);
+    view->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    lay->addWidget(view, 1);
+
+    // Keep the model's window of days around what is on screen. Rows dropped
+    // or paged in above the viewport would shift it, so the top row is re-anchored.
+    auto* sync = new QTimer(view);
+    sync->setSingleShot(true);
+    sync->setInterval(0);
+    connect(view->verticalScrollBar(), &QScrollBar::valueChanged, sync, qOverload<>(&QTimer::start));
+    connect(sync, &QTimer::timeout, this, [=] {
+        const QModelIndex top = view->indexAt(QPoint(0, 0));
+        if (!top.isValid()) return;
+        const QPersistentModelIndex anchor(top);
+        const int offset = view->visualRect(top).top();
+        const QModelIndex bottom = view->indexAt(view->viewport()->rect().bottomLeft());
+        m_agenda->setViewport(top.row(), bottom.isValid() ? bottom.row() : m_agenda->rowCount() - 1);
+        if (anchor.isValid() && anchor.row() != top.row()) {
+            view->scrollTo(anchor, QAbstractItemView::PositionAtTop);
+            view->verticalScrollBar()->setValue(view->verticalScrollBar()->value() - offset);
+        }
+    });
+
+    connect(from,  &QDateEdit::dateChanged, this, [=](const QDate& d){ m_agenda->setStart(d); });
+    connect(today, &QPushButton::clicked,   this, [=]{ from->setDate(QDate::currentDate()); });
+
+    // Open the day on the calendar page
+    connect(view, &QListView::doubleClicked, this, [=](const QModelIndex& ix) {
+        const QDate d = ix.data(AgendaModel::DateRole).toDate();
+        if (!d.isValid() || !m_calendar) return;
+        m_calendar->setSelectedDate(d);
+        m_mainTabs->setCurrentIndex(0);
+    });
+
+    connect(this, &UltraMainWindow::layersChanged, m_agenda, &AgendaModel::refresh);
+
+    m_mainTabs->addTab(w, "🗓️ Agenda");
+}
+
 /**
  * @brief Small Settings tab (theme toggles + reset).
  */
@@ -1123,10 +1363,42 @@ void UltraMainWindow::buildSettingsTab() {
     m_btnThemeLight  = new QPushButton("🌤️ Light Theme");
     m_btnThemeDark   = new QPushButton("🌙 Dark Theme");
     m_btnResetPanels = new QPushButton("♻️ Reset Panels");
+    auto* btnSync    = new QPushButton("🔄 Sync Folder…");
+    auto* chkRecord  = new QCheckBox("📼 Record planner sessions");
+    chkRecord->setChecked(QSettings().value("planner/record", false).toBool());
+    auto* spinArch   = new QSpinBox;
+    auto* btnArchive = new QPushButton("🗜️ Archive Now");
+    auto* btnFbOut   = new QPushButton("📤 Export Free/Busy…");
+    auto* btnFbCmp   = new QPushButton("🤝 Common Free Time…");
+    auto* btnWindow  = new QPushButton("🪟 New Window");
+    auto* btnExport  = new QPushButton("🖨️ Export Calendar…");
+    auto* btnTasks   = new QPushButton("📋 Tasks…");
+    auto* btnHabits  = new QPushButton("🟢 Habits…");
+    auto* btnForecast = new QPushButton("📈 Workload Forecast");
+    auto* btnWhatIf  = new QPushButton("🔮 What if…");
+    auto* btnJobs    = new QPushButton("⏱️ Background Jobs");
+    spinArch->setRange(0, 120);
+    spinArch->setPrefix("Archive after ");
+    spinArch->setSuffix(" months");
+    spinArch->setSpecialValueText("Archive: off");
+    spinArch->setValue(QSettings().value("archive/cutoffMonths", 12).toInt());
 
     row->addWidget(m_btnThemeLight);
     row->addWidget(m_btnThemeDark);
     row->addWidget(m_btnResetPanels);
+    row->addWidget(btnSync);
+    row->addWidget(chkRecord);
+    row->addWidget(spinArch);
+    row->addWidget(btnArchive);
+    row->addWidget(btnFbOut);
+    row->addWidget(btnFbCmp);
+    row->addWidget(btnWindow);
+    row->addWidget(btnExport);
+    row->addWidget(btnTasks);
+    row->addWidget(btnHabits);
+    row->addWidget(btnForecast);
+    row->addWidget(btnWhatIf);
+    row->addWidget(btnJobs);
 
     connect(m_btnThemeLight, &QPushButton::clicked, this, [=]{
         clearLocalStyles();
@@ -1142,6 +1414,45 @@ void UltraMainWindow::buildSettingsTab() {
 
     connect(m_btnResetPanels, &QPushButton::clicked, this, [=]{ resetPanels(); });
 
+    connect(btnSync, &QPushButton::clicked, this, [=]{
+        QSettings s;
+        const QString dir = QFileDialog::getExistingDirectory(
+            this, "Shared sync folder", s.value("sync/folder").toString());
+        if (dir.isEmpty()) return;
+        s.setValue("sync/folder", dir);
+        m_store->setupSync(dir);
+        if (m_settingsPanel) m_settingsPanel->append("\nSyncing through " + dir);
+    });
+
+    connect(chkRecord, &QCheckBox::toggled, this, [=](bool on){
+        QSettings().setValue("planner/record", on);
+        m_store->setPlannerRecording(on);
+        if (on && m_store->plannerRecorder() && m_settingsPanel)
+            m_settingsPanel->append("\nRecording planner sessions to " + m_store->plannerRecorder()->path());
+    });
+
+    connect(spinArch, qOverload<int>(&QSpinBox::valueChanged), this, [](int v){
+        QSettings().setValue("archive/cutoffMonths", v);
+    });
+
+    connect(btnArchive, &QPushButton::clicked, this, [=]{
+        m_store->archiveOldEvents();
+        if (m_settingsPanel)
+            m_settingsPanel->append(QString("\nArchive: %1 months, %2 KB compressed")
+                                    .arg(m_store->archive().segmentCount())
+                                    .arg(m_store->archive().compressedBytes() / 1024));
+    });
+
+    connect(btnFbOut, &QPushButton::clicked, this, [=]{ exportFreeBusy(); });
+    connect(btnFbCmp, &QPushButton::clicked, this, [=]{ showCommonFreeTime(); });
+    connect(btnWindow, &QPushButton::clicked, this, [=]{ openNewWindow(); });
+    connect(btnExport, &QPushButton::clicked, this, [=]{ exportCalendar(); });
+    connect(btnTasks, &QPushButton::clicked, this, [=]{ editTasks(); });
+    connect(btnHabits, &QPushButton::clicked, this, [=]{ editHabits(); });
+    connect(btnForecast, &QPushButton::clicked, this, [=]{ runWorkloadForecast(); });
+    connect(btnWhatIf, &QPushButton::clicked, this, [=]{ runWhatIf(); });
+    connect(btnJobs, &QPushButton::clicked, this, [=]{ showJobStats(); });
+
     m_mainTabs->addTab(w, "⚙️Settings");
 }
 
@@ -1291,7 +1602,7 @@ void UltraMainWindow::clearLocalStyles() {
 
     for (QPushButton* b : {
         m_aiAnalyzeButton, m_aiSuggestButton, m_aiInsightsButton,
-        m_aiGoalsButton, m_aiHabitsButton, m_aiStressButton, m_aiOptimizeButton,
+        m_aiGoalsButton, m_aiHabitsButton, m_aiStressButton, m_aiOptimizeButton, m_acceptBtn,
         m_btnThemeLight,  m_btnThemeDark,    m_btnResetPanels
     }) {
         if (b) b->setStyleSheet("");
@@ -1419,7 +1730,7 @@ void UltraMainWindow::styleActionButtons() {
     QList<QPushButton*> btns = {
         m_aiAnalyzeButton, m_aiSuggestButton, m_aiInsightsButton,
         m_aiGoalsButton,   m_aiHabitsButton,  m_aiStressButton,
-        m_aiOptimizeButton
+        m_aiOptimizeButton, m_acceptBtn
     };
 
     const QString light = R"(
@@ -1560,7 +1871,104 @@ QString UltraMainWindow::mm(int minutes) {
  */
 QString UltraMainWindow::buildDailyDashboardHtml(const QDate& d) const {
     const bool light = (m_theme == ThemeMode::Light);
-    return ::buildDailyDashboardHtml(m_events, light, d); // note the "::"
+    return appendDayCards(::buildDailyDashboardHtml(dashboardEvents(d), light, d), d); // note the "::"
+}
+
+/**
+ * @brief Only the day's events from visible layers (the renderer filters by
+ *        date anyway). Shallow copies, safe to hand to a worker.
+ */
+QVector<Event> UltraMainWindow::dashboardEvents(const QDate& d) const {
+    QVector<Event> day;
+    for (const auto& lr : m_store->layers().rowsOn(d)) day.push_back(m_store->layers().eventAt(lr.first, d, lr.second));
+    return day;
+}
+
+/**
+ * @brief Cards that read store state (tracked time, deadline check); GUI thread.
+ */
+QString UltraMainWindow::appendDayCards(QString html, const QDate& d) const {
+    const bool light = (m_theme == ThemeMode::Light);
+    const QString pva = buildPlannedVsActualHtml(d);
+    if (!pva.isEmpty()) html = appendSectionCard(html, "Planned vs Actual", pva, light);
+    const QString risk = buildDeadlineRiskHtml();
+    if (!risk.isEmpty()) html = appendSectionCard(html, "Deadlines at Risk", risk, light);
+    return html;
+}
+
+/**
+ * @brief Tasks from the planner pool that cannot be finished before their
+ *        deadline in the free time left. Empty when everything fits.
+ *        Reads the store's last check; nothing is recomputed here.
+ */
+QString UltraMainWindow::buildDeadlineRiskHtml() const {
+    const auto& res = m_store->deadlines();
+    if (res.feasible) return {};
+
+    QString rows;
+    for (const auto& r : res.atRisk) {
+        const QString why = r.noWindow ? QString("no free window of %1 min").arg(r.needMin)
+                                       : QString("%1 min short").arg(r.shortMin);
+        const QString eta = r.finish.isValid() ? r.finish.toString("ddd hh:mm") : QString("—");
+        rows += QString("<tr><td>%1</td><td>%2</td><td style='text-align:right;'>%3</td>"
+                        "<td style='text-align:right;'>%4</td></tr>")
+                .arg(r.title.toHtmlEscaped(), r.deadline.toString("ddd d MMM hh:mm"), why, eta);
+    }
+    return QString("<table style='width:100%;border-collapse:collapse;font-size:12px;'>"
+                   "<tr style='opacity:.7;'><td>Task</td><td>Due</td><td style='text-align:right;'>Gap</td>"
+                   "<td style='text-align:right;'>Done by</td></tr>%1</table>"
+                   "<div style='margin-top:8px;font-size:12px;opacity:.8;'>%2 of %3 task(s) at risk · "
+                   "%4 free min left before the last deadline</div>")
+           .arg(rows).arg(res.atRisk.size()).arg(res.tasks).arg(res.slackMin);
+}
+
+/**
+ * @brief Per-event planned minutes (clipped to @d) against tracked minutes,
+ *        plus ad-hoc sessions. Empty when nothing was tracked that day.
+ *        Reads the tracker's per-day totals only; the journal is never rescanned.
+ */
+QString UltraMainWindow::buildPlannedVsActualHtml(const QDate& d) const {
+    const TimeTracker* tracker = m_store->tracker();
+    if (!tracker) return {};
+    QHash<QString, int> actual = tracker->daySeconds(d);
+    const bool live = tracker->isRunning() && tracker->current().start.date() == d;
+    if (live) {
+        const auto& cur = tracker->current();
+        actual[cur.uid.isEmpty() ? "#" + cur.label : cur.uid] += tracker->elapsedSeconds();
+    }
+    if (actual.isEmpty()) return {};
+
+    const QDateTime d0 = d.startOfDay(), d1 = d.addDays(1).startOfDay();
+    QString rows;
+    int plannedTotal = 0, trackedPlanned = 0, adHocTotal = 0;
+    auto row = [](const QString& title, const QString& planned, int actualMin) {
+        return QString("<tr><td>%1</td><td style='text-align:right;'>%2</td>"
+                       "<td style='text-align:right;'>%3</td></tr>")
+               .arg(title.toHtmlEscaped(), planned, QString::number(actualMin));
+    };
+
+    for (const auto& lr : m_store->layers().rowsOn(d)) {
+        const Event& e = m_store->layers().eventAt(lr.first, d, lr.second);
+        const int planned = int(std::max(e.getStartTime(), d0).secsTo(std::min(e.getEndTime(), d1)) / 60);
+        const int got     = actual.take(e.uid()) / 60;
+        plannedTotal   += std::max(0, planned);
+        trackedPlanned += std::min(got, std::max(0, planned));
+        rows += row(e.getTitle(), QString::number(planned), got);
+    }
+    // Whatever is left is ad-hoc (or belongs to events no longer on this day)
+    for (auto it = actual.cbegin(); it != actual.cend(); ++it) {
+        const int got = it.value() / 60;
+        adHocTotal += got;
+        rows += row(it.key().startsWith('#') ? it.key().mid(1) : QString("(moved event)"), "—", got);
+    }
+
+    const int adherence = plannedTotal > 0 ? 100 * trackedPlanned / plannedTotal : 0;
+    return QString("<table style='width:100%;border-collapse:collapse;font-size:12px;'>"
+                   "<tr style='opacity:.7;'><td>Item</td><td style='text-align:right;'>Planned (min)</td>"
+                   "<td style='text-align:right;'>Actual (min)</td></tr>%1</table>"
+                   "<div style='margin-top:8px;font-size:12px;opacity:.8;'>Adherence %2% · ad-hoc %3 min%4</div>")
+           .arg(rows).arg(adherence).arg(adHocTotal)
+           .arg(live ? QString(" · tracking “%1”").arg(tracker->current().label.toHtmlEscaped()) : QString());
 }
 
 /**
@@ -1569,8 +1977,8 @@ QString UltraMainWindow::buildDailyDashboardHtml(const QDate& d) const {
  */
 QString UltraMainWindow::buildLocalSuggestionsHtml(const QDate& d) const {
     // Gather today's events (sorted)
-    QVector<const Event*> todays; todays.reserve(m_events.size());
-    for (const auto& e : m_events) if (e.isOnDate(d)) todays.push_back(&e);
+    QVector<const Event*> todays; todays.reserve(m_store->events().size());
+    for (const auto& e : m_store->events()) if (e.isOnDate(d)) todays.push_back(&e);
     std::sort(todays.begin(), todays.end(),
               [](const Event* a, const Event* b){ return a->getStartTime() < b->getStartTime(); });
 
@@ -1890,7 +2298,9 @@ void UltraMainWindow::openNewEventDialog(const QDate& date)
 
         auto appendEvent = [&](const QDateTime& st, const QDateTime& en){
             Event ev(t, packedDesc, st, en, col);
-            m_events.append(ev);
+            ev.ensureUid();
+            if (m_store->sync()) m_store->sync()->recordUpsert(ev);
+            m_store->events().append(ev);
         };
 
         switch (recur->currentIndex()) {
@@ -1915,12 +2325,8 @@ void UltraMainWindow::openNewEventDialog(const QDate& date)
             break;
         }
 
-        if (m_calendar) {
-            m_calendar->setEvents(m_events);
-            m_calendar->setSelectedDate(d);
-            m_calendar->update();
-        }
-        refreshMonthFormats();
+        m_store->commit();
+        if (m_calendar) m_calendar->setSelectedDate(d);
         dlg.accept();
     });
 
@@ -1969,11 +2375,8 @@ bool UltraMainWindow::openEditEventDialog(Event& e)
     category->addItems({"Study","Work","Break","Exercise","Personal"});
 
     // Unpack description → category + notes
-    const QString desc = e.getDescription();
-    QString curCat = desc;
-    QString curNotes;
-    const int idxSep = desc.indexOf("::");
-    if (idxSep >= 0) { curCat = desc.left(idxSep); curNotes = desc.mid(idxSep+2); }
+    const QString curCat   = e.category();
+    const QString curNotes = e.notes();
     int catIndex = category->findText(curCat, Qt::MatchFixedString);
     if (catIndex < 0) catIndex = 0;
     category->setCurrentIndex(catIndex);
@@ -2062,47 +2465,819 @@ bool UltraMainWindow::openEditEventDialog(Event& e)
 }
 
 
+// =====================================================
+// ============ Edit / delete ==========================
+// =====================================================
+
+// A "series" is every event with the same title and the same time window
+static bool sameSeries(const Event& a, const Event& b) {
+    return a.getTitle() == b.getTitle()
+        && a.getStartTime().time() == b.getStartTime().time()
+        && a.getEndTime().time()   == b.getEndTime().time();
+}
+
+static bool isSeriesInstance(const QVector<Event>& events, const Event& target) {
+    int count = 0; for (const auto& e : events) if (sameSeries(e, target)) ++count;
+    return count > 1;
+}
+
+/**
+ * @brief Ask "this event / whole series" for a repeated event.
+ *        Returns 1 = this event, 2 = all in series, 0 = canceled.
+ */
+static int askSeriesScope(QWidget* parent) {
+    QMessageBox box(parent);
+    box.setWindowTitle("Apply changes");
+    box.setText("Apply changes to just this event or the whole series?");
+    QPushButton* btnThis   = box.addButton("This event",    QMessageBox::ActionRole);
+    QPushButton* btnAll    = box.addButton("All in series", QMessageBox::ActionRole);
+    QPushButton* btnCancel = box.addButton(QMessageBox::Cancel);
+    box.setDefaultButton(btnThis);
+    box.setEscapeButton(btnCancel);
+    box.exec();
+    if (box.clickedButton() == btnThis) return 1;
+    if (box.clickedButton() == btnAll)  return 2;
+    return 0;
+}
+
+/**
+ * @brief Delete the @row-th personal event on @d (single instance or whole series).
+ *        Used by the day list and the "+N" overflow popup.
+ */
+void UltraMainWindow::deleteEventAt(const QDate& d, int row) {
+    if (!d.isValid()) return;
+    const QVector<int> dayIdx = m_store->index().rowsOn(d);
+    if (row < 0 || row >= dayIdx.size()) return;
+
+    QVector<Event>& events = m_store->events();
+    SyncEngine* sync = m_store->sync();
+    const int idx = dayIdx[row];
+    const Event target = events[idx];
+
+    const int scope = isSeriesInstance(events, target) ? askSeriesScope(this) : 1;
+    if (scope == 0) return;   // canceled
+    if (scope == 1) {
+        if (sync) sync->recordDelete(target.uid());
+        events.removeAt(idx);
+    } else {
+        for (int i = events.size() - 1; i >= 0; --i) {
+            if (!sameSeries(events[i], target)) continue;
+            if (sync) sync->recordDelete(events[i].uid());
+            events.removeAt(i);
+        }
+    }
+
+    m_store->commit();   // every window (this one too) redraws from eventsChanged
+    if (m_calendar) m_calendar->setSelectedDate(d);
+}
+
+/**
+ * @brief Edit the @row-th personal event on @d; a series can be changed as a whole.
+ */
+void UltraMainWindow::editEventAt(const QDate& d, int row) {
+    if (!d.isValid()) return;
+    const QVector<int> dayIdx = m_store->index().rowsOn(d);
+    if (row < 0 || row >= dayIdx.size()) return;
+
+    QVector<Event>& events = m_store->events();
+    SyncEngine* sync = m_store->sync();
+    const int idx = dayIdx[row];
+    const Event original = events[idx];
+    Event updated = original;
+
+    if (!openEditEventDialog(updated)) return;
+
+    const int scope = isSeriesInstance(events, original) ? askSeriesScope(this) : 1;
+    if (scope == 0) return;   // canceled
+    if (scope == 1) {
+        events[idx] = updated;
+        if (sync) sync->recordUpsert(updated);
+    } else {
+        const QTime newStartT = updated.getStartTime().time();
+        const QTime newEndT   = updated.getEndTime().time();
+        for (auto& e : events) {
+            if (!sameSeries(e, original)) continue;
+            e.setTitle(updated.getTitle());
+            e.setDescription(updated.getDescription());
+            e.setColor(colorForCategory(descCategory(updated)));
+            const QDate ds = e.getStartTime().date();
+            const QDate de = e.getEndTime().date();
+            e.setStartTime(QDateTime(ds, newStartT));
+            e.setEndTime(  QDateTime(de, newEndT));
+            if (sync) sync->recordUpsert(e);
+        }
+    }
+
+    m_store->commit();
+    if (m_calendar) m_calendar->setSelectedDate(d);
+}
+
+
 // =====================================================
 // ============ Small helpers for tooltips =============
 // =====================================================
 
 /**
- * @brief Build a multi-line tooltip for a given date aggregating its events.
+ * @brief Multi-line tooltip for a given date aggregating its events.
+ *        Served from the per-day cache; built on first request, memoised per day.
  */
 QString UltraMainWindow::tooltipForDate(const QDate& d) const {
+    return m_store->layers().tooltipFor(d);
+}
+
+/**
+ * @brief Notes for a day-list item, looked up in its layer's per-day cache.
+ */
+QString UltraMainWindow::itemTooltip(const QListWidgetItem* it) const {
+    if (!it) return {};
+    const int slot = it->data(Qt::UserRole).toInt();
+    if (slot < 0 || slot >= m_store->layers().size()) return {};
+    return m_store->layers().at(slot).index().itemTooltip(m_selectedDate, it->data(Qt::UserRole + 1).toInt());
+}
+
+
+// =====================================================
+// ============ Calendar layers ========================
+// =====================================================
+
+/**
+ * @brief Push composed per-day cells for the visible 6×7 grid to the calendar.
+ *        Cheap: reads each visible layer's cached day rows, never scans events.
+ */
+void UltraMainWindow::recomposeCalendar() {
+    if (!m_calendar) return;
+    const QDate first(m_calendar->yearShown(), m_calendar->monthShown(), 1);
+    const int fdow = static_cast<int>(m_calendar->firstDayOfWeek());
+    const QDate gridStart = first.addDays(-((first.dayOfWeek() - fdow + 7) % 7));
+    m_store->requestArchive(this, gridStart, 42);
+    m_calendar->setDayCells(gridStart, m_store->layers().compose(gridStart, 42));
+}
+
+/**
+ * @brief Route the shared ClockService to this window. "Today" highlighting and
+ *        the agenda's Today label follow the midnight rollover (the store
+ *        archives first); reminders go to the status bar.
+ */
+void UltraMainWindow::setupClock() {
+    ClockService* clock = m_store->clock();
+    connect(clock, &ClockService::dayChanged, this, [=](const QDate&) {
+        refreshMonthFormats();
+        if (m_calendar) m_calendar->update();
+        if (m_agenda) m_agenda->refresh();
+    });
+    connect(clock, &ClockService::reminderDue, this, [=](const Event& e, int lead) {
+        statusBar()->showMessage(QString("⏰ %1 starts in %2 min (%3)")
+                                 .arg(e.getTitle()).arg(lead)
+                                 .arg(e.getStartTime().toString("hh:mm")), 5 * 60 * 1000);
+    });
+    connect(clock, &ClockService::eventStarted, this, [=](const Event& e) {
+        statusBar()->showMessage(QString("▶ %1 until %2").arg(e.getTitle(), e.getEndTime().toString("hh:mm")),
+                                 60 * 1000);
+    });
+    connect(clock, &ClockService::eventEnded, this, [=](const Event&) {
+        statusBar()->clearMessage();
+    });
+}
+
+/**
+ * @brief Keep the Track button / dashboard in step with the shared tracker's
+ *        running session. The tracker ticks once a minute at most.
+ */
+void UltraMainWindow::setupTracking() {
+    TimeTracker* tracker = m_store->tracker();
+
+    auto label = [=] {
+        if (!m_trackBtn) return;
+        m_trackBtn->setText(tracker->isRunning()
+                            ? QString("Stop (%1m)").arg(tracker->elapsedSeconds() / 60)
+                            : QString("Track"));
+    };
+    connect(tracker, &TimeTracker::started, this, [=](const TimeTracker::Interval& iv) {
+        label();
+        statusBar()->showMessage(QString("⏱ Tracking %1").arg(iv.label), 5000);
+    });
+    connect(tracker, &TimeTracker::tick, this, [=](int) { label(); });
+    connect(tracker, &TimeTracker::stopped, this, [=](const TimeTracker::Interval& iv) {
+        label();
+        statusBar()->showMessage(QString("⏱ %1: %2 min tracked").arg(iv.label).arg(iv.seconds / 60), 5000);
+        setDashboardHtml(buildDailyDashboardHtml(m_selectedDate));
+    });
+    label();   // a session may have been resumed at startup
+}
+
+/**
+ * @brief Track button: stop the running session, or start one for the selected
+ *        day-list item (any layer); with nothing selected, ask for an ad-hoc label.
+ */
+void UltraMainWindow::toggleTracking() {
+    TimeTracker* tracker = m_store->tracker();
+    if (!tracker) return;
+    if (tracker->isRunning()) { tracker->stop(); return; }
+
+    const QListWidgetItem* cur = m_dayEvents ? m_dayEvents->currentItem() : nullptr;
+    if (cur && m_selectedDate.isValid()) {
+        const int slot = cur->data(Qt::UserRole).toInt();
+        const int row  = cur->data(Qt::UserRole + 1).toInt();
+        tracker->start(m_store->layers().eventAt(slot, m_selectedDate, row));
+        return;
+    }
+
+    bool ok = false;
+    const QString what = QInputDialog::getText(this, "Track time", "What are you working on?",
+                                               QLineEdit::Normal, QString(), &ok);
+    if (ok) tracker->startAdHoc(what);
+}
+
+/**
+ * @brief Free/busy bitmap of the visible layers for @days days from today.
+ *        Built from each layer's EventIndex; no event titles leave the app.
+ */
+FreeBusy UltraMainWindow::buildFreeBusy(int days) const {
+    const int slot = QSettings().value("freebusy/slotMin", 15).toInt();
+    FreeBusy fb(QDate::currentDate(), days, slot);
+    for (int i = 0; i < m_store->layers().size(); ++i)
+        if (m_store->layers().isVisible(i)) fb.addEvents(m_store->layers().at(i).events(), m_store->layers().at(i).index());
+    return fb;
+}
+
+void UltraMainWindow::exportFreeBusy() {
+    const QString path = QFileDialog::getSaveFileName(this, "Export free/busy", "availability.efb",
+                                                      "Free/busy (*.efb)");
+    if (path.isEmpty()) return;
+
+    QElapsedTimer t; t.start();
+    const FreeBusy fb = buildFreeBusy(365);
+    QString error;
+    if (!fb.save(path, &error)) {
+        QMessageBox::warning(this, "Export free/busy", error);
+        return;
+    }
+    if (m_settingsPanel)
+        m_settingsPanel->append(QString("\nFree/busy: %1 days at %2 min → %3 (%4 bytes, %5 ms)")
+                                .arg(fb.days()).arg(fb.slotMinutes()).arg(path)
+                                .arg(QFileInfo(path).size()).arg(t.elapsed()));
+}
+
+/**
+ * @brief Intersect our free/busy with other people's .efb files and list the
+ *        common free time (08:00–20:00) for the next week.
+ */
+void UltraMainWindow::showCommonFreeTime() {
+    const QStringList paths = QFileDialog::getOpenFileNames(this, "Free/busy files to compare", QString(),
+                                                            "Free/busy (*.efb)");
+    if (paths.isEmpty()) return;
+
+    QVector<FreeBusy> all{ buildFreeBusy(7) };
+    for (const QString& p : paths) {
+        QString error;
+        const FreeBusy fb = FreeBusy::load(p, &error);
+        if (fb.isNull()) { QMessageBox::warning(this, QFileInfo(p).fileName(), error); return; }
+        all.push_back(fb);
+    }
+
+    QString error;
+    const FreeBusy common = FreeBusy::intersectFree(all, &error);
+    if (!error.isEmpty()) { QMessageBox::warning(this, "Common free time", error); return; }
     QStringList lines;
-    for (const auto& e : m_events) {
-        if (!e.isOnDate(d)) continue;
-        const QString notes = descNotes(e);
-        const QString line = QString("• %1  (%2–%3)%4")
-            .arg(e.getTitle(),
-                 e.getStartTime().time().toString("hh:mm"),
-                 e.getEndTime().time().toString("hh:mm"),
-                 notes.isEmpty() ? "" : QString("\n    %1").arg(notes));
-        lines << line;
+    for (int d = 0; d < common.days(); ++d) {
+        const QDate day = common.firstDay().addDays(d);
+        QStringList ranges;
+        for (const auto& r : common.freeRanges(day, QTime(8, 0), QTime(20, 0)))
+            if (r.first.secsTo(r.second) >= 30 * 60)
+                ranges << r.first.time().toString("hh:mm") + "–" + r.second.time().toString("hh:mm");
+        lines << day.toString("ddd d MMM") + ": " + (ranges.isEmpty() ? "—" : ranges.join(", "));
+    }
+    if (m_settingsPanel)
+        m_settingsPanel->append(QString("\nCommon free time with %1 file(s):\n").arg(paths.size())
+                                + (common.isNull() ? "no overlapping days" : lines.join("\n")));
+}
+
+/**
+ * @brief Export month or week pages of the visible layers to PDF/PNG.
+ *        Pages are drawn offscreen by CalendarExporter; the window only
+ *        reports progress.
+ */
+void UltraMainWindow::exportCalendar() {
+    if (m_exporter && m_exporter->isBusy()) {
+        statusBar()->showMessage("🖨️ An export is still running — try again when it finishes", 5000);
+        return;
+    }
+    QSettings s;
+    QDialog dlg(this);
+    dlg.setWindowTitle("Export calendar");
+    auto *form   = new QFormLayout(&dlg);
+    auto *view   = new QComboBox(&dlg);
+    view->addItems({ "Month", "Week" });
+    view->setCurrentIndex(s.value("export/view", 0).toInt());
+    auto *pages  = new QSpinBox(&dlg);
+    pages->setRange(1, 60);
+    pages->setValue(s.value("export/pages", 1).toInt());
+    auto *format = new QComboBox(&dlg);
+    format->addItems({ "PDF", "PNG" });
+    format->setCurrentIndex(s.value("export/format", 0).toInt());
+    auto *light  = new QCheckBox("Light theme (for printing)", &dlg);
+    light->setChecked(s.value("export/light", true).toBool());
+    form->addRow("View", view);
+    form->addRow("Pages", pages);
+    form->addRow("Format", format);
+    form->addRow(light);
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Cancel | QDialogButtonBox::Ok, &dlg);
+    form->addRow(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+    if (dlg.exec() != QDialog::Accepted) return;
+
+    s.setValue("export/view",   view->currentIndex());
+    s.setValue("export/pages",  pages->value());
+    s.setValue("export/format", format->currentIndex());
+    s.setValue("export/light",  light->isChecked());
+
+    CalendarExporter::Job job;
+    job.view     = view->currentIndex() == 0 ? CalendarExporter::View::Month : CalendarExporter::View::Week;
+    job.format   = format->currentIndex() == 0 ? CalendarExporter::Format::Pdf : CalendarExporter::Format::Png;
+    job.pages    = pages->value();
+    job.light    = light->isChecked();
+    job.from     = m_selectedDate.isValid() ? m_selectedDate : QDate::currentDate();
+    job.firstDay = m_calendar ? m_calendar->firstDayOfWeek() : Qt::Monday;
+
+    const bool pdf = job.format == CalendarExporter::Format::Pdf;
+    job.path = QFileDialog::getSaveFileName(this, "Export calendar",
+                                            pdf ? "calendar.pdf" : "calendar.png",
+                                            pdf ? "PDF (*.pdf)" : "PNG images (*.png)");
+    if (job.path.isEmpty()) return;
+
+    if (!m_exporter) {
+        m_exporter = new CalendarExporter(m_store->jobs(), this);
+        connect(m_exporter, &CalendarExporter::progress, this, [this](int, int done, int total){
+            statusBar()->showMessage(QString("🖨️ Exporting page %1 of %2…").arg(done).arg(total), 2000);
+        });
+        connect(m_exporter, &CalendarExporter::finished, this,
+                [this](int, const QStringList& files, const QString& error){
+            if (!error.isEmpty()) QMessageBox::warning(this, "Export calendar", error);
+            if (files.isEmpty()) return;
+            statusBar()->showMessage(QString("🖨️ Exported %1 file(s)").arg(files.size()), 5000);
+            if (m_settingsPanel)
+                m_settingsPanel->append("\nExported: " + files.join(", "));
+        });
     }
-    return lines.join("\n");
+    // Archived months are only in the layer stack while a view asks for them
+    const QDate first = job.view == CalendarExporter::View::Month
+                        ? QDate(job.from.year(), job.from.month(), 1).addDays(-7)
+                        : job.from.addDays(-7);
+    const int span = job.view == CalendarExporter::View::Month ? 31 * job.pages + 14 : 7 * job.pages + 14;
+    m_store->requestArchive(m_exporter, first, span);
+    m_exporter->start(job, m_store->layers());
+    m_store->releaseArchive(m_exporter);
+}
+
+/**
+ * @brief Edit the task pool the planner, the deadline check and the forecast
+ *        read (title, effort, priority, optional deadline). Fields not shown
+ *        here are kept as they were.
+ */
+void UltraMainWindow::editTasks() {
+    static const char* kDeadlineFmt = "yyyy-MM-dd hh:mm";
+    QVector<SuperAI::Task> tasks = m_superAI->tasks();
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("Tasks");
+    dlg.resize(620, 380);
+    auto *ly    = new QVBoxLayout(&dlg);
+    auto *table = new QTableWidget(0, 4, &dlg);
+    table->setHorizontalHeaderLabels({ "Title", "Minutes", "Priority (1–5)",
+                                       QString("Deadline (%1)").arg(kDeadlineFmt) });
+    table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    table->verticalHeader()->hide();
+    auto addRow = [table](const SuperAI::Task& t) {
+        const int r = table->rowCount();
+        table->insertRow(r);
+        table->setItem(r, 0, new QTableWidgetItem(t.title));
+        table->setItem(r, 1, new QTableWidgetItem(QString::number(t.estimateMin)));
+        table->setItem(r, 2, new QTableWidgetItem(QString::number(t.priority)));
+        table->setItem(r, 3, new QTableWidgetItem(t.deadline.isValid() ? t.deadline.toString(kDeadlineFmt) : QString()));
+    };
+    for (const auto& t : std::as_const(tasks)) addRow(t);
+    ly->addWidget(table, 1);
+
+    auto *row    = new QHBoxLayout; ly->addLayout(row);
+    auto *add    = new QPushButton("＋ Task", &dlg);
+    auto *remove = new QPushButton("Remove", &dlg);
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Cancel | QDialogButtonBox::Save, &dlg);
+    row->addWidget(add);
+    row->addWidget(remove);
+    row->addStretch(1);
+    row->addWidget(buttons);
+
+    connect(add, &QPushButton::clicked, &dlg, [=, &tasks] {
+        SuperAI::Task t;
+        t.title = "New task";
+        tasks.push_back(t);
+        addRow(t);
+        table->editItem(table->item(table->rowCount() - 1, 0));
+    });
+    connect(remove, &QPushButton::clicked, &dlg, [=, &tasks] {
+        const int r = table->currentRow();
+        if (r < 0) return;
+        table->removeRow(r);
+        tasks.removeAt(r);
+    });
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+    if (dlg.exec() != QDialog::Accepted) return;
+
+    QVector<SuperAI::Task> pool;
+    for (int r = 0; r < table->rowCount(); ++r) {
+        SuperAI::Task t = tasks[r];
+        t.title = table->item(r, 0)->text().trimmed();
+        if (t.title.isEmpty()) continue;
+        t.estimateMin = std::max(5, table->item(r, 1)->text().toInt());
+        t.priority    = std::clamp(table->item(r, 2)->text().toInt(), 1, 5);
+        t.deadline    = QDateTime::fromString(table->item(r, 3)->text().trimmed(), kDeadlineFmt);
+        pool.push_back(t);
+    }
+    m_store->setTasks(pool);
+    if (m_settingsPanel) m_settingsPanel->append(QString("\nTask pool: %1 task(s)").arg(pool.size()));
+}
+
+/**
+ * @brief Edit the habit pool the Habits button plans into the week (title,
+ *        minutes per day, days per week, anchor, priority).
+ */
+void UltraMainWindow::editHabits() {
+    QDialog dlg(this);
+    dlg.setWindowTitle("Habits");
+    dlg.resize(620, 340);
+    auto *ly    = new QVBoxLayout(&dlg);
+    auto *table = new QTableWidget(0, 5, &dlg);
+    table->setHorizontalHeaderLabels({ "Title", "Minutes", "Days / week", "Anchor", "Priority (1–5)" });
+    table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    table->verticalHeader()->hide();
+    auto addRow = [table, &dlg](const SuperAI::Habit& h) {
+        const int r = table->rowCount();
+        table->insertRow(r);
+        table->setItem(r, 0, new QTableWidgetItem(h.title));
+        table->setItem(r, 1, new QTableWidgetItem(QString::number(h.targetMinPerDay)));
+        table->setItem(r, 2, new QTableWidgetItem(QString::number(h.daysPerWeek)));
+        auto *anchor = new QComboBox(&dlg);
+        anchor->addItem("any", QString());
+        for (const char* a : { "morning", "after-lunch", "evening" }) anchor->addItem(a, QString(a));
+        anchor->setCurrentIndex(std::max(0, anchor->findData(h.anchor)));
+        table->setCellWidget(r, 3, anchor);
+        table->setItem(r, 4, new QTableWidgetItem(QString::number(h.priority)));
+    };
+    for (const auto& h : m_superAI->habits()) addRow(h);
+    ly->addWidget(table, 1);
+
+    auto *row    = new QHBoxLayout; ly->addLayout(row);
+    auto *add    = new QPushButton("＋ Habit", &dlg);
+    auto *remove = new QPushButton("Remove", &dlg);
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Cancel | QDialogButtonBox::Save, &dlg);
+    row->addWidget(add);
+    row->addWidget(remove);
+    row->addStretch(1);
+    row->addWidget(buttons);
+
+    connect(add, &QPushButton::clicked, &dlg, [=] {
+        SuperAI::Habit h;
+        h.title = "New habit";
+        addRow(h);
+        table->editItem(table->item(table->rowCount() - 1, 0));
+    });
+    connect(remove, &QPushButton::clicked, &dlg, [=] {
+        if (table->currentRow() >= 0) table->removeRow(table->currentRow());
+    });
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+    if (dlg.exec() != QDialog::Accepted) return;
+
+    QVector<SuperAI::Habit> pool;
+    for (int r = 0; r < table->rowCount(); ++r) {
+        SuperAI::Habit h;
+        h.title = table->item(r, 0)->text().trimmed();
+        if (h.title.isEmpty()) continue;
+        h.targetMinPerDay = std::max(5, table->item(r, 1)->text().toInt());
+        h.daysPerWeek     = std::clamp(table->item(r, 2)->text().toInt(), 1, 7);
+        h.anchor          = qobject_cast<QComboBox*>(table->cellWidget(r, 3))->currentData().toString();
+        h.priority        = std::clamp(table->item(r, 4)->text().toInt(), 1, 5);
+        pool.push_back(h);
+    }
+    m_store->setHabits(pool);
+    if (m_settingsPanel) m_settingsPanel->append(QString("\nHabit pool: %1 habit(s)").arg(pool.size()));
+}
+
+/**
+ * @brief Simulate the task pool over the next weeks with effort spreads
+ *        learned from tracked time, and list overload / lateness odds.
+ */
+void UltraMainWindow::runWorkloadForecast() {
+    QSettings s;
+    WorkloadForecast::Params p;
+    p.now        = m_superAI->now();
+    p.weeks      = s.value("forecast/weeks", 8).toInt();
+    p.runs       = s.value("forecast/runs", 4000).toInt();
+    p.overloadAt = s.value("forecast/overloadAt", 0.85).toDouble();
+
+    const QDate today = p.now.date();
+    const auto spreads = m_store->tracker()
+        ? WorkloadForecast::learn(m_store->events(), m_store->index(), *m_store->tracker(), today.addDays(-90), today)
+        : WorkloadForecast::Spreads();
+    auto snap = QSharedPointer<const WorkloadForecast::Snapshot>::create(
+        WorkloadForecast::snapshot(*m_superAI, m_store->events(), m_store->index(),
+                                   m_superAI->tasks(), spreads, p));
+    if (snap->items.isEmpty()) {
+        if (m_settingsPanel) m_settingsPanel->append("\nForecast: no tasks with a deadline in the next "
+                                                     + QString::number(p.weeks) + " weeks (add them under 📋 Tasks…).");
+        return;
+    }
+
+    if (!m_forecast) {
+        m_forecast = new WorkloadForecast(m_store->jobs(), this);
+        connect(m_forecast, &WorkloadForecast::finished, this, [this](int, const WorkloadForecast::Result& r){
+            if (!m_settingsPanel) return;
+            QStringList lines{ QString("\nForecast: %1 runs in %2 ms").arg(r.runs).arg(r.elapsedUs / 1000.0, 0, 'f', 1) };
+            for (const auto& w : r.weeks)
+                lines << QString("  week of %1  free %2 min  due p50 %3 / p90 %4  overload %5%")
+                         .arg(w.start.toString("d MMM")).arg(w.freeMin).arg(w.dueP50Min).arg(w.dueP90Min)
+                         .arg(qRound(100 * w.pOverload));
+            for (const auto& d : r.deadlines)
+                if (d.pLate > 0.01)
+                    lines << QString("  %1 (due %2): %3% chance late")
+                             .arg(d.title, d.deadline.toString("ddd d MMM hh:mm")).arg(qRound(100 * d.pLate));
+            m_settingsPanel->append(lines.join("\n"));
+        });
+    }
+    m_forecast->run(snap, p);
+}
+
+/**
+ * @brief Compare the coming days with hypothetical changes (dropping events
+ *        by title, adding a weekly commitment, or both): the task pool is
+ *        planned into each variant and the scores are listed against "Current".
+ */
+void UltraMainWindow::runWhatIf() {
+    QSettings s;
+    QDialog dlg(this);
+    dlg.setWindowTitle("What if…");
+    auto *form   = new QFormLayout(&dlg);
+    auto *drop   = new QLineEdit(&dlg);
+    auto *title  = new QLineEdit(&dlg);
+    auto *dow    = new QComboBox(&dlg);
+    auto *start  = new QTimeEdit(QTime(18, 0), &dlg);
+    auto *end    = new QTimeEdit(QTime(21, 0), &dlg);
+    auto *weeks  = new QSpinBox(&dlg);
+    auto *days   = new QSpinBox(&dlg);
+    drop->setPlaceholderText("e.g. Statistics Lecture, Gym");
+    title->setPlaceholderText("e.g. Part-time job");
+    for (int d = 1; d <= 7; ++d) dow->addItem(QLocale().dayName(d), d);
+    weeks->setRange(1, 52);
+    weeks->setValue(8);
+    days->setRange(1, 56);
+    days->setSuffix(" days");
+    days->setValue(s.value("whatif/days", 14).toInt());
+    form->addRow("Drop events titled", drop);
+    form->addRow("Add weekly", title);
+    form->addRow("on", dow);
+    form->addRow("from", start);
+    form->addRow("to", end);
+    form->addRow("for weeks", weeks);
+    form->addRow("Compare over", days);
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Cancel | QDialogButtonBox::Ok, &dlg);
+    buttons->button(QDialogButtonBox::Ok)->setText("Compare");
+    form->addRow(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+    if (dlg.exec() != QDialog::Accepted) return;
+    s.setValue("whatif/days", days->value());
+
+    ScenarioEngine::Params p;
+    p.now     = m_superAI->now();
+    p.from    = p.now.date();
+    p.days    = days->value();
+    p.tasks   = m_superAI->tasks();
+    p.habits  = m_superAI->habits();
+    p.weights = m_superAI->weights();
+
+    // One scenario per change, plus both together when there are two
+    QVector<ScenarioEngine::Scenario> scenarios;
+    ScenarioEngine::Scenario without, with;
+    for (const QString& t : drop->text().split(',', Qt::SkipEmptyParts))
+        if (!t.trimmed().isEmpty()) without.removeTitles << t.trimmed();
+    if (!without.removeTitles.isEmpty()) {
+        without.name = "Without " + without.removeTitles.join(", ");
+        scenarios.push_back(without);
+    }
+    if (!title->text().trimmed().isEmpty() && start->time() < end->time()) {
+        with.name = QString("With %1 (%2 %3–%4)").arg(title->text().trimmed(), QLocale().dayName(dow->currentData().toInt(), QLocale::ShortFormat),
+                                                     start->time().toString("hh:mm"), end->time().toString("hh:mm"));
+        with.addWeekly(title->text().trimmed(), Qt::DayOfWeek(dow->currentData().toInt()),
+                       start->time(), end->time(), p.from, weeks->value());
+        scenarios.push_back(with);
+    }
+    if (scenarios.size() == 2) {
+        ScenarioEngine::Scenario both = without;
+        both.name = "Both";
+        both.adds = with.adds;
+        scenarios.push_back(both);
+    }
+    if (scenarios.isEmpty()) {
+        if (m_settingsPanel) m_settingsPanel->append("
+What if: nothing to compare (name events to drop or a weekly commitment to add).");
+        return;
+    }
+
+    if (!m_scenarios) {
+        m_scenarios = new ScenarioEngine(m_store->jobs(), this);
+        connect(m_scenarios, &ScenarioEngine::finished, this, [this](int runId, const QVector<ScenarioEngine::Metrics>& r){
+            if (runId != m_whatIfRun || !m_settingsPanel || r.isEmpty()) return;
+            const auto& cur = r.first();
+            auto delta = [](int v, int base) { return v == base ? QString() : QString(" (%1%2)").arg(v > base ? "+" : "").arg(v - base); };
+            QStringList lines{ "\nWhat if:" };
+            for (const auto& m : r)
+                lines << QString("  %1: free %2 min%3, planned %4 min%5, unplaced %6 min%7, risk avg %8%9 / peak %10, balance %11%12")
+                         .arg(m.name).arg(m.freeMin).arg(delta(m.freeMin, cur.freeMin))
+                         .arg(m.plannedMin).arg(delta(m.plannedMin, cur.plannedMin))
+                         .arg(m.unplacedMin).arg(delta(m.unplacedMin, cur.unplacedMin))
+                         .arg(m.avgRisk).arg(delta(m.avgRisk, cur.avgRisk)).arg(m.peakRisk)
+                         .arg(m.avgBalance).arg(delta(m.avgBalance, cur.avgBalance));
+            m_settingsPanel->append(lines.join("\n"));
+        });
+    }
+    m_whatIfRun = m_scenarios->evaluate(m_store->events(), scenarios, p);
+}
+
+/**
+ * @brief Queue depth and latency per class of the shared job scheduler.
+ */
+void UltraMainWindow::showJobStats() {
+    if (!m_settingsPanel) return;
+    const JobScheduler* jobs = m_store->jobs();
+    QStringList lines{ QString("\nBackground jobs: %1 worker threads").arg(jobs->threadCount()) };
+    for (int c = 0; c < JobScheduler::kClasses; ++c) {
+        const auto prio = JobScheduler::Priority(c);
+        const auto st   = jobs->stats(prio);
+        lines << QString("  %1: %2 ready, %3 blocked, %4 running, %5 done, %6 cancelled;"
+                         " wait avg %7 ms / max %8 ms, run avg %9 ms")
+                 .arg(JobScheduler::className(prio))
+                 .arg(st.ready).arg(st.blocked).arg(st.running).arg(st.done).arg(st.cancelled)
+                 .arg(st.avgWaitMs, 0, 'f', 1).arg(st.maxWaitMs, 0, 'f', 1).arg(st.avgRunMs, 0, 'f', 1);
+    }
+    m_settingsPanel->append(lines.join("\n"));
+}
+
+/**
+ * @brief Recreate the layer toggle row above the calendar.
+ */
+void UltraMainWindow::rebuildLayerBar() {
+    if (!m_layerBar) return;
+    auto *ly = qobject_cast<QHBoxLayout*>(m_layerBar->layout());
+    while (QLayoutItem* item = ly->takeAt(0)) {
+        if (QWidget* w = item->widget()) { w->hide(); w->deleteLater(); }  // may be the sender
+        delete item;
+    }
+
+    for (int i = 0; i < m_store->layers().size(); ++i) {
+        const auto& l = m_store->layers().at(i);
+        auto *cb = new QCheckBox(l.readOnly ? l.name + " 🔒" : l.name, m_layerBar);
+        cb->setChecked(l.visible);
+        cb->setStyleSheet(QString("QCheckBox{ color:%1; font-weight:600; }").arg(l.color.name()));
+        connect(cb, &QCheckBox::toggled, this, [this, i](bool on) {
+            m_store->setLayerVisible(i, on);   // every window rebuilds from layersChanged
+        });
+        ly->addWidget(cb);
+    }
+
+    // Category filter: hides matching events in the grid, day list, agenda and dashboard
+    const int hidden = m_store->hiddenCategoryCount();
+    auto *cats = new QToolButton(m_layerBar);
+    cats->setText(hidden ? QString("🏷️ Categories (%1 hidden)").arg(hidden) : QString("🏷️ Categories"));
+    cats->setPopupMode(QToolButton::InstantPopup);
+    cats->setCursor(Qt::PointingHandCursor);
+    auto *menu = new QMenu(cats);
+    menu->setToolTipsVisible(true);
+    connect(menu, &QMenu::aboutToShow, this, [this, menu] {   // categories register as indexes build
+        menu->clear();
+        for (const QString& name : EventIndex::categoryNames()) {
+            QAction *a = menu->addAction(name.isEmpty() ? QStringLiteral("(uncategorised)") : name);
+            a->setCheckable(true);
+            a->setChecked(m_store->isCategoryVisible(name));
+            connect(a, &QAction::toggled, this, [this, name](bool on) { m_store->setCategoryVisible(name, on); });
+        }
+        // Past 63 categories the rest share one bit and are filtered together
+        const QStringList other = EventIndex::otherCategoryNames();
+        if (!other.isEmpty()) {
+            QAction *a = menu->addAction(QString("Other (%1 more categories)").arg(other.size()));
+            a->setToolTip(other.join(", "));
+            a->setCheckable(true);
+            a->setChecked(m_store->otherCategoriesVisible());
+            connect(a, &QAction::toggled, this, [this](bool on) { m_store->setOtherCategoriesVisible(on); });
+        }
+        menu->addSeparator();
+        QAction *all = menu->addAction("Show all");
+        all->setEnabled(m_store->hiddenCategoryCount() > 0);
+        connect(all, &QAction::triggered, this, [this] { m_store->showAllCategories(); });
+    });
+    cats->setMenu(menu);
+    ly->addWidget(cats);
+    ly->addStretch(1);
+
+    auto *add = new QPushButton("＋ Layer", m_layerBar);
+    add->setCursor(Qt::PointingHandCursor);
+    connect(add, &QPushButton::clicked, this, [this] {
+        const QString path = QFileDialog::getOpenFileName(this, "Import calendar layer", QString(),
+                                                          "Calendar JSON (*.json)");
+        if (path.isEmpty() || !m_store->importLayer(path)) return;
+        m_store->saveLayerSettings();
+    });
+    ly->addWidget(add);
 }
 
 /**
  * @brief From "Category::Notes" → "Category".
  */
 QString UltraMainWindow::descCategory(const Event& e) const {
-    const QString d = e.getDescription();
-    const int i = d.indexOf("::");
-    return (i < 0 ? d : d.left(i)).trimmed();
+    return e.category().trimmed();
 }
 
 /**
  * @brief From "Category::Notes" → "Notes".
  */
 QString UltraMainWindow::descNotes(const Event& e) const {
-    const QString d = e.getDescription();
-    const int i = d.indexOf("::");
-    return (i < 0 ? QString() : d.mid(i + 2)).trimmed();
+    return e.notes().trimmed();
 }
 
 
+/**
+ * @brief Re-parse the quick-add line (incrementally) and show what Enter would
+ *        create plus how many occurrences overlap events on visible layers.
+ */
+void UltraMainWindow::updateQuickAddPreview() {
+    if (!m_quickAdd || !m_quickPreview) return;
+    const QString text = m_quickAdd->text();
+    if (text.trimmed().isEmpty()) { m_quickPreview->hide(); return; }
+
+    m_quickParser.setToday(QDate::currentDate());
+    const auto& r = m_quickParser.parse(text);
+    if (!r.isValid()) {
+        m_quickPreview->setText(r.title.isEmpty() ? "Type a title…" : "Add a time, e.g. 15:00-17:00");
+        m_quickPreview->setStyleSheet("font-size:12px; color:#9aa3ab;");
+        m_quickPreview->show();
+        return;
+    }
+
+    // Conflicts straight from the per-day index of every visible layer (hidden categories still take time)
+    const auto occ = r.occurrences();
+    int clashes = 0;
+    QString first;
+    for (const auto& o : occ) {
+        for (const auto& lr : m_store->layers().rowsOn(o.first.date(), EventIndex::kAllCategories)) {
+            const Event& e = m_store->layers().eventAt(lr.first, o.first.date(), lr.second);
+            if (e.getStartTime() < o.second && e.getEndTime() > o.first) {
+                if (!clashes++) first = QString("%1 %2").arg(e.getTitle(), o.first.toString("ddd d MMM"));
+                break;
+            }
+        }
+    }
+
+    QString line = QString("%1 · %2").arg(r.title.toHtmlEscaped(), r.describe().toHtmlEscaped());
+    if (occ.size() > 1) line += QString(" (%1×)").arg(occ.size());
+    line += clashes ? QString(" · ⚠ %1 conflict%2 (%3)").arg(clashes).arg(clashes > 1 ? "s" : "")
+                                                         .arg(first.toHtmlEscaped())
+                    : QString(" · ✓ free");
+    m_quickPreview->setText(line);
+    m_quickPreview->setStyleSheet(clashes ? "font-size:12px; color:#e11d48;" : "font-size:12px; color:#22c55e;");
+    m_quickPreview->show();
+}
+
+/**
+ * @brief Append every occurrence of the parsed quick-add line, then reindex
+ *        once (one sync delta) — the whole series lands as one change.
+ */
+void UltraMainWindow::commitQuickAdd() {
+    if (!m_quickAdd) return;
+    m_quickParser.setToday(QDate::currentDate());
+    const auto r = m_quickParser.parse(m_quickAdd->text());
+    if (!r.isValid()) { updateQuickAddPreview(); return; }
+
+    const Event base(r.title, r.category, QDateTime(r.date, r.start), QDateTime(r.date, r.end),
+                     colorForCategory(r.category));
+    const auto occ = r.occurrences();
+    m_store->events().reserve(m_store->events().size() + occ.size());
+    for (const auto& o : occ) {
+        Event ev = base;   // instances share base's cold block
+        ev.setStartTime(o.first);
+        ev.setEndTime(o.second);
+        ev.ensureUid();
+        if (m_store->sync()) m_store->sync()->recordUpsert(ev);
+        m_store->events().append(ev);
+    }
+
+    m_store->commit();
+    if (m_calendar) m_calendar->setSelectedDate(r.date);
+
+    m_quickAdd->clear();
+    if (m_quickPreview) m_quickPreview->hide();
+}
+
 // =====================================================
 // ============ Recurrence Expansion API ===============
 // =====================================================
@@ -2113,8 +3288,15 @@ QString UltraMainWindow::descNotes(const Event& e) const {
  */
 void UltraMainWindow::addEventWithRecurrence(const Event& base, int recurIndex) {
     auto appendIf = [&](const QDateTime& st, const QDateTime& en){
-        Event ev(base.getTitle(), base.getDescription(), st, en, base.getColor());
-        m_events.append(ev);
+        // Copy (not re-construct) so every instance shares base's cold notes block
+        Event ev = base;
+        ev.setId(-1);
+        ev.setStartTime(st);
+        ev.setEndTime(en);
+        ev.setUid(QString());
+        ev.ensureUid();
+        if (m_store->sync()) m_store->sync()->recordUpsert(ev);
+        m_store->events().append(ev);
     };
 
     const QDateTime s0 = base.getStartTime();
@@ -2147,6 +3329,8 @@ void UltraMainWindow::addEventWithRecurrence(const Event& base, int recurIndex)
         break;
     }
     }
+
+    m_store->commit();
 }
 
 // NOTE: Custom header helper (disabled but preserved for reference).
@@ -12,11 +12,16 @@
 #include <QPushButton>
 #include <QPropertyAnimation>
 #include <QWebEngineView>
+#include <memory>
 
 
 #include "Event.h"                // needs full type for QVector<Event>
+#include "CalendarStore.h"        // shared events, caches, planner and services
+#include "QuickAddParser.h"       // incremental one-line event entry
+#include "JobScheduler.h"         // CancelToken for the dashboard job
 
 class QLabel;            
+class QLineEdit;
 class QTabWidget;
 class QTextEdit;
 class QListWidget;
@@ -29,6 +34,13 @@ class ModernCalendarWidget;
 class SuperAI;
 class Event;
 class WeekHeaderView;
+class QListWidgetItem;
+class AgendaModel;
+class FreeBusy;
+class DayEventsPopup;
+class CalendarExporter;
+class WorkloadForecast;
+class ScenarioEngine;
 
 
 class UltraMainWindow : public QMainWindow
@@ -37,11 +49,12 @@ class UltraMainWindow : public QMainWindow
 public:
     enum class ThemeMode { Light, Dark };
 
-    explicit UltraMainWindow(QWidget *parent = nullptr);
+    explicit UltraMainWindow(CalendarStore* store, QWidget *parent = nullptr);
     ~UltraMainWindow();
     void buildUltraAITab();
     void buildAnalyticsTab();
     void buildProductivityTab();
+    void buildAgendaTab();
     void buildSettingsTab();
 
     // UI build
@@ -73,12 +86,19 @@ public:
     // Misc
     QColor  colorForCategory(const QString& cat) const;
     QString buildDailyDashboardHtml(const QDate& d) const;
+    QVector<Event> dashboardEvents(const QDate& d) const;
+    QString appendDayCards(QString html, const QDate& d) const;
 
     // simple formatter that can be used from const methods
     static QString mm(int minutes);
 
+    /// No deferred day details pending and the dashboard has rendered (UI replay).
+    bool isSettled() const;
+
 signals:
     void themeChanged();   
+    void eventsChanged();   // store events changed (any window, sync, archiving)
+    void layersChanged();   // a layer was toggled or imported
     
 protected:
     void changeEvent(QEvent* e) override;
@@ -106,7 +126,32 @@ private: // periodic updates
     QString descCategory(const Event& e) const;
     QString descNotes(const Event& e) const;
     QString tooltipForDate(const QDate& d) const;
+    QString itemTooltip(const QListWidgetItem* it) const;
     void addEventWithRecurrence(const Event& base, int recurIndex);
+    void editEventAt(const QDate& d, int rowInDay);     // personal layer row (EventIndex::rowsOn)
+    void deleteEventAt(const QDate& d, int rowInDay);
+    void recomposeCalendar();
+    void rebuildLayerBar();
+    FreeBusy buildFreeBusy(int days) const;
+    void exportFreeBusy();
+    void showCommonFreeTime();
+    void exportCalendar();
+    void editTasks();
+    void editHabits();
+    void planHabitWeek();
+    void runWorkloadForecast();
+    void runWhatIf();
+    void showJobStats();
+    void updateQuickAddPreview();
+    void commitQuickAdd();
+    void setupClock();
+    void setupTracking();
+    void toggleTracking();
+    QString buildPlannedVsActualHtml(const QDate& d) const;
+    QString buildDeadlineRiskHtml() const;
+    void openNewWindow();
+    SuperAI* ai();                 // shared planner, replies routed to this window
+    bool ownsAIReply() const;      // false while another window's request is answered
     void forceGrayWeekdayHeader();
     QWebEngineView* m_aiWeb = nullptr;   // NEW: right-side dashboard
     
@@ -152,9 +197,29 @@ private: // widgets & state
     // runtime
     ThemeMode     m_theme = ThemeMode::Dark;
     QDate         m_selectedDate;
-    QVector<Event> m_events;
-    SuperAI*      m_superAI = nullptr;
-    QTimer*       m_updateTimer = nullptr;
+    CalendarStore* m_store = nullptr;   // events, caches, planner, clock, sync (shared, not owned)
+    QWidget*      m_layerBar = nullptr;
+    DayEventsPopup* m_dayPopup = nullptr;     // "+N" overflow list for a day cell
+    CalendarExporter* m_exporter = nullptr;   // offscreen PDF/PNG pages on worker threads (lazy)
+    WorkloadForecast* m_forecast = nullptr;   // Monte Carlo overload forecast of the task pool (lazy)
+    ScenarioEngine*   m_scenarios = nullptr;  // "What if…" comparisons (lazy)
+    int               m_whatIfRun = 0;        // latest run; older results are dropped
+    QLineEdit*    m_quickAdd = nullptr;       // one-line "Title Tue 15:00-17:00 weekly" entry
+    QLabel*       m_quickPreview = nullptr;   // live parse + conflict line under it
+    QuickAddParser m_quickParser;             // keeps per-token state between keystrokes
+    AgendaModel*  m_agenda = nullptr;   // paged "coming up" list over the visible layers
+    SuperAI*      m_superAI = nullptr;     // m_store->planner(); use ai() to issue requests
+    QPushButton*  m_trackBtn = nullptr;        // "Track" / "Stop (N min)" under the day list
+    QPushButton*  m_acceptBtn = nullptr;       // adds the last planner suggestions to the day
+    QVector<Event> m_suggestions;              // last suggestions this window received…
+    QDate         m_suggestionsDay;            // …the first day they plan…
+    int           m_suggestionsDays = 1;       // …and how many days (7 for a habit week)
+    QTimer*       m_detailTimer = nullptr;     // deferred day-detail stage (list, dashboard, planning)
+    quint64       m_selectGen = 0;             // bumped on every selection; stale detail steps bail out
+    quint64       m_detailDoneGen = 0;         // last selection whose detail stage ran to the end
+    quint64       m_dashGen = 0;               // bumped by setDashboardHtml()
+    quint64       m_dashDoneGen = 0;           // last dashboard load that finished and laid out
+    JobScheduler::CancelToken m_dashJob;       // selected-day dashboard build (Interactive job)
 
     // fun animations
     QPropertyAnimation *m_fadeAnimation = nullptr,
@@ -0,0 +1,250 @@
+#include "WorkloadForecast.h"
+#include "TimeTracker.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <algorithm>  // std::stable_sort, std::nth_element, std::max, std::min
+#include <cmath>      // std::exp, std::log, std::sqrt
+#include <random>     // std::normal_distribution
+
+static constexpr int    kMinBlockMin = 15;   // same as planDay()
+static constexpr int    kPostBufMin  = 10;   // scheduleTasksIntoWindows() tail buffer per chunk
+static constexpr int    kMinSamples  = 3;    // history needed before a category gets its own spread
+static constexpr qint64 kMinMs       = 60 * 1000;
+
+/// Counts from one chunk of runs.
+struct WorkloadForecast::Tally {
+    QVector<int>          overloads;   ///< per week
+    QVector<int>          late;        ///< per item
+    QVector<QVector<int>> due;         ///< per week: work due by week end, one sample per run
+};
+
+WorkloadForecast::WorkloadForecast(JobScheduler* jobs, QObject* parent)
+    : QObject(parent), m_jobs(jobs)
+{
+}
+
+WorkloadForecast::~WorkloadForecast()
+{
+    m_cancel.cancel();
+}
+
+// ============================================================================
+// Inputs (GUI thread)
+// ============================================================================
+
+/**
+ * @brief learn
+ * For every event in [from, to] with a tracked session, log(actual/planned)
+ * goes into its category and into the pooled "" bucket.
+ */
+WorkloadForecast::Spreads WorkloadForecast::learn(const QVector<Event>& events, const EventIndex& index,
+                                                  const TimeTracker& tracker, const QDate& from, const QDate& to)
+{
+    QHash<QString, QVector<double>> logs;
+    for (QDate d = from; d <= to; d = d.addDays(1)) {
+        const QHash<QString, int> actual = tracker.daySeconds(d);
+        if (actual.isEmpty()) continue;
+        for (int r : index.rowsOn(d)) {
+            const Event& e = events[r];
+            if (e.getStartTime().date() != e.getEndTime().date()) continue;   // multi-day: no clear plan
+            const int secs    = actual.value(e.uid());
+            const int planned = int(e.getStartTime().secsTo(e.getEndTime()));
+            if (secs <= 0 || planned < 10 * 60) continue;
+            const double x = std::log(double(secs) / planned);
+            logs[e.category().trimmed().toLower()].push_back(x);
+            logs[QString()].push_back(x);
+        }
+    }
+
+    Spreads out;
+    for (auto it = logs.cbegin(); it != logs.cend(); ++it) {
+        const QVector<double>& v = it.value();
+        if (v.size() < kMinSamples) continue;
+        double mean = 0, var = 0;
+        for (double x : v) mean += x;
+        mean /= v.size();
+        for (double x : v) var += (x - mean) * (x - mean);
+        var /= (v.size() - 1);
+        out.insert(it.key(), Spread{ mean, std::max(0.05, std::sqrt(var)), int(v.size()) });
+    }
+    return out;
+}
+
+WorkloadForecast::Snapshot WorkloadForecast::snapshot(const SuperAI& planner, const QVector<Event>& events,
+                                                      const EventIndex& index,
+                                                      const QVector<SuperAI::Task>& tasks,
+                                                      const Spreads& spreads, const Params& p)
+{
+    Snapshot s;
+    s.from  = p.now.date();
+    s.weeks = std::max(1, p.weeks);
+    s.weekFreeMin.fill(0, s.weeks);
+
+    // Free windows from now to the horizon end, one pass over the calendar
+    const qint64 nowMs = p.now.toMSecsSinceEpoch();
+    QVector<QPair<qint64, qint64>> windows;
+    for (int d = 0; d < 7 * s.weeks; ++d) {
+        const QDate day = s.from.addDays(d);
+        QVector<Event> busy;
+        for (int r : index.rowsOn(day)) busy.push_back(events[r]);
+        for (const auto& w : planner.freeWindows(day, busy, kMinBlockMin)) {
+            const qint64 a = std::max(nowMs, w.start.toMSecsSinceEpoch());
+            const qint64 b = w.end.toMSecsSinceEpoch();
+            if (b - a < kMinBlockMin * kMinMs) continue;
+            windows.push_back({ a, b });
+            s.weekFreeMin[d / 7] += int((b - a) / kMinMs);
+        }
+    }
+
+    const QDate end = s.from.addDays(7 * s.weeks);
+    const Spread pooled = spreads.value(QString());
+    for (const auto& t : tasks) {
+        if (!t.deadline.isValid() || t.estimateMin <= 0 || t.deadline.date() >= end) continue;
+
+        const QString cat = t.notes.contains("::") ? t.notes.section("::", 0, 0).trimmed().toLower() : QString();
+        const int est    = std::max(kMinBlockMin, t.estimateMin);
+        const int chunk  = std::max(kMinBlockMin, t.maxChunkMin);
+
+        Snapshot::Item it;
+        it.title       = t.title;
+        it.deadline    = t.deadline;
+        it.estimateMin = est;
+        it.overheadMin = kPostBufMin * (t.splitOK ? (est + chunk - 1) / chunk : 1);
+        it.spread      = spreads.value(cat, pooled);
+        it.week        = int(std::max<qint64>(0, s.from.daysTo(t.deadline.date())) / 7);
+        const qint64 due = t.deadline.toMSecsSinceEpoch();
+        qint64 cap = 0;
+        for (const auto& w : windows) {
+            if (w.first >= due) break;
+            cap += std::min(w.second, due) - w.first;
+        }
+        it.capBeforeMin = int(cap / kMinMs);
+        s.items.push_back(it);
+    }
+    std::stable_sort(s.items.begin(), s.items.end(), [](const Snapshot::Item& a, const Snapshot::Item& b){
+        return a.deadline < b.deadline;
+    });
+    return s;
+}
+
+// ============================================================================
+// Simulation (workers)
+// ============================================================================
+
+void WorkloadForecast::simulate(const Snapshot& s, const Params& p, int chunk, int runs, Tally& t)
+{
+    const int weeks = s.weeks, n = s.items.size();
+    t.overloads.fill(0, weeks);
+    t.late.fill(0, n);
+    t.due.resize(weeks);
+    for (auto& v : t.due) v.reserve(runs);
+
+    QVector<int> capCum(weeks);
+    for (int w = 0, acc = 0; w < weeks; ++w) capCum[w] = (acc += s.weekFreeMin[w]);
+
+    // One stream per chunk: same answer whichever thread runs it
+    QRandomGenerator rng(p.seed ^ (quint32(chunk) * 0x9E3779B9u));
+    std::normal_distribution<double> z(0.0, 1.0);
+    QVector<int> dueInWeek(weeks);
+
+    for (int r = 0; r < runs; ++r) {
+        dueInWeek.fill(0);
+        int cum = 0;
+        for (int k = 0; k < n; ++k) {
+            const auto& it = s.items[k];
+            const int work = int(std::lround(it.estimateMin * std::exp(it.spread.mu + it.spread.sigma * z(rng))))
+                           + it.overheadMin;
+            cum += work;
+            if (cum > it.capBeforeMin) ++t.late[k];
+            dueInWeek[it.week] += work;
+        }
+        for (int w = 0, acc = 0; w < weeks; ++w) {
+            acc += dueInWeek[w];
+            if (acc > p.overloadAt * capCum[w]) ++t.overloads[w];
+            t.due[w].push_back(acc);
+        }
+    }
+}
+
+static int percentile(QVector<int>& v, double q)
+{
+    if (v.isEmpty()) return 0;
+    const int k = std::min<int>(v.size() - 1, int(q * v.size()));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+WorkloadForecast::Result WorkloadForecast::summarise(const Snapshot& s, const Params& p,
+                                                     const QVector<Tally>& tallies, qint64 elapsedUs)
+{
+    Result res;
+    res.runs      = std::max(0, p.runs);
+    res.elapsedUs = elapsedUs;
+    const double runs = std::max(1, res.runs);
+
+    for (int w = 0; w < s.weeks; ++w) {
+        WeekResult wr;
+        wr.start   = s.from.addDays(7 * w);
+        wr.freeMin = s.weekFreeMin[w];
+        QVector<int> due;
+        due.reserve(res.runs);
+        int over = 0;
+        for (const Tally& t : tallies) { over += t.overloads[w]; due += t.due[w]; }
+        wr.pOverload = over / runs;
+        wr.dueP50Min = percentile(due, 0.5);
+        wr.dueP90Min = percentile(due, 0.9);
+        res.weeks.push_back(wr);
+    }
+    for (int k = 0; k < s.items.size(); ++k) {
+        int late = 0;
+        for (const Tally& t : tallies) late += t.late[k];
+        res.deadlines.push_back({ s.items[k].title, s.items[k].deadline, late / runs });
+    }
+    return res;
+}
+
+int WorkloadForecast::run(QSharedPointer<const Snapshot> snap, const Params& p)
+{
+    const int runId  = ++m_lastRun;
+    const int chunks = std::max(1, (p.runs + kChunkRuns - 1) / kChunkRuns);
+
+    struct Run { QVector<Tally> tallies; Result result; QElapsedTimer timer; };
+    auto run = QSharedPointer<Run>::create();
+    run->tallies.resize(chunks);
+    run->timer.start();
+    Tally* tally = run->tallies.data();   // detached once here; chunks write disjoint entries
+
+    JobScheduler::Options co;
+    co.token = m_cancel;
+    JobScheduler::Options mo;
+    mo.token = m_cancel;
+    for (int c = 0; c < chunks; ++c) {
+        const int runs = std::min(kChunkRuns, p.runs - c * kChunkRuns);
+        mo.after.push_back(m_jobs->submit(JobScheduler::Priority::Batch,
+                                          [tally, run, snap, p, c, runs](const JobScheduler::CancelToken&) {
+            simulate(*snap, p, c, std::max(0, runs), tally[c]);
+            return QVariant();
+        }, co));
+    }
+
+    mo.context = this;
+    mo.done    = [this, run, runId](const QVariant&) {
+        emit finished(runId, run->result);
+    };
+    m_jobs->submit(JobScheduler::Priority::Batch, [run, snap, p](const JobScheduler::CancelToken&) {
+        run->result = summarise(*snap, p, run->tallies, run->timer.nsecsElapsed() / 1000);
+        return QVariant();
+    }, mo);
+    return runId;
+}
+
+WorkloadForecast::Result WorkloadForecast::runBlocking(const Snapshot& snap, const Params& p)
+{
+    QElapsedTimer timer; timer.start();
+    const int chunks = std::max(1, (p.runs + kChunkRuns - 1) / kChunkRuns);
+    QVector<Tally> tallies(chunks);
+    for (int c = 0; c < chunks; ++c)
+        simulate(snap, p, c, std::max(0, std::min(kChunkRuns, p.runs - c * kChunkRuns)), tallies[c]);
+    return summarise(snap, p, tallies, timer.nsecsElapsed() / 1000);
+}
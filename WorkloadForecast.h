@@ -0,0 +1,127 @@
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include "Event.h"
+#include "EventIndex.h"
+#include "JobScheduler.h"
+#include "SuperAI.h"
+
+class TimeTracker;
+
+/**
+ * @brief WorkloadForecast
+ * Monte Carlo forecast of the task pool over the coming weeks: how likely
+ * each week is to be overloaded and each deadline to be missed, given that
+ * real effort differs from the estimates.
+ *
+ * Model
+ *  - Effort = estimate × exp(N(mu, sigma)) with (mu, sigma) per category,
+ *    learned from tracked vs planned minutes (learn()). Categories without
+ *    enough history use the pooled spread. A task's category is the text
+ *    before "::" in its notes, the same convention as Event::category().
+ *  - Supply is the planner's free time (SuperAI::freeWindows) from now on,
+ *    fixed for the whole run.
+ *  - Each run works tasks earliest-deadline-first, as DeadlineChecker does:
+ *    a task is late when the work due up to and including it exceeds the
+ *    free time before its deadline. A week is overloaded when the work due
+ *    by its end needs more than overloadAt of the free time up to then.
+ *
+ * Threading
+ *  - snapshot() is taken on the GUI thread and shared read-only by every
+ *    worker. Runs are split into fixed-size chunks, and each chunk has its
+ *    own RNG seeded from (seed, chunk). Results therefore do not depend on
+ *    the thread count, and the work scales with cores.
+ *  - Chunks are Batch jobs on the shared JobScheduler; a merge job runs
+ *    after all of them and finished() is delivered on the forecast's thread.
+ */
+class WorkloadForecast : public QObject {
+    Q_OBJECT
+public:
+    /// log(actual / planned) ~ N(mu, sigma)
+    struct Spread { double mu = 0.0; double sigma = 0.25; int samples = 0; };
+    using Spreads = QHash<QString, Spread>;   ///< key: lower-case category; "" = all history
+
+    struct Params {
+        QDateTime now;                 ///< start of the horizon
+        int       weeks      = 8;
+        int       runs       = 4000;
+        double    overloadAt = 0.85;   ///< share of free time that counts as overload
+        quint32   seed       = 1;
+    };
+
+    /// Immutable inputs shared by all runs.
+    struct Snapshot {
+        struct Item {
+            QString   title;
+            QDateTime deadline;
+            int       estimateMin = 0;
+            int       overheadMin = 0;   ///< planner buffers, not subject to the spread
+            Spread    spread;
+            int       capBeforeMin = 0;  ///< free minutes between now and the deadline
+            int       week = 0;          ///< horizon week the deadline falls in
+        };
+        QDate         from;              ///< first day (now.date())
+        int           weeks = 0;
+        QVector<int>  weekFreeMin;       ///< free minutes per week
+        QVector<Item> items;             ///< by deadline
+    };
+
+    struct WeekResult {
+        QDate  start;
+        int    freeMin       = 0;
+        double pOverload     = 0;
+        int    dueP50Min     = 0;      ///< work due by week end (cumulative), median
+        int    dueP90Min     = 0;
+    };
+    struct DeadlineResult {
+        QString   title;
+        QDateTime deadline;
+        double    pLate = 0;
+    };
+    struct Result {
+        QVector<WeekResult>     weeks;
+        QVector<DeadlineResult> deadlines;
+        int                     runs = 0;
+        qint64                  elapsedUs = 0;
+    };
+
+    static constexpr int kChunkRuns = 250;   ///< runs per task (and per RNG stream)
+
+    explicit WorkloadForecast(JobScheduler* jobs, QObject* parent = nullptr);
+    ~WorkloadForecast() override;
+
+    /// Per-category spreads from tracked sessions of events in [from, to].
+    static Spreads learn(const QVector<Event>& events, const EventIndex& index,
+                         const TimeTracker& tracker, const QDate& from, const QDate& to);
+
+    /// Free time and due tasks for the horizon (GUI thread; reads the calendar once).
+    static Snapshot snapshot(const SuperAI& planner, const QVector<Event>& events,
+                             const EventIndex& index, const QVector<SuperAI::Task>& tasks,
+                             const Spreads& spreads, const Params& p);
+
+    /// Queue p.runs simulations; finished() carries the returned id.
+    int run(QSharedPointer<const Snapshot> snap, const Params& p);
+
+    /// Same, on the calling thread (tools).
+    static Result runBlocking(const Snapshot& snap, const Params& p);
+
+signals:
+    void finished(int runId, const WorkloadForecast::Result& result);
+
+private:
+    struct Tally;
+    static void simulate(const Snapshot& s, const Params& p, int chunk, int runs, Tally& t);
+    static Result summarise(const Snapshot& s, const Params& p, const QVector<Tally>& tallies,
+                            qint64 elapsedUs);
+
+    JobScheduler*             m_jobs = nullptr;
+    JobScheduler::CancelToken m_cancel;   // cancelled on destruction
+    int                       m_lastRun = 0;
+};
@@ -10,6 +10,7 @@
 #include <QThread>
 #include <QFuture>
 #include <QSettings> 
+#include <memory>
 // #include <QtConcurrent>
 // #include <QOpenGLWidget>
 // #include <QOpenGLFunctions>
@@ -26,6 +27,8 @@
 // #include <QOpenGLTimerQuery>
 // #include <QOpenGLTimeMonitor>
  #include "UltraMainWindow.h"
+ #include "CalendarStore.h"
+ #include "UiRecorder.h"
 
 int main(int argc, char** argv) {
 QApplication app(argc, argv);
@@ -67,14 +70,16 @@ QApplication app(argc, argv);
    
     
 
-    UltraMainWindow window;       // variable name is 'window'
+    CalendarStore store;          // events, caches and planner shared by every window
+    UltraMainWindow window(&store);       // variable name is 'window'
     window.show();
 
-    auto* backgroundTimer = new QTimer(&window);
-    QObject::connect(backgroundTimer, &QTimer::timeout, [&window]() {
-        // window.updateAdvancedFeatures();
-    });
-    backgroundTimer->start(1000);
+    // --record-ui <file>: log input for tools/ui_replay (latency regression runs)
+    std::unique_ptr<UiRecorder> uiRecorder;
+    const QStringList args = app.arguments();
+    const int rec = args.indexOf("--record-ui");
+    if (rec > 0 && rec + 1 < args.size())
+        uiRecorder = std::make_unique<UiRecorder>(args[rec + 1], &window, store.events());
 
     
     return app.exec();
@@ -0,0 +1,133 @@
+// bench_columns.cpp
+// Compares the object-array path (QVector<Event>) with EventColumns kernels
+// (scalar and best SIMD) on synthetic calendars.
+//
+//   edusync_bench_columns [events=200000] [repeats=7]
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QRandomGenerator>
+#include <QTextStream>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "Event.h"
+#include "EventColumns.h"
+
+static QTextStream out(stdout);
+
+static QVector<Event> makeEvents(int n, const QDate& first)
+{
+    static const char* kCats[] = { "Study", "Work", "Break", "Exercise", "Personal", "Meeting" };
+    QRandomGenerator rng(42);
+    QVector<Event> evs;
+    evs.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const QDate d = first.addDays(rng.bounded(3 * 365));
+        const QDateTime s(d, QTime(rng.bounded(6, 21), 15 * rng.bounded(4)));
+        const QDateTime e = s.addSecs(60 * (15 + 15 * rng.bounded(12)));
+        const QString cat = kCats[rng.bounded(6)];
+        evs.push_back(Event(cat == "Meeting" ? "Team Meeting" : "Block " + QString::number(i),
+                            cat + "::notes", s, e, Qt::gray));
+    }
+    return evs;
+}
+
+// Best-of-N wall time in microseconds
+static double timeIt(int repeats, const std::function<void()>& fn)
+{
+    qint64 best = std::numeric_limits<qint64>::max();
+    for (int r = 0; r < repeats; ++r) {
+        QElapsedTimer t; t.start();
+        fn();
+        best = std::min(best, t.nsecsElapsed());
+    }
+    return best / 1000.0;
+}
+
+static void report(const char* what, double objUs, double scalarUs, double simdUs, bool same)
+{
+    out << QString("%1  object %2 us | scalar %3 us (%4x) | simd %5 us (%6x)%7\n")
+           .arg(what, -22)
+           .arg(objUs, 9, 'f', 1)
+           .arg(scalarUs, 9, 'f', 1).arg(objUs / scalarUs, 5, 'f', 1)
+           .arg(simdUs, 9, 'f', 1).arg(objUs / simdUs, 5, 'f', 1)
+           .arg(same ? "" : "   MISMATCH");
+    out.flush();
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    const int n       = args.size() > 1 ? args[1].toInt() : 200000;
+    const int repeats = args.size() > 2 ? args[2].toInt() : 7;
+
+    const QDate first(2024, 1, 1);
+    const QVector<Event> evs = makeEvents(n, first);
+
+    EventColumns scalar, simd;
+    const double buildUs = timeIt(1, [&]{ scalar.rebuild(evs); });
+    simd.rebuild(evs);
+    scalar.setIsa(ColumnKernels::Isa::Scalar);
+
+    out << "events: " << n << "  snapshot build: " << buildUs / 1000.0 << " ms  simd: "
+        << ColumnKernels::isaName(ColumnKernels::bestIsa()) << "\n";
+
+    const QDateTime a(first.addDays(200), QTime(0, 0));
+    const QDateTime b(first.addDays(290), QTime(0, 0));
+
+    // --- overlapping [a, b) -------------------------------------------------
+    {
+        QVector<int> o, s, v;
+        const double t0 = timeIt(repeats, [&]{
+            o.clear();
+            for (int i = 0; i < evs.size(); ++i)
+                if (evs[i].getStartTime() < b && evs[i].getEndTime() > a) o.push_back(i);
+        });
+        const double t1 = timeIt(repeats, [&]{ s = scalar.overlapping(a, b); });
+        const double t2 = timeIt(repeats, [&]{ v = simd.overlapping(a, b); });
+        report("overlap [a,b)", t0, t1, t2, o == s && o == v);
+    }
+
+    // --- minutes per category in [a, b) ------------------------------------
+    {
+        QHash<QString, qint64> o;
+        QVector<qint64> s, v;
+        const double t0 = timeIt(repeats, [&]{
+            o.clear();
+            for (const Event& e : evs) {
+                const qint64 d = std::min(e.getEndTime(), b).toSecsSinceEpoch()
+                               - std::max(e.getStartTime(), a).toSecsSinceEpoch();
+                if (d <= 0) continue;
+                o[e.category().trimmed().toLower()] += d;
+            }
+        });
+        const double t1 = timeIt(repeats, [&]{ s = scalar.minutesPerCategory(a, b); });
+        const double t2 = timeIt(repeats, [&]{ v = simd.minutesPerCategory(a, b); });
+        bool same = (s == v);
+        for (int c = 0; c < s.size(); ++c) same = same && o.value(simd.categoryNames()[c]) / 60 == s[c];
+        report("minutes per category", t0, t1, t2, same);
+    }
+
+    // --- count per day over a year -----------------------------------------
+    {
+        const int days = 366;
+        QVector<int> o, s, v;
+        const double t0 = timeIt(repeats, [&]{
+            o.fill(0, days);
+            for (const Event& e : evs) {
+                const qint64 d0 = std::max<qint64>(0,        first.daysTo(e.getStartTime().date()));
+                const qint64 d1 = std::min<qint64>(days - 1, first.daysTo(e.getEndTime().date()));
+                for (qint64 d = d0; d <= d1; ++d) ++o[int(d)];
+            }
+        });
+        const double t1 = timeIt(repeats, [&]{ s = scalar.countPerDay(first, days); });
+        const double t2 = timeIt(repeats, [&]{ v = simd.countPerDay(first, days); });
+        report("count per day", t0, t1, t2, o == s && o == v);
+    }
+    return 0;
+}
@@ -0,0 +1,236 @@
+// diff_harness.cpp
+// Randomized differential check of optimised planner/dashboard kernels against
+// the preserved reference versions (PlannerReference). Mismatching cases are
+// shrunk to a minimal input before they are printed; timings for both sides
+// are summed over all cases so each optimisation comes with a speedup number.
+//
+//   edusync_diff_harness [--iters N] [--seed S] [--kernel NAME]
+//   NAME: freeWindows | slotScore | schedule | dayStats | all (default)
+//
+// Exit status: 0 = no mismatches, 1 = mismatches found.
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+
+#include <cmath>
+#include <functional>
+
+#include "PlannerReference.h"
+#include "SuperAI.h"
+#include "UltraDashboardRender.h"
+
+static QTextStream out(stdout);
+
+// ---- random cases ------------------------------------------------------------
+
+struct Case {
+    QDate                  day;
+    QDateTime              now;
+    QVector<Event>         events;
+    QVector<SuperAI::Task> tasks;
+};
+
+static Case makeCase(QRandomGenerator& rng)
+{
+    static const char* kTitles[] = { "Lecture", "Team Meeting", "Standup", "Gym", "Lunch",
+                                     "Code review", "Reading", "1:1", "Lab", "Sync" };
+    static const char* kCats[]   = { "Study", "Work", "Break", "Exercise", "Personal", "" };
+
+    Case c;
+    c.day = QDate(2025, 1, 1).addDays(rng.bounded(365));
+    c.now = QDateTime(c.day.addDays(-rng.bounded(3)), QTime(rng.bounded(24), rng.bounded(60)));
+
+    const QDateTime midnight(c.day, QTime(0, 0));
+    const int nEv = rng.bounded(25);
+    for (int i = 0; i < nEv; ++i) {
+        QDateTime s = midnight.addSecs(60 * (rng.bounded(54 * 60) - 24 * 60));   // -24h .. +30h
+        if (rng.bounded(4) == 0) s = s.addMSecs(rng.bounded(60000));              // off-minute
+        const QDateTime e = s.addSecs(60 * rng.bounded(300));
+        const QString cat = kCats[rng.bounded(6)];
+        const QString desc = rng.bounded(2) ? cat + "::note " + QString::number(i) : cat;
+        c.events.push_back(Event(kTitles[rng.bounded(10)], desc, s, e, Qt::gray));
+    }
+
+    const int nTasks = rng.bounded(8);
+    for (int i = 0; i < nTasks; ++i) {
+        SuperAI::Task t;
+        t.title         = QString("T%1").arg(i);
+        t.estimateMin   = 10 + rng.bounded(230);
+        t.priority      = 1 + rng.bounded(5);
+        if (rng.bounded(2)) t.deadline = c.now.addSecs(3600 * (rng.bounded(24 * 10) - 24));
+        t.mustMorning   = rng.bounded(4) == 0;
+        t.mustAfternoon = rng.bounded(4) == 0;
+        t.splitOK       = rng.bounded(3) != 0;
+        t.maxChunkMin   = 30 * (1 + rng.bounded(4));
+        c.tasks.push_back(t);
+    }
+    return c;
+}
+
+static QString describe(const Case& c)
+{
+    QString s;
+    QTextStream ts(&s);
+    ts << "    day " << c.day.toString(Qt::ISODate) << "  now " << c.now.toString(Qt::ISODateWithMs) << "\n";
+    for (const Event& e : c.events)
+        ts << "    event  " << e.getTitle() << " [" << e.getDescription() << "] "
+           << e.getStartTime().toString(Qt::ISODateWithMs) << " → " << e.getEndTime().toString(Qt::ISODateWithMs) << "\n";
+    for (const auto& t : c.tasks)
+        ts << "    task   " << t.title << " est=" << t.estimateMin << " pr=" << t.priority
+           << " dl=" << (t.deadline.isValid() ? t.deadline.toString(Qt::ISODate) : "-")
+           << " am=" << t.mustMorning << " pm=" << t.mustAfternoon
+           << " split=" << t.splitOK << " chunk=" << t.maxChunkMin << "\n";
+    return s;
+}
+
+// Greedily drop events, then tasks, while the case still mismatches
+static Case minimise(Case c, const std::function<bool(const Case&)>& mismatch)
+{
+    for (bool shrunk = true; shrunk; ) {
+        shrunk = false;
+        for (int i = 0; i < c.events.size(); ++i) {
+            Case t = c; t.events.removeAt(i);
+            if (mismatch(t)) { c = t; shrunk = true; --i; }
+        }
+        for (int i = 0; i < c.tasks.size(); ++i) {
+            Case t = c; t.tasks.removeAt(i);
+            if (mismatch(t)) { c = t; shrunk = true; --i; }
+        }
+    }
+    return c;
+}
+
+// ---- comparisons ----------------------------------------------------------------
+
+static bool sameSlots(const QVector<SuperAI::Slot>& a, const QVector<SuperAI::Slot>& b)
+{
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i)
+        if (a[i].start != b[i].start || a[i].end != b[i].end) return false;
+    return true;
+}
+
+static bool sameEvents(const QVector<Event>& a, const QVector<Event>& b)
+{
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i)
+        if (a[i].getTitle() != b[i].getTitle() || a[i].getDescription() != b[i].getDescription()
+            || a[i].getStartTime() != b[i].getStartTime() || a[i].getEndTime() != b[i].getEndTime()
+            || a[i].getColor() != b[i].getColor())
+            return false;
+    return true;
+}
+
+static QString flatten(const DayStats& s)
+{
+    QStringList f;
+    f << s.dateLabel << QString::number(s.sessions) << QString::number(s.meetings)
+      << QString::number(s.defense) << QString::number(s.focusOn) << QString::number(s.breaksMin)
+      << QString::number(s.exerciseMin) << QString::number(s.freeMin) << QString::number(s.loadMin)
+      << QString::number(s.fragmentation) << QString::number(s.contextSwitches)
+      << QString::number(s.balancePercent) << QString::number(s.riskPercent) << s.riskLabel
+      << s.firstStart << s.lastEnd << s.longestFocus << s.smartMoves;
+    for (const auto& b : s.timeMap) f << b.label << b.value << QString::number(b.percent);
+    return f.join('|');
+}
+
+// ---- kernels under test ------------------------------------------------------
+
+struct Kernel {
+    const char* name;
+    // Runs both sides, adds their times, returns true when outputs match
+    std::function<bool(const Case&, qint64& refNs, qint64& optNs)> run;
+    int     cases = 0, mismatches = 0;
+    qint64  refNs = 0, optNs = 0;
+};
+
+template <typename F>
+static auto timed(qint64& acc, F&& f)
+{
+    QElapsedTimer t; t.start();
+    auto r = f();
+    acc += t.nsecsElapsed();
+    return r;
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    int     iters = 2000;
+    quint32 seed  = 1;
+    QString only  = "all";
+    for (int i = 1; i + 1 < args.size(); ++i) {
+        if      (args[i] == "--iters")  iters = args[++i].toInt();
+        else if (args[i] == "--seed")   seed  = args[++i].toUInt();
+        else if (args[i] == "--kernel") only  = args[++i];
+    }
+
+    SuperAI ai;
+    auto withClock = [&ai](const Case& c) { const QDateTime now = c.now; ai.setClock([now]{ return now; }); };
+
+    QVector<Kernel> kernels = {
+        { "freeWindows", [&](const Case& c, qint64& r, qint64& o) {
+              const auto ref = timed(r, [&]{ return PlannerReference::freeWindows(c.day, c.events); });
+              const auto opt = timed(o, [&]{ return ai.freeWindows(c.day, c.events); });
+              return sameSlots(ref, opt);
+          } },
+        { "slotScore", [&](const Case& c, qint64& r, qint64& o) {
+              withClock(c);
+              const auto windows = PlannerReference::freeWindows(c.day, c.events, 0);
+              bool same = true;
+              for (const auto& w : windows)
+                  for (const auto& t : c.tasks) {
+                      const double a = timed(r, [&]{ return PlannerReference::slotScore(w, t, c.now); });
+                      const double b = timed(o, [&]{ return ai.slotScore(w, t); });
+                      same = same && (a == b || std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(a)));
+                  }
+              return same;
+          } },
+        { "schedule", [&](const Case& c, qint64& r, qint64& o) {
+              withClock(c);
+              const auto windows = PlannerReference::freeWindows(c.day, c.events);
+              const auto ref = timed(r, [&]{ return PlannerReference::scheduleTasksIntoWindows(windows, c.tasks, c.now); });
+              const auto opt = timed(o, [&]{ return ai.scheduleTasksIntoWindows(c.day, windows, c.tasks); });
+              return sameEvents(ref, opt);
+          } },
+        { "dayStats", [&](const Case& c, qint64& r, qint64& o) {
+              const auto ref = timed(r, [&]{ return flatten(PlannerReference::dayStats(c.events, c.day)); });
+              const auto opt = timed(o, [&]{ return flatten(computeDayStats(c.events, c.day)); });
+              return ref == opt;
+          } },
+    };
+
+    QRandomGenerator rng(seed);
+    for (int it = 0; it < iters; ++it) {
+        const Case c = makeCase(rng);
+        for (Kernel& k : kernels) {
+            if (only != "all" && only != k.name) continue;
+            ++k.cases;
+            if (k.run(c, k.refNs, k.optNs)) continue;
+
+            if (++k.mismatches <= 3) {
+                qint64 dummy = 0;
+                const Case m = minimise(c, [&](const Case& t){ return !k.run(t, dummy, dummy); });
+                out << "MISMATCH " << k.name << " (iteration " << it << ", seed " << seed << ")\n"
+                    << describe(m);
+                out.flush();
+            }
+        }
+    }
+
+    int failures = 0;
+    out << QString("\n%1 %2 %3 %4 %5 %6\n").arg("kernel", -12).arg("cases", 7).arg("diff", 6)
+                                           .arg("ref ms", 10).arg("opt ms", 10).arg("speedup", 8);
+    for (const Kernel& k : kernels) {
+        if (!k.cases) continue;
+        failures += k.mismatches;
+        out << QString("%1 %2 %3 %4 %5 %6x\n").arg(k.name, -12).arg(k.cases, 7).arg(k.mismatches, 6)
+               .arg(k.refNs / 1e6, 10, 'f', 2).arg(k.optNs / 1e6, 10, 'f', 2)
+               .arg(k.optNs ? double(k.refNs) / k.optNs : 0.0, 7, 'f', 2);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,99 @@
+// planner_replay.cpp
+// Re-runs recorded SuperAI::planDay() sessions (see PlannerRecorder) with the
+// recorded clock and inputs, then reports timing and plan differences.
+//
+//   edusync_planner_replay <recording.eplr> [--repeat N] [--quiet]
+//
+// Exit status: 0 = every plan identical, 1 = some plan differs, 2 = bad input.
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QTextStream>
+
+#include <algorithm>
+#include <limits>
+
+#include "PlannerRecorder.h"
+#include "SuperAI.h"
+
+static QTextStream out(stdout);
+
+static QString blockKey(const Event& e)
+{
+    return QString("%1  %2–%3").arg(e.getTitle(),
+                                    e.getStartTime().toString("hh:mm"),
+                                    e.getEndTime().toString("hh:mm"));
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    QString path;
+    int  repeat = 5;
+    bool quiet  = false;
+    for (int i = 1; i < args.size(); ++i) {
+        if (args[i] == "--repeat" && i + 1 < args.size()) repeat = std::max(1, args[++i].toInt());
+        else if (args[i] == "--quiet")                     quiet  = true;
+        else                                               path   = args[i];
+    }
+    if (path.isEmpty()) {
+        out << "usage: edusync_planner_replay <recording.eplr> [--repeat N] [--quiet]\n";
+        return 2;
+    }
+
+    QString error;
+    const auto sessions = PlannerRecorder::load(path, &error);
+    if (!error.isEmpty()) { out << path << ": " << error << "\n"; return 2; }
+
+    int    differing = 0;
+    double recTotal  = 0, nowTotal = 0;
+
+    for (int i = 0; i < sessions.size(); ++i) {
+        const auto& s = sessions[i];
+
+        SuperAI ai;
+        const QDateTime now = s.now;
+        ai.setClock([now]{ return now; });
+        if (s.settings.contains("weights"))
+            ai.setWeights(PlannerWeights::fromMap(s.settings.value("weights").toMap()));
+
+        QVector<Event> plan;
+        qint64 best = std::numeric_limits<qint64>::max();
+        for (int r = 0; r < repeat; ++r) {
+            QElapsedTimer t; t.start();
+            plan = ai.planDay(s.day, s.existing, s.tasks, s.habits);
+            best = std::min(best, t.nsecsElapsed());
+        }
+
+        QStringList recorded, replayed;
+        for (const Event& e : s.output) recorded << blockKey(e);
+        for (const Event& e : plan)     replayed << blockKey(e);
+        const bool same = (recorded == replayed);
+        if (!same) ++differing;
+
+        recTotal += s.elapsedNs / 1000.0;
+        nowTotal += best / 1000.0;
+
+        out << QString("#%1 %2  ev:%3 tasks:%4 habits:%5  recorded %6 us  replay %7 us  %8\n")
+               .arg(i, 4).arg(s.day.toString(Qt::ISODate))
+               .arg(s.existing.size()).arg(s.tasks.size()).arg(s.habits.size())
+               .arg(s.elapsedNs / 1000.0, 9, 'f', 1).arg(best / 1000.0, 9, 'f', 1)
+               .arg(same ? "same" : "DIFF");
+
+        if (!same && !quiet) {
+            const QSet<QString> a(recorded.cbegin(), recorded.cend());
+            const QSet<QString> b(replayed.cbegin(), replayed.cend());
+            for (const QString& k : recorded) if (!b.contains(k)) out << "      - " << k << "\n";
+            for (const QString& k : replayed) if (!a.contains(k)) out << "      + " << k << "\n";
+            if (a == b) out << "      (same blocks, different order)\n";
+        }
+    }
+
+    out << QString("\n%1 session(s), %2 differing  |  recorded %3 ms  replay %4 ms\n")
+           .arg(sessions.size()).arg(differing)
+           .arg(recTotal / 1000.0, 0, 'f', 2).arg(nowTotal / 1000.0, 0, 'f', 2);
+    return differing ? 1 : 0;
+}
@@ -0,0 +1,187 @@
+// planner_tune.cpp
+// Searches PlannerWeights against recorded planning sessions (PlannerRecorder)
+// and writes the best profile as an INI file that the app loads at startup
+// (<AppData>/planner-weights.ini).
+//
+//   edusync_planner_tune <recording.eplr>... [--out FILE] [--gens N] [--seed S] [--threads T]
+//
+// Ground truth: the planner blocks ("🔵 task" / "🟢 habit") the user accepted
+// into the calendar for a planned day, as last committed after the session
+// (PlannerRecorder committed records; accept a plan with the "Accept" button).
+// A candidate's score is the share of kept minutes its replayed plan puts at
+// the same title and time, averaged over sessions that have any kept block.
+//
+// Candidates of a generation are evaluated in parallel, one SuperAI per
+// worker thread. The search is a (1+λ) evolution strategy with multiplicative
+// log-normal steps; it is deterministic for a given seed and input.
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "PlannerRecorder.h"
+#include "PlannerWeights.h"
+#include "SuperAI.h"
+
+static QTextStream out(stdout);
+
+struct Sample {
+    PlannerRecorder::Session session;
+    QVector<Event>           kept;        ///< planner blocks the user kept
+    qint64                   keptMin = 0;
+};
+
+// Pair each session with the blocks last committed for its day after it.
+// Sessions nobody accepted a plan for carry no signal.
+static QVector<Sample> buildSamples(const QVector<PlannerRecorder::Session>& sessions,
+                                    const QVector<PlannerRecorder::Committed>& committed)
+{
+    QVector<Sample> samples;
+    for (int i = 0; i < sessions.size(); ++i) {
+        const auto& s = sessions[i];
+        const PlannerRecorder::Committed* last = nullptr;
+        for (const auto& c : committed)
+            if (c.day == s.day && c.afterSession > i) last = &c;
+        if (!last) continue;
+
+        Sample smp;
+        smp.session = s;
+        for (const Event& e : last->blocks) {
+            if (!PlannerRecorder::isPlannerBlock(e) || e.getStartTime().date() != s.day) continue;
+            smp.kept.push_back(e);
+            smp.keptMin += std::max<qint64>(0, e.getStartTime().secsTo(e.getEndTime()) / 60);
+        }
+        if (smp.keptMin > 0) samples.push_back(smp);
+    }
+    return samples;
+}
+
+// Share (0..1) of kept minutes reproduced by @plan
+static double agreement(const Sample& smp, const QVector<Event>& plan)
+{
+    qint64 hit = 0;
+    for (const Event& k : smp.kept)
+        for (const Event& p : plan) {
+            if (p.getTitle() != k.getTitle()) continue;
+            const QDateTime a = std::max(k.getStartTime(), p.getStartTime());
+            const QDateTime b = std::min(k.getEndTime(),   p.getEndTime());
+            if (a < b) hit += a.secsTo(b) / 60;
+        }
+    return std::min(1.0, double(hit) / double(smp.keptMin));
+}
+
+static double evaluate(SuperAI& ai, const PlannerWeights& w, const QVector<Sample>& samples)
+{
+    ai.setWeights(w);
+    double sum = 0;
+    for (const Sample& smp : samples) {
+        const auto& s = smp.session;
+        const QDateTime now = s.now;
+        ai.setClock([now]{ return now; });
+        sum += agreement(smp, ai.planDay(s.day, s.existing, s.tasks, s.habits));
+    }
+    return samples.isEmpty() ? 0.0 : sum / samples.size();
+}
+
+// Score every candidate on @threads workers; each worker owns its SuperAI
+static QVector<double> evaluateAll(const QVector<PlannerWeights>& cands,
+                                   const QVector<Sample>& samples, int threads)
+{
+    QVector<double> scores(cands.size(), 0.0);
+    std::atomic<int> next{0};
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.emplace_back([&]{
+            SuperAI ai;
+            for (int i = next++; i < cands.size(); i = next++)
+                scores[i] = evaluate(ai, cands[i], samples);
+        });
+    for (auto& th : pool) th.join();
+    return scores;
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    QStringList inputs;
+    QString outPath = "planner-weights.ini";
+    int     gens    = 30;
+    quint32 seed    = 1;
+    int     threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < args.size(); ++i) {
+        if      (args[i] == "--out"     && i + 1 < args.size()) outPath = args[++i];
+        else if (args[i] == "--gens"    && i + 1 < args.size()) gens    = std::max(1, args[++i].toInt());
+        else if (args[i] == "--seed"    && i + 1 < args.size()) seed    = args[++i].toUInt();
+        else if (args[i] == "--threads" && i + 1 < args.size()) threads = std::max(1, args[++i].toInt());
+        else                                                    inputs << args[i];
+    }
+    if (inputs.isEmpty()) {
+        out << "usage: edusync_planner_tune <recording.eplr>... [--out FILE] [--gens N] [--seed S] [--threads T]\n";
+        return 2;
+    }
+
+    QVector<PlannerRecorder::Session> sessions;
+    QVector<PlannerRecorder::Committed> committed;
+    for (const QString& path : inputs) {
+        QString error;
+        QVector<PlannerRecorder::Committed> fileCommitted;
+        const auto loaded = PlannerRecorder::load(path, &error, &fileCommitted);
+        if (!error.isEmpty()) { out << path << ": " << error << "\n"; return 2; }
+        for (auto& c : fileCommitted) c.afterSession += sessions.size();   // files are concatenated
+        committed += fileCommitted;
+        sessions  += loaded;
+    }
+    const QVector<Sample> samples = buildSamples(sessions, committed);
+    out << sessions.size() << " session(s), " << samples.size() << " with kept blocks, "
+        << threads << " thread(s)\n";
+    if (samples.isEmpty()) { out << "nothing to tune against\n"; return 2; }
+
+    QElapsedTimer timer; timer.start();
+    PlannerWeights best;
+    double bestScore = evaluateAll({ best }, samples, 1).first();
+    const double baseScore = bestScore;
+    out << QString("defaults  %1\n").arg(baseScore, 0, 'f', 4);
+
+    const int lambda = threads * 4;
+    double sigma = 0.35;
+    for (int g = 0; g < gens; ++g) {
+        QRandomGenerator rng(seed * 7919u + quint32(g));
+        QVector<PlannerWeights> cands(lambda, best);
+        for (PlannerWeights& c : cands)
+            for (int k = 0; k < PlannerWeights::kCount; ++k) {
+                // Box–Muller normal step, applied multiplicatively (keeps signs)
+                const double u1 = std::max(1e-12, rng.generateDouble()), u2 = rng.generateDouble();
+                const double z  = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+                c[k] *= std::exp(sigma * z);
+            }
+
+        const QVector<double> scores = evaluateAll(cands, samples, threads);
+        const int top = int(std::max_element(scores.cbegin(), scores.cend()) - scores.cbegin());
+        if (scores[top] > bestScore) { best = cands[top]; bestScore = scores[top]; }
+        else                         sigma *= 0.85;
+
+        out << QString("gen %1  best %2  sigma %3\n").arg(g, 3).arg(bestScore, 0, 'f', 4).arg(sigma, 0, 'f', 3);
+        out.flush();
+    }
+
+    const PlannerWeights defaults;
+    out << QString("\n%1 %2 %3\n").arg("weight", -16).arg("default", 9).arg("tuned", 9);
+    for (int k = 0; k < PlannerWeights::kCount; ++k)
+        out << QString("%1 %2 %3\n").arg(PlannerWeights::name(k), -16)
+               .arg(defaults[k], 9, 'f', 3).arg(best[k], 9, 'f', 3);
+    out << QString("\nagreement %1 → %2 in %3 s\n").arg(baseScore, 0, 'f', 4).arg(bestScore, 0, 'f', 4)
+           .arg(timer.elapsed() / 1000.0, 0, 'f', 1);
+
+    if (!best.save(outPath)) { out << outPath << ": write failed\n"; return 2; }
+    out << "wrote " << outPath << "\n";
+    return 0;
+}
@@ -0,0 +1,274 @@
+// ui_replay.cpp
+// Replays a recorded UI session (see UiRecorder; record with
+// `EduSync --record-ui session.jsonl`) against a fresh UltraMainWindow, headless
+// on the offscreen platform, and reports how long each action takes from its
+// last input to a settled UI: day details done and the dashboard rendered
+// (UltraMainWindow::isSettled()). Think time between actions is not replayed;
+// input within an action (held keys) keeps its recorded spacing.
+//
+//   edusync_ui_replay <session.jsonl> [--repeat N] [--timeout MS] [--json out.json]
+//                     [--baseline old.json] [--tolerance X] [--floor MS]
+//
+// An action's latency is its median over the repeats. With --baseline, a label
+// whose p50 or p90 grew by more than X times (default 1.25) and by more than
+// the floor (default 5 ms) is a regression.
+//
+// Exit status: 0 = ok, 1 = regression or an action never settled, 2 = bad input.
+
+#include <QApplication>
+#include <QCalendarWidget>
+#include <QDialog>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QKeyEvent>
+#include <QMap>
+#include <QMouseEvent>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <QTimer>
+
+#include <algorithm>
+#include <cmath>
+
+#include "CalendarStore.h"
+#include "UiRecorder.h"
+#include "UltraMainWindow.h"
+
+static QTextStream out(stdout);
+
+static constexpr int kMaxGapMs = 250;   // longest pause replayed inside one action
+
+struct Action {
+    int     first = 0, last = 0;        // input range
+    QString label;
+};
+
+static QVector<Action> actionsOf(const UiRecorder::Session& s)
+{
+    QVector<Action> acts;
+    for (int i = 0; i < s.inputs.size(); ++i) {
+        if (acts.isEmpty() || s.inputs[i].action != s.inputs[acts.last().first].action)
+            acts.push_back({ i, i, s.inputs[i].label });
+        acts.last().last = i;
+    }
+    return acts;
+}
+
+static void post(const UiRecorder::Input& in, QWidget* w)
+{
+    const auto mods = Qt::KeyboardModifiers::fromInt(in.mods);
+    if (in.type == "keydown" || in.type == "keyup") {
+        if (!w->hasFocus()) w->setFocus(Qt::OtherFocusReason);
+        QCoreApplication::postEvent(w, new QKeyEvent(in.type == "keydown" ? QEvent::KeyPress : QEvent::KeyRelease,
+                                                     in.key, mods, in.text, in.repeat));
+        return;
+    }
+    const QEvent::Type type = in.type == "press"   ? QEvent::MouseButtonPress
+                            : in.type == "release" ? QEvent::MouseButtonRelease
+                                                   : QEvent::MouseButtonDblClick;
+    const QPointF local(in.pos);
+    QCoreApplication::postEvent(w, new QMouseEvent(type, local, w->mapTo(w->window(), local), w->mapToGlobal(local),
+                                                   Qt::MouseButton(in.button),
+                                                   Qt::MouseButtons::fromInt(in.buttons), mods));
+}
+
+/**
+ * One pass over the session in a fresh store and window. Returns ms per
+ * action; -1 = never settled within @timeoutMs, NaN = its widget was missing.
+ */
+static QVector<double> replayOnce(const UiRecorder::Session& s, const QVector<Action>& acts, int timeoutMs)
+{
+    // Archive, tracking file etc. start empty every time (test-mode AppData)
+    QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).removeRecursively();
+    if (!s.theme.isEmpty()) QSettings().setValue("theme", s.theme);
+
+    CalendarStore store;
+    store.events() = s.events;
+    store.commit();
+    UltraMainWindow window(&store);
+    if (s.size.isValid()) window.resize(s.size);
+    window.show();
+    if (s.selected.isValid())
+        if (auto* cal = window.findChild<QCalendarWidget*>("UltraCalendar")) cal->setSelectedDate(s.selected);
+
+    QVector<double> ms(acts.size(), std::nan(""));
+    QElapsedTimer clock; clock.start();
+    int    act = -1;            // -1: waiting for the first screen to settle
+    int    next = 0;            // next input of the current action
+    bool   settling = true, idleOnce = false, skipped = false;
+    qint64 lastInputNs = 0, idleAtNs = 0;
+
+    // Driven by a timer so it keeps running inside dialogs' nested event loops
+    QEventLoop loop;
+    QTimer tick;
+    tick.setTimerType(Qt::PreciseTimer);
+    tick.setInterval(1);
+    QObject::connect(&tick, &QTimer::timeout, &loop, [&] {
+        const qint64 now = clock.nsecsElapsed();
+        if (settling) {
+            if (!window.isSettled()) {
+                idleOnce = false;
+                if (now - lastInputNs < qint64(timeoutMs) * 1000000) return;
+                if (act >= 0 && !skipped) ms[act] = -1;
+            } else if (!idleOnce) {
+                idleOnce = true;    // settled twice in a row: nothing was still queued
+                idleAtNs = now;
+                return;
+            } else if (act >= 0 && !skipped) {
+                ms[act] = (idleAtNs - lastInputNs) / 1e6;
+            }
+            settling = skipped = false;
+            if (++act == acts.size()) {
+                tick.stop();
+                if (auto* d = qobject_cast<QDialog*>(QApplication::activeModalWidget())) d->reject();
+                loop.quit();
+                return;
+            }
+            next = acts[act].first;
+        }
+
+        // Post the action's inputs with their recorded spacing
+        const Action& a = acts[act];
+        if (next > a.first) {
+            const qint64 gap = std::min<qint64>(kMaxGapMs, s.inputs[next].t - s.inputs[next - 1].t);
+            if (now - lastInputNs < gap * 1000000) return;
+        }
+        const UiRecorder::Input& in = s.inputs[next];
+        QWidget* w = UiRecorder::resolve(in.path);
+        if (!w) {
+            out << "  #" << act << " " << a.label << ": no widget at " << in.path << "\n";
+            next = a.last + 1;   // skip the rest of this action; ms stays NaN
+            settling = skipped = true;
+            idleOnce = false;
+            lastInputNs = now;
+            return;
+        }
+        post(in, w);
+        lastInputNs = clock.nsecsElapsed();
+        if (++next > a.last) { settling = true; idleOnce = false; }
+    });
+    tick.start();
+    loop.exec();
+    return ms;
+}
+
+static double percentile(QVector<double> v, double q)
+{
+    if (v.isEmpty()) return 0;
+    std::sort(v.begin(), v.end());
+    const int rank = int(std::ceil(q * v.size()));   // nearest rank
+    return v[std::clamp(rank - 1, 0, int(v.size()) - 1)];
+}
+
+int main(int argc, char** argv)
+{
+    // Headless unless the caller picked a platform
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    if (qEnvironmentVariableIsEmpty("QTWEBENGINE_CHROMIUM_FLAGS")) qputenv("QTWEBENGINE_CHROMIUM_FLAGS", "--disable-gpu");
+
+    QApplication app(argc, argv);
+    QCoreApplication::setOrganizationName("EduSyncReplay");   // own QSettings, not the user's
+    QCoreApplication::setApplicationName("EduSyncReplay");
+    QStandardPaths::setTestModeEnabled(true);
+    const QStringList args = app.arguments();
+
+    QString path, jsonOut, baseline;
+    int    repeat = 3, timeoutMs = 5000;
+    double tolerance = 1.25, floorMs = 5;
+    for (int i = 1; i < args.size(); ++i) {
+        if      (args[i] == "--repeat"    && i + 1 < args.size()) repeat    = std::max(1, args[++i].toInt());
+        else if (args[i] == "--timeout"   && i + 1 < args.size()) timeoutMs = std::max(100, args[++i].toInt());
+        else if (args[i] == "--json"      && i + 1 < args.size()) jsonOut   = args[++i];
+        else if (args[i] == "--baseline"  && i + 1 < args.size()) baseline  = args[++i];
+        else if (args[i] == "--tolerance" && i + 1 < args.size()) tolerance = std::max(1.0, args[++i].toDouble());
+        else if (args[i] == "--floor"     && i + 1 < args.size()) floorMs   = std::max(0.0, args[++i].toDouble());
+        else                                                       path      = args[i];
+    }
+    if (path.isEmpty()) {
+        out << "usage: edusync_ui_replay <session.jsonl> [--repeat N] [--timeout MS] [--json out.json]\n"
+               "                         [--baseline old.json] [--tolerance X] [--floor MS]\n";
+        return 2;
+    }
+
+    UiRecorder::Session session;
+    QString error;
+    if (!UiRecorder::load(path, &session, &error)) { out << path << ": " << error << "\n"; return 2; }
+    const QVector<Action> acts = actionsOf(session);
+    out << QString("%1: %2 actions, %3 inputs, %4 events, platform %5\n")
+           .arg(path).arg(acts.size()).arg(session.inputs.size()).arg(session.events.size())
+           .arg(QGuiApplication::platformName());
+
+    QVector<QVector<double>> runs;
+    for (int r = 0; r < repeat; ++r) runs.push_back(replayOnce(session, acts, timeoutMs));
+
+    // Per action: median over repeats; unsettled if any repeat timed out
+    int unsettled = 0;
+    QVector<double> ms(acts.size());
+    QMap<QString, QVector<double>> byLabel;
+    QJsonArray jActs;
+    for (int a = 0; a < acts.size(); ++a) {
+        QVector<double> v;
+        bool timedOut = false;
+        for (const auto& run : runs) {
+            if (run[a] < 0) timedOut = true;
+            else if (!std::isnan(run[a])) v.push_back(run[a]);
+        }
+        if (timedOut) ++unsettled;
+        ms[a] = v.isEmpty() ? std::nan("") : percentile(v, 0.5);
+        if (!v.isEmpty()) byLabel[acts[a].label].push_back(ms[a]);
+
+        out << QString("#%1 %2 %3\n").arg(a, 4).arg(acts[a].label, -20)
+               .arg(timedOut ? QString("unsettled") : v.isEmpty() ? QString("skipped")
+                                                                : QString("%1 ms").arg(ms[a], 8, 'f', 1));
+        jActs.append(QJsonObject{ { "a", a }, { "label", acts[a].label },
+                                  { "ms", v.isEmpty() ? QJsonValue() : QJsonValue(ms[a]) },
+                                  { "unsettled", timedOut } });
+    }
+
+    out << QString("\n%1 %2 %3 %4 %5\n").arg("label", -20).arg("n", 5).arg("p50", 9).arg("p90", 9).arg("max", 9);
+    QJsonObject jLabels;
+    for (auto it = byLabel.cbegin(); it != byLabel.cend(); ++it) {
+        const double p50 = percentile(it.value(), 0.5), p90 = percentile(it.value(), 0.9);
+        const double mx  = *std::max_element(it.value().cbegin(), it.value().cend());
+        out << QString("%1 %2 %3 %4 %5\n").arg(it.key(), -20).arg(it.value().size(), 5)
+               .arg(p50, 9, 'f', 1).arg(p90, 9, 'f', 1).arg(mx, 9, 'f', 1);
+        jLabels[it.key()] = QJsonObject{ { "n", it.value().size() }, { "p50", p50 }, { "p90", p90 }, { "max", mx } };
+    }
+    if (unsettled) out << unsettled << " action(s) did not settle within " << timeoutMs << " ms\n";
+
+    if (!jsonOut.isEmpty()) {
+        const QJsonObject report{ { "session", path }, { "repeat", repeat },
+                                  { "platform", QGuiApplication::platformName() },
+                                  { "unsettled", unsettled }, { "actions", jActs }, { "labels", jLabels } };
+        QFile f(jsonOut);
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) { out << jsonOut << ": " << f.errorString() << "\n"; return 2; }
+        f.write(QJsonDocument(report).toJson());
+    }
+
+    int regressions = 0;
+    if (!baseline.isEmpty()) {
+        QFile f(baseline);
+        if (!f.open(QIODevice::ReadOnly)) { out << baseline << ": " << f.errorString() << "\n"; return 2; }
+        const QJsonObject base = QJsonDocument::fromJson(f.readAll()).object().value("labels").toObject();
+        out << "\nvs " << baseline << " (×" << tolerance << ", +" << floorMs << " ms)\n";
+        for (auto it = jLabels.constBegin(); it != jLabels.constEnd(); ++it) {
+            if (!base.contains(it.key())) { out << QString("  %1 new\n").arg(it.key(), -20); continue; }
+            const QJsonObject was = base.value(it.key()).toObject(), now = it.value().toObject();
+            for (const char* q : { "p50", "p90" }) {
+                const double a = was.value(q).toDouble(), b = now.value(q).toDouble();
+                if (b <= a * tolerance || b - a <= floorMs) continue;
+                out << QString("  REGRESSION %1 %2 %3 → %4 ms\n").arg(it.key(), -20).arg(q)
+                       .arg(a, 0, 'f', 1).arg(b, 0, 'f', 1);
+                ++regressions;
+            }
+        }
+        if (!regressions) out << "  no regressions\n";
+    }
+    return (regressions || unsettled) ? 1 : 0;
+}